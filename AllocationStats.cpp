@@ -0,0 +1,246 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/AllocationStats.cpp
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#include "AllocationStats.h"
+#include <atomic>
+#include <new>
+#include <cstdlib>
+
+namespace cppstax
+{
+
+#if defined(CPPSTAX_ALLOCATION_STATS)
+
+namespace
+{
+
+/** In front of each allocation, sized to keep the alignment malloc()
+  * guarantees. */
+struct Header
+{
+    std::size_t m_nSize;
+    AllocationStats::Category m_eCategory;
+};
+
+const std::size_t HEADER_SIZE = alignof(std::max_align_t);
+
+static_assert(sizeof(Header) <= HEADER_SIZE, "Allocation header doesn't fit.");
+
+std::atomic<unsigned long long> g_aAllocations[AllocationStats::CATEGORY_COUNT];
+std::atomic<unsigned long long> g_aBytes[AllocationStats::CATEGORY_COUNT];
+std::atomic<unsigned long long> g_aLiveBytes[AllocationStats::CATEGORY_COUNT];
+std::atomic<unsigned long long> g_aPeakLiveBytes[AllocationStats::CATEGORY_COUNT];
+
+thread_local AllocationStats::Category g_eCategory = AllocationStats::CATEGORY_OTHER;
+
+void* Allocate(std::size_t nSize)
+{
+    Header* pHeader = static_cast<Header*>(std::malloc(nSize + HEADER_SIZE));
+
+    if (pHeader == nullptr)
+    {
+        return nullptr;
+    }
+
+    const AllocationStats::Category eCategory = g_eCategory;
+
+    pHeader->m_nSize = nSize;
+    pHeader->m_eCategory = eCategory;
+
+    g_aAllocations[eCategory].fetch_add(1, std::memory_order_relaxed);
+    g_aBytes[eCategory].fetch_add(nSize, std::memory_order_relaxed);
+
+    unsigned long long nLiveBytes = g_aLiveBytes[eCategory].fetch_add(nSize, std::memory_order_relaxed) + nSize;
+    unsigned long long nPeakLiveBytes = g_aPeakLiveBytes[eCategory].load(std::memory_order_relaxed);
+
+    while (nLiveBytes > nPeakLiveBytes &&
+           g_aPeakLiveBytes[eCategory].compare_exchange_weak(nPeakLiveBytes, nLiveBytes, std::memory_order_relaxed) != true)
+    {
+
+    }
+
+    return reinterpret_cast<char*>(pHeader) + HEADER_SIZE;
+}
+
+void Deallocate(void* pMemory)
+{
+    if (pMemory == nullptr)
+    {
+        return;
+    }
+
+    Header* pHeader = reinterpret_cast<Header*>(static_cast<char*>(pMemory) - HEADER_SIZE);
+
+    g_aLiveBytes[pHeader->m_eCategory].fetch_sub(pHeader->m_nSize, std::memory_order_relaxed);
+
+    std::free(pHeader);
+}
+
+}
+
+bool AllocationStats::isEnabled()
+{
+    return true;
+}
+
+AllocationStats::Counters AllocationStats::getCounters(Category eCategory)
+{
+    Counters aCounters;
+
+    aCounters.m_nAllocations = g_aAllocations[eCategory].load(std::memory_order_relaxed);
+    aCounters.m_nBytes = g_aBytes[eCategory].load(std::memory_order_relaxed);
+    aCounters.m_nLiveBytes = g_aLiveBytes[eCategory].load(std::memory_order_relaxed);
+    aCounters.m_nPeakLiveBytes = g_aPeakLiveBytes[eCategory].load(std::memory_order_relaxed);
+
+    return aCounters;
+}
+
+/**
+ * @brief Sets the allocation and byte counts to 0 and the peaks to what
+ *     is live now, to measure from here on.
+ */
+void AllocationStats::reset()
+{
+    for (std::size_t i = 0; i < CATEGORY_COUNT; i++)
+    {
+        g_aAllocations[i].store(0, std::memory_order_relaxed);
+        g_aBytes[i].store(0, std::memory_order_relaxed);
+        g_aPeakLiveBytes[i].store(g_aLiveBytes[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @retval The previous category of the current thread, for leaveScope().
+ */
+AllocationStats::Category AllocationStats::enterScope(Category eCategory)
+{
+    Category ePrevious = g_eCategory;
+    g_eCategory = eCategory;
+    return ePrevious;
+}
+
+void AllocationStats::leaveScope(Category ePrevious)
+{
+    g_eCategory = ePrevious;
+}
+
+#else
+
+bool AllocationStats::isEnabled()
+{
+    return false;
+}
+
+AllocationStats::Counters AllocationStats::getCounters(Category)
+{
+    Counters aCounters = { 0, 0, 0, 0 };
+    return aCounters;
+}
+
+void AllocationStats::reset()
+{
+
+}
+
+AllocationStats::Category AllocationStats::enterScope(Category)
+{
+    return CATEGORY_OTHER;
+}
+
+void AllocationStats::leaveScope(Category)
+{
+
+}
+
+#endif
+
+const char* AllocationStats::getCategoryName(Category eCategory)
+{
+    switch (eCategory)
+    {
+    case CATEGORY_EVENTS:
+        return "events";
+    case CATEGORY_NAMES:
+        return "names";
+    case CATEGORY_ATTRIBUTES:
+        return "attributes";
+    case CATEGORY_TEXT:
+        return "text";
+    case CATEGORY_OTHER:
+        return "other";
+    }
+
+    return "";
+}
+
+}
+
+#if defined(CPPSTAX_ALLOCATION_STATS)
+
+void* operator new(std::size_t nSize)
+{
+    void* pMemory = cppstax::Allocate(nSize);
+
+    if (pMemory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return pMemory;
+}
+
+void* operator new[](std::size_t nSize)
+{
+    return operator new(nSize);
+}
+
+void* operator new(std::size_t nSize, const std::nothrow_t&) noexcept
+{
+    return cppstax::Allocate(nSize);
+}
+
+void* operator new[](std::size_t nSize, const std::nothrow_t&) noexcept
+{
+    return cppstax::Allocate(nSize);
+}
+
+void operator delete(void* pMemory) noexcept
+{
+    cppstax::Deallocate(pMemory);
+}
+
+void operator delete[](void* pMemory) noexcept
+{
+    cppstax::Deallocate(pMemory);
+}
+
+void operator delete(void* pMemory, const std::nothrow_t&) noexcept
+{
+    cppstax::Deallocate(pMemory);
+}
+
+void operator delete[](void* pMemory, const std::nothrow_t&) noexcept
+{
+    cppstax::Deallocate(pMemory);
+}
+
+#endif
@@ -0,0 +1,120 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/AllocationStats.h
+ * @brief Optional accounting of the heap allocations of the readers.
+ * @details Only compiled in with CPPSTAX_ALLOCATION_STATS defined for all
+ *     translation units (make ALLOCATION_STATS=1 after make clean), as it
+ *     replaces the global operator new and delete of the whole program.
+ *     The readers then attribute what they allocate to a Category by
+ *     placing an AllocationScope, everything else counts as
+ *     CATEGORY_OTHER. A deallocation is counted for the category of its
+ *     allocation. Without CPPSTAX_ALLOCATION_STATS, AllocationScope is
+ *     empty and all counters stay 0.
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#ifndef _CPPSTAX_ALLOCATIONSTATS_H
+#define _CPPSTAX_ALLOCATIONSTATS_H
+
+#include <cstddef>
+
+namespace cppstax
+{
+
+class AllocationStats
+{
+public:
+    enum Category
+    {
+        /** Event objects and the slots holding them. */
+        CATEGORY_EVENTS = 0,
+        /** Element, attribute and processing instruction target names. */
+        CATEGORY_NAMES,
+        /** Attribute lists, attributes and their values. */
+        CATEGORY_ATTRIBUTES,
+        /** Text, comment and processing instruction data. */
+        CATEGORY_TEXT,
+        /** Outside of any AllocationScope. */
+        CATEGORY_OTHER
+    };
+
+    static const std::size_t CATEGORY_COUNT = CATEGORY_OTHER + 1;
+
+    struct Counters
+    {
+        unsigned long long m_nAllocations;
+        unsigned long long m_nBytes;
+        unsigned long long m_nLiveBytes;
+        unsigned long long m_nPeakLiveBytes;
+    };
+
+public:
+    static bool isEnabled();
+    static Counters getCounters(Category eCategory);
+    static void reset();
+    static const char* getCategoryName(Category eCategory);
+
+public:
+    static Category enterScope(Category eCategory);
+    static void leaveScope(Category ePrevious);
+
+};
+
+#if defined(CPPSTAX_ALLOCATION_STATS)
+
+/**
+ * @brief Attributes the allocations of the current thread to a Category
+ *     while it exists.
+ */
+class AllocationScope
+{
+public:
+    AllocationScope(AllocationStats::Category eCategory):
+      m_ePrevious(AllocationStats::enterScope(eCategory))
+    {
+
+    }
+
+    ~AllocationScope()
+    {
+        AllocationStats::leaveScope(m_ePrevious);
+    }
+
+protected:
+    AllocationStats::Category m_ePrevious;
+
+};
+
+#else
+
+class AllocationScope
+{
+public:
+    AllocationScope(AllocationStats::Category)
+    {
+
+    }
+
+};
+
+#endif
+
+}
+
+#endif
@@ -21,6 +21,8 @@
  */
 
 #include "Attribute.h"
+#include "XMLValueParser.h"
+#include <stdexcept>
 
 namespace cppstax
 {
@@ -50,6 +52,42 @@ const std::string& Attribute::getValue() const
     return *m_pValue;
 }
 
+/**
+ * @brief Converts the value as XML Schema long, see XMLValueParser.
+ * @retval false if it isn't one, nValue is left unchanged then.
+ */
+bool Attribute::getAsInt64(long long& nValue) const
+{
+    return XMLValueParser::parseInt64(m_pValue->data(), m_pValue->length(), nValue);
+}
+
+/**
+ * @brief Converts the value as XML Schema double, see XMLValueParser.
+ * @retval false if it isn't one, fValue is left unchanged then.
+ */
+bool Attribute::getAsDouble(double& fValue) const
+{
+    return XMLValueParser::parseDouble(m_pValue->data(), m_pValue->length(), fValue);
+}
+
+/**
+ * @brief Converts the value as XML Schema boolean, see XMLValueParser.
+ * @retval false if it isn't one, bValue is left unchanged then.
+ */
+bool Attribute::getAsBool(bool& bValue) const
+{
+    return XMLValueParser::parseBool(m_pValue->data(), m_pValue->length(), bValue);
+}
+
+/**
+ * @brief Decodes the value as base64 into pBuffer of nSize bytes, see
+ *     XMLValueParser::parseBase64().
+ */
+bool Attribute::getAsBase64(unsigned char* pBuffer, std::size_t nSize, std::size_t& nDecoded) const
+{
+    return XMLValueParser::parseBase64(m_pValue->data(), m_pValue->length(), pBuffer, nSize, nDecoded);
+}
+
 bool Attribute::operator==(const Attribute& rhs) const
 {
     return *m_pName == rhs.getName();
@@ -25,6 +25,7 @@
 
 #include "QName.h"
 #include <memory>
+#include <cstddef>
 
 namespace cppstax
 {
@@ -36,6 +37,10 @@ public:
 
     const QName& getName() const;
     const std::string& getValue() const;
+    bool getAsInt64(long long& nValue) const;
+    bool getAsDouble(double& fValue) const;
+    bool getAsBool(bool& bValue) const;
+    bool getAsBase64(unsigned char* pBuffer, std::size_t nSize, std::size_t& nDecoded) const;
 
 public:
     // For std::list.
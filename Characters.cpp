@@ -21,6 +21,9 @@
  */
 
 #include "Characters.h"
+#include "XMLValueParser.h"
+#include <locale>
+#include <stdexcept>
 
 namespace cppstax
 {
@@ -34,9 +37,13 @@ Characters::Characters(std::unique_ptr<std::string> pData):
         throw new std::invalid_argument("Nullptr passed.");
     }
 
+    // Shared, as copying a locale for every event updates a reference
+    // count all threads constructing events would contend for.
+    static const std::locale aLocale;
+
     for (char& cCharacter : *m_pData)
     {
-        if (std::isspace(cCharacter, m_aLocale) == 0)
+        if (std::isspace(cCharacter, aLocale) == 0)
         {
             m_bIsWhiteSpace = false;
             break;
@@ -49,6 +56,42 @@ const std::string& Characters::getData() const
     return *m_pData;
 }
 
+/**
+ * @brief Converts the data as XML Schema long, see XMLValueParser.
+ * @retval false if it isn't one, nValue is left unchanged then.
+ */
+bool Characters::getAsInt64(long long& nValue) const
+{
+    return XMLValueParser::parseInt64(m_pData->data(), m_pData->length(), nValue);
+}
+
+/**
+ * @brief Converts the data as XML Schema double, see XMLValueParser.
+ * @retval false if it isn't one, fValue is left unchanged then.
+ */
+bool Characters::getAsDouble(double& fValue) const
+{
+    return XMLValueParser::parseDouble(m_pData->data(), m_pData->length(), fValue);
+}
+
+/**
+ * @brief Converts the data as XML Schema boolean, see XMLValueParser.
+ * @retval false if it isn't one, bValue is left unchanged then.
+ */
+bool Characters::getAsBool(bool& bValue) const
+{
+    return XMLValueParser::parseBool(m_pData->data(), m_pData->length(), bValue);
+}
+
+/**
+ * @brief Decodes the data as base64 into pBuffer of nSize bytes, see
+ *     XMLValueParser::parseBase64().
+ */
+bool Characters::getAsBase64(unsigned char* pBuffer, std::size_t nSize, std::size_t& nDecoded) const
+{
+    return XMLValueParser::parseBase64(m_pData->data(), m_pData->length(), pBuffer, nSize, nDecoded);
+}
+
 const bool& Characters::isWhiteSpace() const
 {
     return m_bIsWhiteSpace;
@@ -25,7 +25,7 @@
 
 #include <memory>
 #include <string>
-#include <locale>
+#include <cstddef>
 
 namespace cppstax
 {
@@ -37,12 +37,15 @@ public:
 
 public:
     const std::string& getData() const;
+    bool getAsInt64(long long& nValue) const;
+    bool getAsDouble(double& fValue) const;
+    bool getAsBool(bool& bValue) const;
+    bool getAsBase64(unsigned char* pBuffer, std::size_t nSize, std::size_t& nDecoded) const;
     const bool& isWhiteSpace() const;
 
 protected:
     std::unique_ptr<std::string> m_pData;
     bool m_bIsWhiteSpace;
-    std::locale m_aLocale;
 
 };
 
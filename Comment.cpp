@@ -21,6 +21,7 @@
  */
 
 #include "Comment.h"
+#include <stdexcept>
 
 namespace cppstax
 {
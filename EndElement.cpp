@@ -21,11 +21,15 @@
  */
 
 #include "EndElement.h"
+#include <stdexcept>
 
 namespace cppstax
 {
 
-EndElement::EndElement(std::unique_ptr<QName> pName):
+/**
+ * @param pName Shared with the StartElement of an empty element tag.
+ */
+EndElement::EndElement(std::shared_ptr<QName> pName):
   m_pName(std::move(pName))
 {
     if (m_pName == nullptr)
@@ -32,13 +32,13 @@ namespace cppstax
 class EndElement
 {
 public:
-    EndElement(std::unique_ptr<QName> pName);
+    EndElement(std::shared_ptr<QName> pName);
 
 public:
     const QName& getName() const;
 
 protected:
-    std::unique_ptr<QName> m_pName;
+    std::shared_ptr<QName> m_pName;
 
 };
 
@@ -0,0 +1,64 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/Location.cpp
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#include "Location.h"
+
+namespace cppstax
+{
+
+Location::Location():
+  m_nCharacterOffset(-1),
+  m_nLineNumber(-1),
+  m_nColumnNumber(-1)
+{
+
+}
+
+Location::Location(std::streamoff nCharacterOffset, long nLineNumber, long nColumnNumber):
+  m_nCharacterOffset(nCharacterOffset),
+  m_nLineNumber(nLineNumber),
+  m_nColumnNumber(nColumnNumber)
+{
+
+}
+
+std::streamoff Location::getCharacterOffset() const
+{
+    return m_nCharacterOffset;
+}
+
+long Location::getLineNumber() const
+{
+    return m_nLineNumber;
+}
+
+long Location::getColumnNumber() const
+{
+    return m_nColumnNumber;
+}
+
+bool Location::isKnown() const
+{
+    return m_nCharacterOffset >= 0;
+}
+
+}
@@ -0,0 +1,59 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/Location.h
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#ifndef _CPPSTAX_LOCATION_H
+#define _CPPSTAX_LOCATION_H
+
+#include <ios>
+
+namespace cppstax
+{
+
+/**
+ * @brief Position in the input. Values are -1 if unknown, which is the case
+ *     if location tracking isn't enabled for the XMLEventReader.
+ */
+class Location
+{
+public:
+    Location();
+    Location(std::streamoff nCharacterOffset, long nLineNumber, long nColumnNumber);
+
+public:
+    /** @brief Offset in bytes, starting with 0. */
+    std::streamoff getCharacterOffset() const;
+    /** @brief Starting with 1. */
+    long getLineNumber() const;
+    /** @brief In bytes, starting with 1. */
+    long getColumnNumber() const;
+    bool isKnown() const;
+
+protected:
+    std::streamoff m_nCharacterOffset;
+    long m_nLineNumber;
+    long m_nColumnNumber;
+
+};
+
+}
+
+#endif
@@ -0,0 +1,217 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/LocationStreamBuffer.cpp
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#include "LocationStreamBuffer.h"
+#include <stdexcept>
+#include <cstring>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace cppstax
+{
+
+namespace
+{
+
+const std::size_t BLOCK_SIZE = 65536;
+/** Bytes of the previous block kept for std::istream::unget(). */
+const std::size_t PUTBACK_SIZE = 16;
+
+}
+
+LocationStreamBuffer::LocationStreamBuffer(std::streambuf* pSource):
+  m_pSource(pSource),
+  m_aBuffer(BLOCK_SIZE),
+  m_nBufferOffset(0),
+  m_pCounted(&m_aBuffer[0]),
+  m_nLineNumber(1),
+  m_nLineOffset(0)
+{
+    if (m_pSource == nullptr)
+    {
+        throw new std::invalid_argument("Nullptr passed.");
+    }
+
+    setg(&m_aBuffer[0], &m_aBuffer[0], &m_aBuffer[0]);
+}
+
+/**
+ * @brief Location of the next byte to be read.
+ */
+Location LocationStreamBuffer::getLocation()
+{
+    CountLines(gptr());
+
+    std::streamoff nOffset = m_nBufferOffset + (gptr() - eback());
+
+    return Location(nOffset, m_nLineNumber, nOffset - m_nLineOffset + 1);
+}
+
+/**
+ * @brief Offset of the read position, without counting lines.
+ */
+std::streamoff LocationStreamBuffer::getOffset() const
+{
+    return m_nBufferOffset + (gptr() - eback());
+}
+
+/**
+ * @brief Number of '\n' in [pBegin, pEnd).
+ */
+std::size_t LocationStreamBuffer::countNewlines(const char* pBegin, const char* pEnd)
+{
+    std::size_t nCount = 0;
+
+#if defined(__SSE2__)
+    const __m128i aNewlines = _mm_set1_epi8('\n');
+
+    while (pEnd - pBegin >= 16)
+    {
+        __m128i aBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pBegin));
+        nCount += __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(aBlock, aNewlines)));
+        pBegin += 16;
+    }
+#endif
+
+    while (pBegin < pEnd)
+    {
+        if (*pBegin == '\n')
+        {
+            ++nCount;
+        }
+
+        ++pBegin;
+    }
+
+    return nCount;
+}
+
+std::streambuf* LocationStreamBuffer::getSource()
+{
+    return m_pSource;
+}
+
+/**
+ * @brief Starts over at offset 0 and line 1 of pSource, keeping the
+ *     block buffer.
+ */
+void LocationStreamBuffer::reset(std::streambuf* pSource)
+{
+    if (pSource == nullptr)
+    {
+        throw new std::invalid_argument("Nullptr passed.");
+    }
+
+    m_pSource = pSource;
+    m_nBufferOffset = 0;
+    m_pCounted = &m_aBuffer[0];
+    m_nLineNumber = 1;
+    m_nLineOffset = 0;
+
+    setg(&m_aBuffer[0], &m_aBuffer[0], &m_aBuffer[0]);
+}
+
+LocationStreamBuffer::int_type LocationStreamBuffer::underflow()
+{
+    if (gptr() < egptr())
+    {
+        return traits_type::to_int_type(*gptr());
+    }
+
+    CountLines(egptr());
+
+    std::size_t nPutback = egptr() - eback();
+
+    if (nPutback > PUTBACK_SIZE)
+    {
+        nPutback = PUTBACK_SIZE;
+    }
+
+    char* pBuffer = &m_aBuffer[0];
+
+    m_nBufferOffset += (egptr() - eback()) - nPutback;
+    std::memmove(pBuffer, egptr() - nPutback, nPutback);
+
+    std::streamsize nRead = m_pSource->sgetn(pBuffer + nPutback, m_aBuffer.size() - nPutback);
+
+    if (nRead < 0)
+    {
+        nRead = 0;
+    }
+
+    setg(pBuffer, pBuffer + nPutback, pBuffer + nPutback + nRead);
+    m_pCounted = gptr();
+
+    if (nRead <= 0)
+    {
+        return traits_type::eof();
+    }
+
+    return traits_type::to_int_type(*gptr());
+}
+
+void LocationStreamBuffer::CountLines(const char* pPosition)
+{
+    if (pPosition > m_pCounted)
+    {
+        std::size_t nNewlines = countNewlines(m_pCounted, pPosition);
+
+        if (nNewlines > 0)
+        {
+            m_nLineNumber += nNewlines;
+
+            const char* pNewline = pPosition - 1;
+
+            while (*pNewline != '\n')
+            {
+                --pNewline;
+            }
+
+            m_nLineOffset = m_nBufferOffset + (pNewline - eback()) + 1;
+        }
+    }
+    else if (pPosition < m_pCounted)
+    {
+        // After std::istream::unget().
+        std::size_t nNewlines = countNewlines(pPosition, m_pCounted);
+
+        if (nNewlines > 0)
+        {
+            m_nLineNumber -= nNewlines;
+            m_nLineOffset = m_nBufferOffset;
+
+            for (const char* pNewline = pPosition; pNewline > eback(); --pNewline)
+            {
+                if (*(pNewline - 1) == '\n')
+                {
+                    m_nLineOffset = m_nBufferOffset + (pNewline - eback());
+                    break;
+                }
+            }
+        }
+    }
+
+    m_pCounted = pPosition;
+}
+
+}
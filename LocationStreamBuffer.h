@@ -0,0 +1,73 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/LocationStreamBuffer.h
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#ifndef _CPPSTAX_LOCATIONSTREAMBUFFER_H
+#define _CPPSTAX_LOCATIONSTREAMBUFFER_H
+
+#include "Location.h"
+#include <streambuf>
+#include <vector>
+#include <cstddef>
+
+namespace cppstax
+{
+
+/**
+ * @brief Reads another stream buffer in large blocks and keeps track of
+ *     the byte offset and line of the read position.
+ * @details Newlines are counted lazily, only up to the read position at
+ *     the time a Location is requested, so every byte gets counted once.
+ */
+class LocationStreamBuffer : public std::streambuf
+{
+public:
+    LocationStreamBuffer(std::streambuf* pSource);
+
+public:
+    Location getLocation();
+    std::streamoff getOffset() const;
+    std::streambuf* getSource();
+    void reset(std::streambuf* pSource);
+
+public:
+    static std::size_t countNewlines(const char* pBegin, const char* pEnd);
+
+protected:
+    virtual int_type underflow();
+    void CountLines(const char* pPosition);
+
+protected:
+    std::streambuf* m_pSource;
+    std::vector<char> m_aBuffer;
+    /** Offset of eback() in the source. */
+    std::streamoff m_nBufferOffset;
+    /** Position in the buffer up to which lines were counted. */
+    const char* m_pCounted;
+    long m_nLineNumber;
+    /** Offset of the first byte of the current line. */
+    std::streamoff m_nLineOffset;
+
+};
+
+}
+
+#endif
@@ -0,0 +1,92 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/MemoryStreamBuffer.cpp
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#include "MemoryStreamBuffer.h"
+#include <ios>
+#include <stdexcept>
+
+namespace cppstax
+{
+
+MemoryStreamBuffer::MemoryStreamBuffer(const char* pData, std::size_t nLength)
+{
+    if (pData == nullptr &&
+        nLength > 0)
+    {
+        throw new std::invalid_argument("Nullptr passed.");
+    }
+
+    // The get area is only read from.
+    char* pBegin = const_cast<char*>(pData);
+    setg(pBegin, pBegin, pBegin + nLength);
+}
+
+/**
+ * @brief Reads from pData instead, from its start.
+ */
+void MemoryStreamBuffer::reset(const char* pData, std::size_t nLength)
+{
+    if (pData == nullptr &&
+        nLength > 0)
+    {
+        throw new std::invalid_argument("Nullptr passed.");
+    }
+
+    char* pBegin = const_cast<char*>(pData);
+    setg(pBegin, pBegin, pBegin + nLength);
+}
+
+MemoryStreamBuffer::pos_type MemoryStreamBuffer::seekoff(off_type nOffset, std::ios_base::seekdir eDirection, std::ios_base::openmode nMode)
+{
+    if ((nMode & std::ios_base::in) == 0)
+    {
+        return pos_type(off_type(-1));
+    }
+
+    off_type nPosition = nOffset;
+
+    if (eDirection == std::ios_base::cur)
+    {
+        nPosition += gptr() - eback();
+    }
+    else if (eDirection == std::ios_base::end)
+    {
+        nPosition += egptr() - eback();
+    }
+
+    if (nPosition < 0 ||
+        nPosition > egptr() - eback())
+    {
+        return pos_type(off_type(-1));
+    }
+
+    setg(eback(), eback() + nPosition, egptr());
+
+    return pos_type(nPosition);
+}
+
+MemoryStreamBuffer::pos_type MemoryStreamBuffer::seekpos(pos_type nPosition, std::ios_base::openmode nMode)
+{
+    return seekoff(off_type(nPosition), std::ios_base::beg, nMode);
+}
+
+}
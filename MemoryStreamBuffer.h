@@ -0,0 +1,53 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/MemoryStreamBuffer.h
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#ifndef _CPPSTAX_MEMORYSTREAMBUFFER_H
+#define _CPPSTAX_MEMORYSTREAMBUFFER_H
+
+#include <streambuf>
+#include <cstddef>
+
+namespace cppstax
+{
+
+/**
+ * @brief Stream buffer for reading input which is already in memory,
+ *     without copying it. The data needs to stay valid while the
+ *     buffer is in use.
+ */
+class MemoryStreamBuffer : public std::streambuf
+{
+public:
+    MemoryStreamBuffer(const char* pData, std::size_t nLength);
+
+public:
+    void reset(const char* pData, std::size_t nLength);
+
+protected:
+    virtual pos_type seekoff(off_type nOffset, std::ios_base::seekdir eDirection, std::ios_base::openmode nMode);
+    virtual pos_type seekpos(pos_type nPosition, std::ios_base::openmode nMode);
+
+};
+
+}
+
+#endif
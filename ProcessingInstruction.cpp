@@ -21,6 +21,7 @@
  */
 
 #include "ProcessingInstruction.h"
+#include <stdexcept>
 
 namespace cppstax
 {
@@ -0,0 +1,123 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/RangeStreamBuffer.cpp
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#include "RangeStreamBuffer.h"
+#include <ios>
+#include <stdexcept>
+
+namespace cppstax
+{
+
+RangeStreamBuffer::RangeStreamBuffer(std::streambuf* pSource, std::streamoff nOffset, std::streamoff nLength):
+  m_pSource(pSource),
+  m_nLength(nLength),
+  m_nPosition(0)
+{
+    if (m_pSource == nullptr)
+    {
+        throw new std::invalid_argument("Nullptr passed.");
+    }
+
+    if (nOffset < 0 ||
+        nLength < 0)
+    {
+        throw new std::invalid_argument("Negative offset or length passed.");
+    }
+
+    if (m_pSource->pubseekpos(std::streampos(nOffset), std::ios_base::in) != std::streampos(nOffset))
+    {
+        throw new std::runtime_error("Seeking the source stream failed.");
+    }
+}
+
+RangeStreamBuffer::int_type RangeStreamBuffer::underflow()
+{
+    if (m_nPosition >= m_nLength)
+    {
+        return traits_type::eof();
+    }
+
+    return m_pSource->sgetc();
+}
+
+RangeStreamBuffer::int_type RangeStreamBuffer::uflow()
+{
+    if (m_nPosition >= m_nLength)
+    {
+        return traits_type::eof();
+    }
+
+    int_type nByte = m_pSource->sbumpc();
+
+    if (traits_type::eq_int_type(nByte, traits_type::eof()) != true)
+    {
+        ++m_nPosition;
+    }
+
+    return nByte;
+}
+
+RangeStreamBuffer::int_type RangeStreamBuffer::pbackfail(int_type nByte)
+{
+    if (m_nPosition <= 0)
+    {
+        return traits_type::eof();
+    }
+
+    int_type nResult = 0;
+
+    if (traits_type::eq_int_type(nByte, traits_type::eof()) == true)
+    {
+        nResult = m_pSource->sungetc();
+    }
+    else
+    {
+        nResult = m_pSource->sputbackc(traits_type::to_char_type(nByte));
+    }
+
+    if (traits_type::eq_int_type(nResult, traits_type::eof()) != true)
+    {
+        --m_nPosition;
+    }
+
+    return nResult;
+}
+
+std::streamsize RangeStreamBuffer::xsgetn(char* pDestination, std::streamsize nCount)
+{
+    if (nCount > m_nLength - m_nPosition)
+    {
+        nCount = m_nLength - m_nPosition;
+    }
+
+    if (nCount <= 0)
+    {
+        return 0;
+    }
+
+    std::streamsize nRead = m_pSource->sgetn(pDestination, nCount);
+    m_nPosition += nRead;
+
+    return nRead;
+}
+
+}
@@ -0,0 +1,56 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/RangeStreamBuffer.h
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#ifndef _CPPSTAX_RANGESTREAMBUFFER_H
+#define _CPPSTAX_RANGESTREAMBUFFER_H
+
+#include <streambuf>
+
+namespace cppstax
+{
+
+/**
+ * @brief Exposes nLength bytes of another stream buffer, starting at
+ *     nOffset, as a stream of its own.
+ * @details Doesn't buffer by itself, reads are passed on to the source.
+ */
+class RangeStreamBuffer : public std::streambuf
+{
+public:
+    RangeStreamBuffer(std::streambuf* pSource, std::streamoff nOffset, std::streamoff nLength);
+
+protected:
+    virtual int_type underflow();
+    virtual int_type uflow();
+    virtual int_type pbackfail(int_type nByte);
+    virtual std::streamsize xsgetn(char* pDestination, std::streamsize nCount);
+
+protected:
+    std::streambuf* m_pSource;
+    std::streamoff m_nLength;
+    std::streamoff m_nPosition;
+
+};
+
+}
+
+#endif
@@ -21,11 +21,12 @@
  */
 
 #include "StartElement.h"
+#include <stdexcept>
 
 namespace cppstax
 {
 
-StartElement::StartElement(std::unique_ptr<QName> pName, std::unique_ptr<std::list<std::unique_ptr<Attribute>>> pAttributes):
+StartElement::StartElement(std::shared_ptr<QName> pName, std::unique_ptr<std::list<std::unique_ptr<Attribute>>> pAttributes):
   m_pName(std::move(pName)),
   m_pAttributes(std::make_shared<std::list<std::shared_ptr<Attribute>>>())
 {
@@ -34,7 +34,7 @@ namespace cppstax
 class StartElement
 {
 public:
-    StartElement(std::unique_ptr<QName> pName, std::unique_ptr<std::list<std::unique_ptr<Attribute>>> pAttributes);
+    StartElement(std::shared_ptr<QName> pName, std::unique_ptr<std::list<std::unique_ptr<Attribute>>> pAttributes);
 
 public:
     const std::shared_ptr<Attribute> getAttributeByName(const QName& aName) const;
@@ -42,7 +42,7 @@ public:
     const QName& getName() const;
 
 protected:
-    std::unique_ptr<QName> m_pName;
+    std::shared_ptr<QName> m_pName;
     std::shared_ptr<std::list<std::shared_ptr<Attribute>>> m_pAttributes;
 
 };
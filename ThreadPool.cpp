@@ -0,0 +1,220 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/ThreadPool.cpp
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#include "ThreadPool.h"
+
+namespace cppstax
+{
+
+ThreadPool::ThreadPool(unsigned int nThreads):
+  m_nNextWorker(0),
+  m_nQueued(0),
+  m_nPending(0),
+  m_bStopping(false)
+{
+    if (nThreads <= 0)
+    {
+        nThreads = std::thread::hardware_concurrency();
+    }
+
+    if (nThreads <= 0)
+    {
+        nThreads = 1;
+    }
+
+    for (unsigned int i = 0; i < nThreads; i++)
+    {
+        m_aWorkers.push_back(std::unique_ptr<Worker>(new Worker));
+    }
+
+    for (unsigned int i = 0; i < nThreads; i++)
+    {
+        m_aThreads.push_back(std::thread(&ThreadPool::Run, this, i));
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    DiscardTasks();
+
+    {
+        std::lock_guard<std::mutex> aLock(m_aMutex);
+        m_bStopping = true;
+    }
+
+    m_aCondition.notify_all();
+
+    for (std::vector<std::thread>::iterator iter = m_aThreads.begin();
+         iter != m_aThreads.end();
+         iter++)
+    {
+        iter->join();
+    }
+}
+
+void ThreadPool::addTask(const Task& aTask)
+{
+    Worker& aWorker = *m_aWorkers[m_nNextWorker++ % m_aWorkers.size()];
+
+    // Counted before the task gets published, else a worker could take
+    // and complete it first, letting m_nQueued underflow and wait()
+    // return while tasks are still pending.
+    {
+        std::lock_guard<std::mutex> aLock(m_aMutex);
+        ++m_nPending;
+        ++m_nQueued;
+    }
+
+    {
+        std::lock_guard<std::mutex> aLock(aWorker.m_aMutex);
+        aWorker.m_aTasks.push_back(aTask);
+    }
+
+    m_aCondition.notify_one();
+}
+
+/**
+ * @brief Blocks until all tasks added so far are completed.
+ */
+void ThreadPool::wait()
+{
+    std::unique_lock<std::mutex> aLock(m_aMutex);
+
+    while (m_nPending > 0)
+    {
+        m_aIdleCondition.wait(aLock);
+    }
+}
+
+/**
+ * @brief Discards the tasks which haven't started yet and blocks until
+ *     the ones already running are completed. Not to be called while
+ *     another thread adds tasks.
+ */
+void ThreadPool::cancel()
+{
+    DiscardTasks();
+    wait();
+}
+
+unsigned int ThreadPool::getThreadCount() const
+{
+    return m_aThreads.size();
+}
+
+void ThreadPool::Run(unsigned int nWorker)
+{
+    while (true)
+    {
+        Task aTask;
+
+        if (TakeTask(nWorker, aTask) == true)
+        {
+            aTask(nWorker);
+
+            std::lock_guard<std::mutex> aLock(m_aMutex);
+
+            if (--m_nPending <= 0)
+            {
+                m_aIdleCondition.notify_all();
+            }
+
+            continue;
+        }
+
+        std::unique_lock<std::mutex> aLock(m_aMutex);
+
+        while (m_bStopping != true &&
+               m_nQueued <= 0)
+        {
+            m_aCondition.wait(aLock);
+        }
+
+        if (m_bStopping == true)
+        {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Takes the oldest task of the own queue, or else steals the newest
+ *     one of another worker, so the owner keeps working on the tasks it
+ *     got first.
+ */
+bool ThreadPool::TakeTask(unsigned int nWorker, Task& aTask)
+{
+    for (std::size_t i = 0, nMax = m_aWorkers.size(); i < nMax; i++)
+    {
+        Worker& aWorker = *m_aWorkers[(nWorker + i) % nMax];
+        std::lock_guard<std::mutex> aLock(aWorker.m_aMutex);
+
+        if (aWorker.m_aTasks.empty() == true)
+        {
+            continue;
+        }
+
+        if (i == 0)
+        {
+            aTask = std::move(aWorker.m_aTasks.front());
+            aWorker.m_aTasks.pop_front();
+        }
+        else
+        {
+            aTask = std::move(aWorker.m_aTasks.back());
+            aWorker.m_aTasks.pop_back();
+        }
+
+        --m_nQueued;
+
+        return true;
+    }
+
+    return false;
+}
+
+void ThreadPool::DiscardTasks()
+{
+    std::size_t nDiscarded = 0;
+
+    for (std::vector<std::unique_ptr<Worker>>::iterator iter = m_aWorkers.begin();
+         iter != m_aWorkers.end();
+         iter++)
+    {
+        std::lock_guard<std::mutex> aLock((*iter)->m_aMutex);
+
+        nDiscarded += (*iter)->m_aTasks.size();
+        m_nQueued -= (*iter)->m_aTasks.size();
+        (*iter)->m_aTasks.clear();
+    }
+
+    std::lock_guard<std::mutex> aLock(m_aMutex);
+
+    m_nPending -= nDiscarded;
+
+    if (m_nPending <= 0)
+    {
+        m_aIdleCondition.notify_all();
+    }
+}
+
+}
@@ -0,0 +1,95 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/ThreadPool.h
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#ifndef _CPPSTAX_THREADPOOL_H
+#define _CPPSTAX_THREADPOOL_H
+
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+namespace cppstax
+{
+
+/**
+ * @brief Fixed number of worker threads with a task queue each. Added
+ *     tasks are distributed over the queues, a worker whose queue ran
+ *     empty steals from the back of the others. Tasks which haven't
+ *     started yet when the pool gets destroyed are discarded.
+ */
+class ThreadPool
+{
+public:
+    /**
+     * @brief Gets the index of the worker running it, for per-worker state.
+     */
+    typedef std::function<void(unsigned int nWorker)> Task;
+
+public:
+    /**
+     * @param[in] nThreads 0 for the number of hardware threads.
+     */
+    ThreadPool(unsigned int nThreads);
+    ~ThreadPool();
+
+public:
+    void addTask(const Task& aTask);
+    void wait();
+    void cancel();
+    unsigned int getThreadCount() const;
+
+protected:
+    struct Worker
+    {
+        std::mutex m_aMutex;
+        std::deque<Task> m_aTasks;
+    };
+
+protected:
+    void Run(unsigned int nWorker);
+    bool TakeTask(unsigned int nWorker, Task& aTask);
+    void DiscardTasks();
+
+protected:
+    std::vector<std::unique_ptr<Worker>> m_aWorkers;
+    std::vector<std::thread> m_aThreads;
+    std::atomic<unsigned int> m_nNextWorker;
+    /** Tasks not taken by a worker yet. */
+    std::atomic<std::size_t> m_nQueued;
+    /** Tasks added and not completed yet. */
+    std::size_t m_nPending;
+    std::mutex m_aMutex;
+    std::condition_variable m_aCondition;
+    std::condition_variable m_aIdleCondition;
+    bool m_bStopping;
+
+};
+
+}
+
+#endif
@@ -0,0 +1,272 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLBatchParser.cpp
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#include "XMLBatchParser.h"
+#include "XMLStreamException.h"
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <stdexcept>
+
+namespace cppstax
+{
+
+XMLBatchParser::XMLBatchParser(unsigned int nThreads):
+  m_pThreadPool(new ThreadPool(nThreads))
+{
+    for (unsigned int i = 0; i < m_pThreadPool->getThreadCount(); i++)
+    {
+        std::unique_ptr<Worker> pWorker(new Worker);
+        pWorker->m_pDocumentBuffer.reset(new MemoryStreamBuffer(nullptr, 0));
+        pWorker->m_pDocumentStream.reset(new std::istream(pWorker->m_pDocumentBuffer.get()));
+
+        m_aWorkers.push_back(std::move(pWorker));
+    }
+}
+
+/**
+ * @retval Index of the document, as passed to the handlers.
+ */
+std::size_t XMLBatchParser::addFile(const std::string& strPath)
+{
+    Document aDocument;
+    aDocument.m_strPath = strPath;
+    aDocument.m_pData = nullptr;
+    aDocument.m_nLength = 0;
+
+    m_aDocuments.push_back(aDocument);
+
+    return m_aDocuments.size() - 1;
+}
+
+/**
+ * @param[in] pData Needs to stay valid until XMLBatchParser::run() returns.
+ * @retval Index of the document, as passed to the handlers.
+ */
+std::size_t XMLBatchParser::addBuffer(const char* pData, std::size_t nLength)
+{
+    if (pData == nullptr &&
+        nLength > 0)
+    {
+        throw new std::invalid_argument("Nullptr passed.");
+    }
+
+    Document aDocument;
+    aDocument.m_pData = pData;
+    aDocument.m_nLength = nLength;
+
+    m_aDocuments.push_back(aDocument);
+
+    return m_aDocuments.size() - 1;
+}
+
+/**
+ * @brief The readers get created by a copy of aFactory, for selecting the
+ *     engine.
+ */
+void XMLBatchParser::setInputFactory(const XMLInputFactory& aFactory)
+{
+    m_aFactory = aFactory;
+}
+
+void XMLBatchParser::setErrorHandler(const ErrorHandler& aErrorHandler)
+{
+    m_aErrorHandler = aErrorHandler;
+}
+
+/**
+ * @brief Parses all documents added since the last run and waits for
+ *     them to complete.
+ */
+XMLBatchParser::Statistics XMLBatchParser::run(const DocumentHandler& aHandler)
+{
+    if (!aHandler)
+    {
+        throw new std::invalid_argument("No document handler passed.");
+    }
+
+    for (std::vector<std::unique_ptr<Worker>>::iterator iter = m_aWorkers.begin();
+         iter != m_aWorkers.end();
+         iter++)
+    {
+        (*iter)->m_aFactory = m_aFactory;
+        (*iter)->m_pReader.reset(nullptr);
+        (*iter)->m_nDocuments = 0;
+        (*iter)->m_nFailures = 0;
+        (*iter)->m_nBytes = 0;
+    }
+
+    std::chrono::steady_clock::time_point aStart = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < m_aDocuments.size(); i++)
+    {
+        m_pThreadPool->addTask([this, i, &aHandler](unsigned int nWorker) { ParseDocument(*m_aWorkers[nWorker], i, aHandler); });
+    }
+
+    m_pThreadPool->wait();
+
+    std::chrono::duration<double> aDuration = std::chrono::steady_clock::now() - aStart;
+
+    Statistics aStatistics;
+    aStatistics.m_nDocuments = 0;
+    aStatistics.m_nFailures = 0;
+    aStatistics.m_nBytes = 0;
+    aStatistics.m_fSeconds = aDuration.count();
+
+    for (std::vector<std::unique_ptr<Worker>>::iterator iter = m_aWorkers.begin();
+         iter != m_aWorkers.end();
+         iter++)
+    {
+        aStatistics.m_nDocuments += (*iter)->m_nDocuments;
+        aStatistics.m_nFailures += (*iter)->m_nFailures;
+        aStatistics.m_nBytes += (*iter)->m_nBytes;
+    }
+
+    aStatistics.m_fDocumentsPerSecond = 0.0;
+    aStatistics.m_fBytesPerSecond = 0.0;
+
+    if (aStatistics.m_fSeconds > 0.0)
+    {
+        aStatistics.m_fDocumentsPerSecond = aStatistics.m_nDocuments / aStatistics.m_fSeconds;
+        aStatistics.m_fBytesPerSecond = aStatistics.m_nBytes / aStatistics.m_fSeconds;
+    }
+
+    m_aDocuments.clear();
+
+    return aStatistics;
+}
+
+/**
+ * @brief Runs on a thread of the pool, with the state of that worker.
+ */
+void XMLBatchParser::ParseDocument(Worker& aWorker, std::size_t nDocument, const DocumentHandler& aHandler)
+{
+    const Document& aDocument = m_aDocuments[nDocument];
+    const char* pData = aDocument.m_pData;
+    std::size_t nLength = aDocument.m_nLength;
+    std::string strError;
+
+    ++aWorker.m_nDocuments;
+
+    if (pData == nullptr &&
+        aDocument.m_strPath.empty() != true)
+    {
+        if (ReadFile(aDocument.m_strPath, aWorker.m_aBuffer) != true)
+        {
+            ++aWorker.m_nFailures;
+
+            if (m_aErrorHandler)
+            {
+                m_aErrorHandler(nDocument, "Couldn't open input file '" + aDocument.m_strPath + "'.");
+            }
+
+            return;
+        }
+
+        pData = aWorker.m_aBuffer.data();
+        nLength = aWorker.m_aBuffer.size();
+    }
+
+    aWorker.m_nBytes += nLength;
+
+    try
+    {
+        aWorker.m_pDocumentBuffer->reset(pData, nLength);
+
+        if (aWorker.m_pReader == nullptr)
+        {
+            aWorker.m_pReader = aWorker.m_aFactory.createXMLEventReader(*aWorker.m_pDocumentStream);
+        }
+        else
+        {
+            aWorker.m_pReader->reset(*aWorker.m_pDocumentStream);
+            aWorker.m_pReader->restoreDefaults();
+        }
+
+        aWorker.m_pReader->setThrowOnError(false);
+        aHandler(nDocument, *aWorker.m_pReader);
+
+        const XMLStreamError& aError = aWorker.m_pReader->getError();
+
+        if (aError.getCode() == XMLStreamError::ERROR_NONE)
+        {
+            return;
+        }
+
+        strError = XMLStreamException(aError.getMessage(), aError.getLocation()).what();
+    }
+    catch (std::exception* pException)
+    {
+        strError = pException->what();
+        delete pException;
+    }
+    catch (std::exception& aException)
+    {
+        strError = aException.what();
+    }
+
+    ++aWorker.m_nFailures;
+
+    if (m_aErrorHandler)
+    {
+        m_aErrorHandler(nDocument, strError);
+    }
+}
+
+/**
+ * @brief Reads the whole file into aBuffer, which keeps its capacity for
+ *     the next file.
+ */
+bool XMLBatchParser::ReadFile(const std::string& strPath, std::vector<char>& aBuffer)
+{
+    std::ifstream aStream(strPath.c_str(), std::ios::in | std::ios::binary);
+
+    if (aStream.is_open() != true)
+    {
+        return false;
+    }
+
+    aStream.seekg(0, std::ios::end);
+    std::streamoff nLength = aStream.tellg();
+    aStream.seekg(0, std::ios::beg);
+
+    if (nLength < 0)
+    {
+        return false;
+    }
+
+    aBuffer.resize(nLength);
+
+    if (nLength > 0)
+    {
+        aStream.read(aBuffer.data(), nLength);
+
+        if (aStream.gcount() != nLength)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}
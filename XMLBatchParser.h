@@ -0,0 +1,130 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLBatchParser.h
+ * @brief Parses many independent documents on a pool of worker threads.
+ * @details Every document gets a reader of its own, which is passed to
+ *     the DocumentHandler to consume the events. Documents are
+ *     distributed over the workers of a work-stealing ThreadPool, so a
+ *     few large documents don't hold up the small ones queued behind
+ *     them. Each worker keeps its read buffer and one reader for all
+ *     documents it handles, which is reset onto the next document (see
+ *     XMLEventReader::reset()) and gets its default settings restored
+ *     (see XMLEventReader::restoreDefaults()), so settings and entities
+ *     the DocumentHandler adds don't carry over to the next document,
+ *     same as with a reader of its own. The readers don't
+ *     throw on malformed input (see XMLEventReader::setThrowOnError()),
+ *     so rejecting bad documents costs about as much as reading good
+ *     ones.
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#ifndef _CPPSTAX_XMLBATCHPARSER_H
+#define _CPPSTAX_XMLBATCHPARSER_H
+
+#include "XMLEventReader.h"
+#include "XMLInputFactory.h"
+#include "MemoryStreamBuffer.h"
+#include "ThreadPool.h"
+#include <istream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <cstddef>
+
+namespace cppstax
+{
+
+class XMLBatchParser
+{
+public:
+    /**
+     * @brief Called on a worker thread, concurrently for different
+     *     documents. An error in the input ends the events early, it gets
+     *     reported to the ErrorHandler after the DocumentHandler returned.
+     * @param[in] nDocument Index in the order the documents were added.
+     */
+    typedef std::function<void(std::size_t nDocument, XMLEventReader& aReader)> DocumentHandler;
+    /**
+     * @brief Called on a worker thread if a document couldn't be read, was
+     *     malformed, or the reader or DocumentHandler threw an exception.
+     */
+    typedef std::function<void(std::size_t nDocument, const std::string& strMessage)> ErrorHandler;
+
+    struct Statistics
+    {
+        std::size_t m_nDocuments;
+        std::size_t m_nFailures;
+        unsigned long long m_nBytes;
+        double m_fSeconds;
+        double m_fDocumentsPerSecond;
+        double m_fBytesPerSecond;
+    };
+
+public:
+    /**
+     * @param[in] nThreads 0 for the number of hardware threads.
+     */
+    XMLBatchParser(unsigned int nThreads);
+
+public:
+    std::size_t addFile(const std::string& strPath);
+    std::size_t addBuffer(const char* pData, std::size_t nLength);
+    void setInputFactory(const XMLInputFactory& aFactory);
+    void setErrorHandler(const ErrorHandler& aErrorHandler);
+    Statistics run(const DocumentHandler& aHandler);
+
+protected:
+    struct Document
+    {
+        /** Empty for a buffer. */
+        std::string m_strPath;
+        const char* m_pData;
+        std::size_t m_nLength;
+    };
+
+    struct Worker
+    {
+        XMLInputFactory m_aFactory;
+        std::vector<char> m_aBuffer;
+        std::unique_ptr<MemoryStreamBuffer> m_pDocumentBuffer;
+        std::unique_ptr<std::istream> m_pDocumentStream;
+        /** Created by m_aFactory for the first document of a run. */
+        std::unique_ptr<XMLEventReader> m_pReader;
+        std::size_t m_nDocuments;
+        std::size_t m_nFailures;
+        unsigned long long m_nBytes;
+    };
+
+protected:
+    void ParseDocument(Worker& aWorker, std::size_t nDocument, const DocumentHandler& aHandler);
+    bool ReadFile(const std::string& strPath, std::vector<char>& aBuffer);
+
+protected:
+    std::unique_ptr<ThreadPool> m_pThreadPool;
+    std::vector<Document> m_aDocuments;
+    std::vector<std::unique_ptr<Worker>> m_aWorkers;
+    XMLInputFactory m_aFactory;
+    ErrorHandler m_aErrorHandler;
+
+};
+
+}
+
+#endif
@@ -0,0 +1,405 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLBinding.h
+ * @brief Describes how the fields of a struct get filled from an element,
+ *     for XMLDecoder.
+ * @details A struct gets bound by specializing XMLBinding, usually with
+ *     the macros at global scope:
+ *
+ *         CPPSTAX_BINDING_BEGIN(Book)
+ *             CPPSTAX_BIND("@id", strID)
+ *             CPPSTAX_BIND("title", strTitle)
+ *             CPPSTAX_BIND("info/year", nYear)
+ *             CPPSTAX_BIND("authors/author", aAuthors)
+ *         CPPSTAX_BINDING_END()
+ *
+ *     Paths are relative to the element the struct is decoded from: element
+ *     names separated by '/', optionally ending with "@name" for an
+ *     attribute of the element reached. Names are compared as written,
+ *     with prefix. A field gets the text of its element (of the element
+ *     itself, not of its children), or the attribute value, converted by
+ *     XMLValueTraits. Fields of a bound struct type get decoded from
+ *     their element, std::vector fields get an item for each element or
+ *     attribute matched. The conversion and the member access are
+ *     instantiated per field, decoding only compares names with memcmp().
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#ifndef _CPPSTAX_XMLBINDING_H
+#define _CPPSTAX_XMLBINDING_H
+
+#include "XMLValueParser.h"
+#include <string>
+#include <vector>
+#include <limits>
+#include <type_traits>
+#include <stdexcept>
+#include <cstddef>
+
+namespace cppstax
+{
+
+template<class T>
+class XMLBinder;
+
+/**
+ * @brief Specialized for each bound struct with a static
+ *     describe(XMLBinder<T>&), see CPPSTAX_BINDING_BEGIN().
+ */
+template<class T>
+struct XMLBinding;
+
+struct XMLBindingTable;
+
+struct XMLBindingField
+{
+    /** As passed to XMLBinder::bind(), for errors. */
+    std::string m_strPath;
+    /** Element names from the element of the struct on. */
+    std::vector<std::string> m_aSteps;
+    /** Empty if the field gets the text or is decoded from the element
+      * the steps lead to. */
+    std::string m_strAttribute;
+    /** Converts and stores a value, nullptr for a bound struct. */
+    bool (*m_pAssign)(void* pObject, const char* pData, std::size_t nLength);
+    /** The bound struct to decode into, added first for a std::vector. */
+    void* (*m_pObject)(void* pObject);
+    const XMLBindingTable& (*m_pTable)();
+};
+
+struct XMLBindingTable
+{
+    std::vector<XMLBindingField> m_aFields;
+};
+
+/**
+ * @brief Types with a value, specialized for those which can be converted
+ *     from text. Others need to be bound structs.
+ */
+template<class E>
+struct XMLValueTraits
+{
+    static const bool IS_VALUE = false;
+};
+
+template<>
+struct XMLValueTraits<std::string>
+{
+    static const bool IS_VALUE = true;
+
+    static bool assign(std::string& strValue, const char* pData, std::size_t nLength)
+    {
+        strValue.assign(pData, nLength);
+        return true;
+    }
+};
+
+template<>
+struct XMLValueTraits<bool>
+{
+    static const bool IS_VALUE = true;
+
+    static bool assign(bool& bValue, const char* pData, std::size_t nLength)
+    {
+        return XMLValueParser::parseBool(pData, nLength, bValue);
+    }
+};
+
+/**
+ * @brief For the integer types, converted as long long or unsigned long
+ *     long and checked against the range of E.
+ */
+template<class E, bool bSigned>
+struct XMLIntegerTraits
+{
+    static const bool IS_VALUE = true;
+
+    static bool assign(E& nValue, const char* pData, std::size_t nLength)
+    {
+        long long nResult = 0;
+
+        if (XMLValueParser::parseInt64(pData, nLength, nResult) != true ||
+            nResult < static_cast<long long>(std::numeric_limits<E>::min()) ||
+            nResult > static_cast<long long>(std::numeric_limits<E>::max()))
+        {
+            return false;
+        }
+
+        nValue = static_cast<E>(nResult);
+        return true;
+    }
+};
+
+template<class E>
+struct XMLIntegerTraits<E, false>
+{
+    static const bool IS_VALUE = true;
+
+    static bool assign(E& nValue, const char* pData, std::size_t nLength)
+    {
+        unsigned long long nResult = 0;
+
+        if (XMLValueParser::parseUInt64(pData, nLength, nResult) != true ||
+            nResult > static_cast<unsigned long long>(std::numeric_limits<E>::max()))
+        {
+            return false;
+        }
+
+        nValue = static_cast<E>(nResult);
+        return true;
+    }
+};
+
+template<> struct XMLValueTraits<short> : public XMLIntegerTraits<short, true> { };
+template<> struct XMLValueTraits<int> : public XMLIntegerTraits<int, true> { };
+template<> struct XMLValueTraits<long> : public XMLIntegerTraits<long, true> { };
+template<> struct XMLValueTraits<long long> : public XMLIntegerTraits<long long, true> { };
+template<> struct XMLValueTraits<unsigned short> : public XMLIntegerTraits<unsigned short, false> { };
+template<> struct XMLValueTraits<unsigned int> : public XMLIntegerTraits<unsigned int, false> { };
+template<> struct XMLValueTraits<unsigned long> : public XMLIntegerTraits<unsigned long, false> { };
+template<> struct XMLValueTraits<unsigned long long> : public XMLIntegerTraits<unsigned long long, false> { };
+
+template<class E>
+struct XMLFloatingPointTraits
+{
+    static const bool IS_VALUE = true;
+
+    static bool assign(E& fValue, const char* pData, std::size_t nLength)
+    {
+        double fResult = 0.0;
+
+        if (XMLValueParser::parseDouble(pData, nLength, fResult) != true)
+        {
+            return false;
+        }
+
+        fValue = static_cast<E>(fResult);
+        return true;
+    }
+};
+
+template<> struct XMLValueTraits<float> : public XMLFloatingPointTraits<float> { };
+template<> struct XMLValueTraits<double> : public XMLFloatingPointTraits<double> { };
+
+/**
+ * @brief The item a field of type M gets for each match.
+ */
+template<class M>
+struct XMLFieldTraits
+{
+    typedef M Item;
+
+    static Item& add(M& aField)
+    {
+        return aField;
+    }
+};
+
+template<class E, class A>
+struct XMLFieldTraits<std::vector<E, A>>
+{
+    typedef E Item;
+
+    static Item& add(std::vector<E, A>& aField)
+    {
+        aField.push_back(E());
+        return aField.back();
+    }
+};
+
+template<class T, class M, M T::*pMember>
+struct XMLFieldAccess
+{
+    typedef typename XMLFieldTraits<M>::Item Item;
+
+    static bool assign(void* pObject, const char* pData, std::size_t nLength)
+    {
+        Item& aItem = XMLFieldTraits<M>::add(static_cast<T*>(pObject)->*pMember);
+        return XMLValueTraits<Item>::assign(aItem, pData, nLength);
+    }
+
+    static void* object(void* pObject)
+    {
+        return &XMLFieldTraits<M>::add(static_cast<T*>(pObject)->*pMember);
+    }
+};
+
+/**
+ * @brief Collects the fields of T from XMLBinding<T>::describe() once.
+ */
+template<class T>
+class XMLBinder
+{
+public:
+    static const XMLBindingTable& getTable();
+
+public:
+    template<class M, M T::*pMember>
+    void bind(const std::string& strPath);
+
+protected:
+    XMLBinder(XMLBindingTable& aTable);
+
+protected:
+    template<class M, M T::*pMember>
+    void Register(XMLBindingField& aField, std::true_type);
+    template<class M, M T::*pMember>
+    void Register(XMLBindingField& aField, std::false_type);
+    static XMLBindingTable Describe();
+
+protected:
+    XMLBindingTable& m_aTable;
+
+};
+
+template<class T>
+XMLBinder<T>::XMLBinder(XMLBindingTable& aTable):
+  m_aTable(aTable)
+{
+
+}
+
+/**
+ * @brief The table is built on first use and shared from then on, also
+ *     between threads.
+ */
+template<class T>
+const XMLBindingTable& XMLBinder<T>::getTable()
+{
+    static const XMLBindingTable aTable(Describe());
+    return aTable;
+}
+
+/**
+ * @param strPath Element names separated by '/', optionally followed by
+ *     "@name" for an attribute, see XMLBinding.h.
+ */
+template<class T>
+template<class M, M T::*pMember>
+void XMLBinder<T>::bind(const std::string& strPath)
+{
+    XMLBindingField aField;
+    aField.m_strPath = strPath;
+
+    std::size_t nStart = 0;
+
+    while (nStart <= strPath.length())
+    {
+        std::size_t nEnd = strPath.find('/', nStart);
+
+        if (nEnd == std::string::npos)
+        {
+            nEnd = strPath.length();
+        }
+
+        std::string strStep(strPath, nStart, nEnd - nStart);
+
+        if (strStep.empty() == true ||
+            aField.m_strAttribute.empty() != true)
+        {
+            throw new std::invalid_argument("Binding path malformed.");
+        }
+
+        if (strStep[0] == '@')
+        {
+            aField.m_strAttribute = strStep.substr(1);
+
+            if (aField.m_strAttribute.empty() == true)
+            {
+                throw new std::invalid_argument("Binding path malformed.");
+            }
+        }
+        else
+        {
+            aField.m_aSteps.push_back(strStep);
+        }
+
+        nStart = nEnd + 1;
+    }
+
+    typedef typename XMLFieldTraits<M>::Item Item;
+
+    Register<M, pMember>(aField, std::integral_constant<bool, XMLValueTraits<Item>::IS_VALUE>());
+
+    m_aTable.m_aFields.push_back(aField);
+}
+
+template<class T>
+template<class M, M T::*pMember>
+void XMLBinder<T>::Register(XMLBindingField& aField, std::true_type)
+{
+    aField.m_pAssign = &XMLFieldAccess<T, M, pMember>::assign;
+    aField.m_pObject = nullptr;
+    aField.m_pTable = nullptr;
+}
+
+template<class T>
+template<class M, M T::*pMember>
+void XMLBinder<T>::Register(XMLBindingField& aField, std::false_type)
+{
+    if (aField.m_strAttribute.empty() != true ||
+        aField.m_aSteps.empty() == true)
+    {
+        throw new std::invalid_argument("A bound struct needs a path to an element.");
+    }
+
+    aField.m_pAssign = nullptr;
+    aField.m_pObject = &XMLFieldAccess<T, M, pMember>::object;
+    aField.m_pTable = &XMLBinder<typename XMLFieldTraits<M>::Item>::getTable;
+}
+
+template<class T>
+XMLBindingTable XMLBinder<T>::Describe()
+{
+    XMLBindingTable aTable;
+    XMLBinder<T> aBinder(aTable);
+
+    XMLBinding<T>::describe(aBinder);
+
+    return aTable;
+}
+
+}
+
+/**
+ * @brief Starts the binding of TYPE, needs to be used at global scope.
+ */
+#define CPPSTAX_BINDING_BEGIN(TYPE) \
+    namespace cppstax \
+    { \
+    template<> \
+    struct XMLBinding<TYPE> \
+    { \
+        typedef TYPE Type; \
+        \
+        static void describe(XMLBinder<TYPE>& aBinder) \
+        {
+
+/**
+ * @brief Binds the member MEMBER to PATH.
+ */
+#define CPPSTAX_BIND(PATH, MEMBER) \
+            aBinder.bind<decltype(Type::MEMBER), &Type::MEMBER>(PATH);
+
+#define CPPSTAX_BINDING_END() \
+        } \
+    }; \
+    }
+
+#endif
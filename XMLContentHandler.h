@@ -0,0 +1,78 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLContentHandler.h
+ * @brief Callbacks of XMLScanner and XMLPushParser, all doing nothing.
+ * @details Handlers derive from it and only define the callbacks they're
+ *     interested in. The callbacks aren't virtual: they're called on the
+ *     type of the handler, so a definition in the derived class hides the
+ *     one here and the compiler can inline either into the scanning loop.
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#ifndef _CPPSTAX_XMLCONTENTHANDLER_H
+#define _CPPSTAX_XMLCONTENTHANDLER_H
+
+#include "XMLScanner.h"
+
+namespace cppstax
+{
+
+class XMLContentHandler
+{
+public:
+    void onStartElement(const XMLSpan&, const XMLSpan&)
+    {
+
+    }
+
+    void onAttribute(const XMLSpan&, const XMLSpan&, const XMLSpan&)
+    {
+
+    }
+
+    void onEndElement(const XMLSpan&, const XMLSpan&)
+    {
+
+    }
+
+    void onText(const XMLSpan&)
+    {
+
+    }
+
+    void onComment(const XMLSpan&)
+    {
+
+    }
+
+    void onProcessingInstruction(const XMLSpan&, const XMLSpan&)
+    {
+
+    }
+
+    void onXMLDeclaration()
+    {
+
+    }
+
+};
+
+}
+
+#endif
@@ -0,0 +1,530 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLDecoder.h
+ * @brief Fills a bound struct directly from the scanned input, without
+ *     constructing any events.
+ * @details The root element gets decoded into the struct as described by
+ *     its XMLBinding, see XMLBinding.h. Each element advances the paths
+ *     of the fields which could still match, elements no path leads into
+ *     get skipped with XMLScanner::skipElement(). Text gets collected only
+ *     for elements with a field to assign it to. Input after the end of
+ *     the root element isn't scanned.
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#ifndef _CPPSTAX_XMLDECODER_H
+#define _CPPSTAX_XMLDECODER_H
+
+#include "XMLBinding.h"
+#include "XMLScanner.h"
+#include "XMLParserPolicy.h"
+#include "XMLContentHandler.h"
+#include "XMLStreamError.h"
+#include <istream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <map>
+#include <stdexcept>
+#include <cstring>
+#include <cstddef>
+
+namespace cppstax
+{
+
+template<class Policy = XMLDefaultPolicy>
+class XMLDecoder
+{
+public:
+    XMLDecoder();
+
+public:
+    int addToEntityReplacementDictionary(const std::string& strName, const std::string& strReplacementText);
+    template<class T>
+    bool decode(const char* pData, std::size_t nLength, T& aObject);
+    template<class T>
+    bool decode(std::istream& aStream, T& aObject);
+    const XMLStreamError& getError() const;
+
+protected:
+    class FieldHandler : public XMLContentHandler
+    {
+    public:
+        FieldHandler(XMLDecoder& aDecoder);
+
+    public:
+        void onStartElement(const XMLSpan& aPrefix, const XMLSpan& aLocalPart);
+        void onAttribute(const XMLSpan& aPrefix, const XMLSpan& aLocalPart, const XMLSpan& aValue);
+        void onEndElement(const XMLSpan& aPrefix, const XMLSpan& aLocalPart);
+        void onText(const XMLSpan& aText);
+
+    protected:
+        XMLDecoder& m_aDecoder;
+
+    };
+
+    /** A struct being decoded. */
+    struct Frame
+    {
+        const XMLBindingTable* m_pTable;
+        void* m_pObject;
+    };
+
+    /** A field of a Frame of which m_nSteps path steps have matched the
+      * open elements. */
+    struct Match
+    {
+        std::size_t m_nFrame;
+        std::size_t m_nField;
+        std::size_t m_nSteps;
+    };
+
+    /** An open element, owning the Matches and Frames from the indices on
+      * and the collected text from m_nTextBegin on. */
+    struct Level
+    {
+        std::size_t m_nMatchBegin;
+        std::size_t m_nFrameBegin;
+        std::size_t m_nTextBegin;
+        bool m_bCapture;
+    };
+
+protected:
+    template<class T>
+    bool Decode(XMLScanner<Policy, FieldHandler>& aScanner, T& aObject);
+    void StartElement(const XMLSpan& aPrefix, const XMLSpan& aLocalPart);
+    void Attribute(const XMLSpan& aPrefix, const XMLSpan& aLocalPart, const XMLSpan& aValue);
+    void EndElement();
+    void AddFields(std::size_t nFrame);
+    const XMLBindingField& FieldOf(const Match& aMatch) const;
+    void Assign(const Match& aMatch, const char* pData, std::size_t nLength);
+    static bool Equals(const std::string& strName, const XMLSpan& aPrefix, const XMLSpan& aLocalPart);
+
+protected:
+    std::map<std::string, std::string> m_aEntityReplacementDictionary;
+    XMLStreamError m_aError;
+
+    const XMLBindingTable* m_pRootTable;
+    void* m_pRootObject;
+    std::vector<Frame> m_aFrames;
+    std::vector<Match> m_aMatches;
+    std::vector<Level> m_aLevels;
+    std::string m_strText;
+    /** Name of the root element, for reporting it unclosed. */
+    std::string m_strRoot;
+    /** The first field a value couldn't be converted for. */
+    const XMLBindingField* m_pFailed;
+    /** If the element just started can be skipped. */
+    bool m_bSkip;
+    /** If the root element has ended. */
+    bool m_bDone;
+
+};
+
+template<class Policy>
+XMLDecoder<Policy>::XMLDecoder():
+  m_pRootTable(nullptr),
+  m_pRootObject(nullptr),
+  m_pFailed(nullptr),
+  m_bSkip(false),
+  m_bDone(false)
+{
+
+}
+
+/**
+ * @brief Same as XMLEventReader::addToEntityReplacementDictionary(), only
+ *     used for Policy::ENTITY_RESOLUTION.
+ */
+template<class Policy>
+int XMLDecoder<Policy>::addToEntityReplacementDictionary(const std::string& strName, const std::string& strReplacementText)
+{
+    if (strName == "amp" ||
+        strName == "lt" ||
+        strName == "gt" ||
+        strName == "apos" ||
+        strName == "quot")
+    {
+        throw new std::invalid_argument("Redefinition of built-in entity.");
+    }
+
+    m_aEntityReplacementDictionary[strName] = strReplacementText;
+    return 0;
+}
+
+/**
+ * @brief Decodes the root element of the nLength bytes at pData into
+ *     aObject, which needs to have a XMLBinding.
+ * @retval true if the input was decoded up to the end of the root element,
+ *     false with getError() telling the error otherwise, which includes
+ *     input ending before the root element or without one. Fields up to
+ *     the error were assigned.
+ */
+template<class Policy>
+template<class T>
+bool XMLDecoder<Policy>::decode(const char* pData, std::size_t nLength, T& aObject)
+{
+    FieldHandler aHandler(*this);
+    XMLScanner<Policy, FieldHandler> aScanner(aHandler);
+
+    aScanner.setEntityReplacementDictionary(&m_aEntityReplacementDictionary);
+    aScanner.setInput(pData, nLength);
+
+    return Decode(aScanner, aObject);
+}
+
+/**
+ * @brief Same as decode() for input in memory, aStream gets read a block
+ *     at a time while scanning.
+ */
+template<class Policy>
+template<class T>
+bool XMLDecoder<Policy>::decode(std::istream& aStream, T& aObject)
+{
+    std::streambuf* pSource = aStream.rdbuf();
+
+    if (aStream.good() != true ||
+        pSource == nullptr)
+    {
+        m_aError = XMLStreamError(XMLStreamError::ERROR_STREAM_BAD, Location());
+        return false;
+    }
+
+    FieldHandler aHandler(*this);
+    XMLScanner<Policy, FieldHandler> aScanner(aHandler);
+
+    aScanner.setEntityReplacementDictionary(&m_aEntityReplacementDictionary);
+    aScanner.setSource(pSource);
+
+    return Decode(aScanner, aObject);
+}
+
+template<class Policy>
+template<class T>
+bool XMLDecoder<Policy>::Decode(XMLScanner<Policy, FieldHandler>& aScanner, T& aObject)
+{
+    m_aError = XMLStreamError();
+    m_pRootTable = &XMLBinder<T>::getTable();
+    m_pRootObject = &aObject;
+    m_aFrames.clear();
+    m_aMatches.clear();
+    m_aLevels.clear();
+    m_strText.clear();
+    m_strRoot.clear();
+    m_pFailed = nullptr;
+    m_bSkip = false;
+    m_bDone = false;
+
+    while (m_bDone != true)
+    {
+        std::size_t nBegin = aScanner.getPosition();
+
+        if (aScanner.scanConstruct() != true)
+        {
+            m_aError = aScanner.getError();
+
+            if (m_aError.getCode() != XMLStreamError::ERROR_NONE)
+            {
+                return false;
+            }
+
+            // End of the input, with the root element still open.
+            if (m_aLevels.empty() != true)
+            {
+                m_aError = XMLStreamError(XMLStreamError::ERROR_ELEMENT_UNCLOSED, aScanner.getLocation(), m_strRoot);
+            }
+            else
+            {
+                m_aError = XMLStreamError(XMLStreamError::ERROR_ROOT_ELEMENT_MISSING, aScanner.getLocation());
+            }
+
+            return false;
+        }
+
+        if (m_pFailed != nullptr)
+        {
+            m_aError = XMLStreamError(XMLStreamError::ERROR_BINDING_VALUE_INVALID, aScanner.getLocation(nBegin), m_pFailed->m_strPath);
+            return false;
+        }
+
+        if (m_bSkip == true)
+        {
+            if (aScanner.skipElement(1) != true)
+            {
+                m_aError = aScanner.getError();
+                return false;
+            }
+
+            EndElement();
+        }
+    }
+
+    return true;
+}
+
+template<class Policy>
+const XMLStreamError& XMLDecoder<Policy>::getError() const
+{
+    return m_aError;
+}
+
+template<class Policy>
+void XMLDecoder<Policy>::StartElement(const XMLSpan& aPrefix, const XMLSpan& aLocalPart)
+{
+    Level aLevel;
+    aLevel.m_nMatchBegin = m_aMatches.size();
+    aLevel.m_nFrameBegin = m_aFrames.size();
+    aLevel.m_nTextBegin = m_strText.size();
+    aLevel.m_bCapture = false;
+
+    if (m_aLevels.empty() == true)
+    {
+        if (aPrefix.m_nLength > 0)
+        {
+            m_strRoot.assign(aPrefix.m_pData, aPrefix.m_nLength);
+            m_strRoot.push_back(':');
+        }
+
+        m_strRoot.append(aLocalPart.m_pData, aLocalPart.m_nLength);
+
+        Frame aFrame;
+        aFrame.m_pTable = m_pRootTable;
+        aFrame.m_pObject = m_pRootObject;
+
+        m_aFrames.push_back(aFrame);
+        AddFields(0);
+    }
+    else
+    {
+        const std::size_t nParentEnd = m_aMatches.size();
+
+        for (std::size_t i = m_aLevels.back().m_nMatchBegin; i < nParentEnd; i++)
+        {
+            Match aMatch = m_aMatches[i];
+            const XMLBindingField& aField = FieldOf(aMatch);
+
+            if (aMatch.m_nSteps < aField.m_aSteps.size() &&
+                Equals(aField.m_aSteps[aMatch.m_nSteps], aPrefix, aLocalPart) == true)
+            {
+                ++aMatch.m_nSteps;
+                m_aMatches.push_back(aMatch);
+            }
+        }
+
+        const std::size_t nEnd = m_aMatches.size();
+
+        for (std::size_t i = aLevel.m_nMatchBegin; i < nEnd; i++)
+        {
+            const Match aMatch = m_aMatches[i];
+            const XMLBindingField& aField = FieldOf(aMatch);
+
+            if (aMatch.m_nSteps < aField.m_aSteps.size() ||
+                aField.m_strAttribute.empty() != true)
+            {
+                continue;
+            }
+
+            if (aField.m_pAssign != nullptr)
+            {
+                aLevel.m_bCapture = true;
+            }
+            else
+            {
+                Frame aFrame;
+                aFrame.m_pTable = &aField.m_pTable();
+                aFrame.m_pObject = aField.m_pObject(m_aFrames[aMatch.m_nFrame].m_pObject);
+
+                m_aFrames.push_back(aFrame);
+                AddFields(m_aFrames.size() - 1);
+            }
+        }
+    }
+
+    m_aLevels.push_back(aLevel);
+
+    // Without text to collect or paths to continue, the content is of no
+    // interest (attributes still get reported).
+    m_bSkip = (aLevel.m_bCapture != true);
+
+    for (std::size_t i = aLevel.m_nMatchBegin; i < m_aMatches.size() && m_bSkip == true; i++)
+    {
+        if (m_aMatches[i].m_nSteps < FieldOf(m_aMatches[i]).m_aSteps.size())
+        {
+            m_bSkip = false;
+        }
+    }
+}
+
+template<class Policy>
+void XMLDecoder<Policy>::Attribute(const XMLSpan& aPrefix, const XMLSpan& aLocalPart, const XMLSpan& aValue)
+{
+    if (m_aLevels.empty() == true)
+    {
+        return;
+    }
+
+    for (std::size_t i = m_aLevels.back().m_nMatchBegin; i < m_aMatches.size(); i++)
+    {
+        const XMLBindingField& aField = FieldOf(m_aMatches[i]);
+
+        if (m_aMatches[i].m_nSteps == aField.m_aSteps.size() &&
+            aField.m_strAttribute.empty() != true &&
+            Equals(aField.m_strAttribute, aPrefix, aLocalPart) == true)
+        {
+            Assign(m_aMatches[i], aValue.m_pData, aValue.m_nLength);
+        }
+    }
+}
+
+/**
+ * @brief Assigns the collected text and closes the innermost element, also
+ *     after it was skipped.
+ */
+template<class Policy>
+void XMLDecoder<Policy>::EndElement()
+{
+    if (m_aLevels.empty() == true)
+    {
+        return;
+    }
+
+    const Level aLevel = m_aLevels.back();
+
+    if (aLevel.m_bCapture == true)
+    {
+        for (std::size_t i = aLevel.m_nMatchBegin; i < m_aMatches.size(); i++)
+        {
+            const XMLBindingField& aField = FieldOf(m_aMatches[i]);
+
+            if (m_aMatches[i].m_nSteps == aField.m_aSteps.size() &&
+                aField.m_strAttribute.empty() == true &&
+                aField.m_pAssign != nullptr)
+            {
+                Assign(m_aMatches[i], m_strText.data() + aLevel.m_nTextBegin, m_strText.size() - aLevel.m_nTextBegin);
+            }
+        }
+    }
+
+    m_strText.resize(aLevel.m_nTextBegin);
+    m_aMatches.resize(aLevel.m_nMatchBegin);
+    m_aFrames.resize(aLevel.m_nFrameBegin);
+    m_aLevels.pop_back();
+
+    m_bSkip = false;
+    m_bDone = m_aLevels.empty();
+}
+
+/**
+ * @brief Adds the fields of the struct of Frame nFrame with nothing matched
+ *     yet to the innermost element.
+ */
+template<class Policy>
+void XMLDecoder<Policy>::AddFields(std::size_t nFrame)
+{
+    const std::size_t nCount = m_aFrames[nFrame].m_pTable->m_aFields.size();
+
+    for (std::size_t i = 0; i < nCount; i++)
+    {
+        Match aMatch;
+        aMatch.m_nFrame = nFrame;
+        aMatch.m_nField = i;
+        aMatch.m_nSteps = 0;
+
+        m_aMatches.push_back(aMatch);
+    }
+}
+
+template<class Policy>
+const XMLBindingField& XMLDecoder<Policy>::FieldOf(const Match& aMatch) const
+{
+    return m_aFrames[aMatch.m_nFrame].m_pTable->m_aFields[aMatch.m_nField];
+}
+
+template<class Policy>
+void XMLDecoder<Policy>::Assign(const Match& aMatch, const char* pData, std::size_t nLength)
+{
+    const XMLBindingField& aField = FieldOf(aMatch);
+
+    if (aField.m_pAssign(m_aFrames[aMatch.m_nFrame].m_pObject, pData, nLength) != true &&
+        m_pFailed == nullptr)
+    {
+        m_pFailed = &aField;
+    }
+}
+
+/**
+ * @retval If strName is the name of prefix and local part, compared as
+ *     written.
+ */
+template<class Policy>
+bool XMLDecoder<Policy>::Equals(const std::string& strName, const XMLSpan& aPrefix, const XMLSpan& aLocalPart)
+{
+    if (aPrefix.m_nLength == 0)
+    {
+        return strName.length() == aLocalPart.m_nLength &&
+               std::memcmp(strName.data(), aLocalPart.m_pData, aLocalPart.m_nLength) == 0;
+    }
+
+    return strName.length() == aPrefix.m_nLength + 1 + aLocalPart.m_nLength &&
+           strName[aPrefix.m_nLength] == ':' &&
+           std::memcmp(strName.data(), aPrefix.m_pData, aPrefix.m_nLength) == 0 &&
+           std::memcmp(strName.data() + aPrefix.m_nLength + 1, aLocalPart.m_pData, aLocalPart.m_nLength) == 0;
+}
+
+template<class Policy>
+XMLDecoder<Policy>::FieldHandler::FieldHandler(XMLDecoder& aDecoder):
+  m_aDecoder(aDecoder)
+{
+
+}
+
+template<class Policy>
+void XMLDecoder<Policy>::FieldHandler::onStartElement(const XMLSpan& aPrefix, const XMLSpan& aLocalPart)
+{
+    m_aDecoder.StartElement(aPrefix, aLocalPart);
+}
+
+template<class Policy>
+void XMLDecoder<Policy>::FieldHandler::onAttribute(const XMLSpan& aPrefix, const XMLSpan& aLocalPart, const XMLSpan& aValue)
+{
+    m_aDecoder.Attribute(aPrefix, aLocalPart, aValue);
+}
+
+/**
+ * @brief Also called for an empty-element tag, right after its attributes.
+ */
+template<class Policy>
+void XMLDecoder<Policy>::FieldHandler::onEndElement(const XMLSpan&, const XMLSpan&)
+{
+    m_aDecoder.EndElement();
+}
+
+template<class Policy>
+void XMLDecoder<Policy>::FieldHandler::onText(const XMLSpan& aText)
+{
+    if (m_aDecoder.m_aLevels.empty() != true &&
+        m_aDecoder.m_aLevels.back().m_bCapture == true)
+    {
+        m_aDecoder.m_strText.append(aText.m_pData, aText.m_nLength);
+    }
+}
+
+}
+
+#endif
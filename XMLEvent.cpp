@@ -21,6 +21,7 @@
  */
 
 #include "XMLEvent.h"
+#include <stdexcept>
 
 namespace cppstax
 {
@@ -34,7 +35,11 @@ XMLEvent::XMLEvent(std::unique_ptr<StartElement> pStartElement,
   m_pEndElement(std::move(pEndElement)),
   m_pCharacters(std::move(pCharacters)),
   m_pComment(std::move(pComment)),
-  m_pProcessingInstruction(std::move(pProcessingInstruction))
+  m_pProcessingInstruction(std::move(pProcessingInstruction)),
+  m_pStartDocument(nullptr),
+  m_pEndDocument(nullptr),
+  m_nSourceOffset(-1),
+  m_nSourceLength(0)
 {
     int nPointerCount = 0;
 
@@ -69,6 +74,40 @@ XMLEvent::XMLEvent(std::unique_ptr<StartElement> pStartElement,
     }
 }
 
+XMLEvent::XMLEvent(std::unique_ptr<StartDocument> pStartDocument):
+  m_pStartElement(nullptr),
+  m_pEndElement(nullptr),
+  m_pCharacters(nullptr),
+  m_pComment(nullptr),
+  m_pProcessingInstruction(nullptr),
+  m_pStartDocument(std::move(pStartDocument)),
+  m_pEndDocument(nullptr),
+  m_nSourceOffset(-1),
+  m_nSourceLength(0)
+{
+    if (m_pStartDocument == nullptr)
+    {
+        throw new std::invalid_argument("Nullptr passed.");
+    }
+}
+
+XMLEvent::XMLEvent(std::unique_ptr<EndDocument> pEndDocument):
+  m_pStartElement(nullptr),
+  m_pEndElement(nullptr),
+  m_pCharacters(nullptr),
+  m_pComment(nullptr),
+  m_pProcessingInstruction(nullptr),
+  m_pStartDocument(nullptr),
+  m_pEndDocument(std::move(pEndDocument)),
+  m_nSourceOffset(-1),
+  m_nSourceLength(0)
+{
+    if (m_pEndDocument == nullptr)
+    {
+        throw new std::invalid_argument("Nullptr passed.");
+    }
+}
+
 bool XMLEvent::isStartElement()
 {
     return m_pStartElement != nullptr;
@@ -144,4 +183,78 @@ ProcessingInstruction& XMLEvent::asProcessingInstruction()
     return *m_pProcessingInstruction;
 }
 
+bool XMLEvent::isStartDocument()
+{
+    return m_pStartDocument != nullptr;
+}
+
+StartDocument& XMLEvent::asStartDocument()
+{
+    if (m_pStartDocument == nullptr)
+    {
+        throw new std::logic_error("Isn't a StartDocument.");
+    }
+
+    return *m_pStartDocument;
+}
+
+bool XMLEvent::isEndDocument()
+{
+    return m_pEndDocument != nullptr;
+}
+
+EndDocument& XMLEvent::asEndDocument()
+{
+    if (m_pEndDocument == nullptr)
+    {
+        throw new std::logic_error("Isn't an EndDocument.");
+    }
+
+    return *m_pEndDocument;
+}
+
+/**
+ * @brief Location of the start of the construct in the input. Unknown if
+ *     location tracking isn't enabled for the XMLEventReader.
+ */
+const Location& XMLEvent::getLocation() const
+{
+    return m_aLocation;
+}
+
+void XMLEvent::setLocation(const Location& aLocation)
+{
+    m_aLocation = aLocation;
+}
+
+/**
+ * @brief If the event carries the range of the input it was read from,
+ *     see XMLEventReader::setSourceRanges(). Events constructed otherwise
+ *     don't.
+ */
+bool XMLEvent::hasSourceRange() const
+{
+    return m_nSourceOffset >= 0;
+}
+
+/**
+ * @brief Offset in bytes of the range in the input, -1 if the event
+ *     doesn't carry one.
+ */
+std::streamoff XMLEvent::getSourceOffset() const
+{
+    return m_nSourceOffset;
+}
+
+std::streamoff XMLEvent::getSourceLength() const
+{
+    return m_nSourceLength;
+}
+
+void XMLEvent::setSourceRange(std::streamoff nOffset, std::streamoff nLength)
+{
+    m_nSourceOffset = nOffset;
+    m_nSourceLength = nLength;
+}
+
 }
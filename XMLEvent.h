@@ -28,6 +28,9 @@
 #include "Characters.h"
 #include "Comment.h"
 #include "ProcessingInstruction.h"
+#include "StartDocument.h"
+#include "EndDocument.h"
+#include "Location.h"
 #include <memory>
 
 namespace cppstax
@@ -41,6 +44,8 @@ public:
              std::unique_ptr<Characters> pCharacters,
              std::unique_ptr<Comment> pComment,
              std::unique_ptr<ProcessingInstruction> pProcessingInstruction);
+    XMLEvent(std::unique_ptr<StartDocument> pStartDocument);
+    XMLEvent(std::unique_ptr<EndDocument> pEndDocument);
 
 public:
     bool isStartElement();
@@ -53,6 +58,18 @@ public:
     Comment& asComment();
     bool isProcessingInstruction();
     ProcessingInstruction& asProcessingInstruction();
+    bool isStartDocument();
+    StartDocument& asStartDocument();
+    bool isEndDocument();
+    EndDocument& asEndDocument();
+
+public:
+    const Location& getLocation() const;
+    void setLocation(const Location& aLocation);
+    bool hasSourceRange() const;
+    std::streamoff getSourceOffset() const;
+    std::streamoff getSourceLength() const;
+    void setSourceRange(std::streamoff nOffset, std::streamoff nLength);
 
 protected:
     std::unique_ptr<StartElement> m_pStartElement;
@@ -60,6 +77,11 @@ protected:
     std::unique_ptr<Characters> m_pCharacters;
     std::unique_ptr<Comment> m_pComment;
     std::unique_ptr<ProcessingInstruction> m_pProcessingInstruction;
+    std::unique_ptr<StartDocument> m_pStartDocument;
+    std::unique_ptr<EndDocument> m_pEndDocument;
+    Location m_aLocation;
+    std::streamoff m_nSourceOffset;
+    std::streamoff m_nSourceLength;
 
 };
 
@@ -19,6 +19,7 @@
  * @todo Check well-formedness: check if start and end tags match by having a
  *     stack of the current XPath tree location/level/hierarchy/position, and
  *     if only one root element, and if starting with an element, etc.
+ *     XMLScanner checks the tags with Policy::CHECK_END_TAGS.
  * @author Stephan Kreutzer
  * @since 2017-08-24
   */
@@ -28,20 +29,67 @@
 #include "EndElement.h"
 #include "Characters.h"
 #include "Comment.h"
+#include "ProcessingInstruction.h"
 #include "QName.h"
 #include "Attribute.h"
+#include "XMLStreamException.h"
+#include "AllocationStats.h"
 #include <string>
 #include <memory>
-#include <sstream>
-#include <iomanip>
+#include <stdexcept>
 
 namespace cppstax
 {
 
+namespace
+{
+
+/** Event slots in the ring, a power of 2. A construct results in 4 events
+  * at most (a self-closing root tag in multiple documents mode, together
+  * with StartDocument and EndDocument). */
+const std::size_t EVENT_SLOTS = 4;
+
+}
+
 XMLEventReader::XMLEventReader(std::istream& aStream):
-  m_aStream(aStream),
-  m_bHasNextCalled(false)
+  XMLEventReader(aStream.rdbuf())
+{
+
+}
+
+/**
+ * @brief Reads from pBuffer, which will be destroyed together
+ *     with the reader.
+ */
+XMLEventReader::XMLEventReader(std::unique_ptr<std::streambuf> pBuffer):
+  XMLEventReader(pBuffer.get())
+{
+    m_pOwnedBuffer = std::move(pBuffer);
+}
+
+XMLEventReader::XMLEventReader(std::streambuf* pBuffer):
+  m_aStream(pBuffer),
+  m_pOwnedBuffer(nullptr),
+  m_aBuilder(*this),
+  m_aScanner(m_aBuilder),
+  m_bLocationTracking(false),
+  m_bStarted(false),
+  m_bHasNextCalled(false),
+  m_bStartElementReturned(false),
+  m_nEventFirst(0),
+  m_nEventCount(0),
+  m_bIgnoreWhitespace(false),
+  m_bIgnoreComments(false),
+  m_bIgnoreProcessingInstructions(false),
+  m_bMultipleDocuments(false),
+  m_bDocumentOpen(false),
+  m_nDocumentDepth(0),
+  m_bSourceRanges(false),
+  m_bThrowOnError(true)
 {
+    m_aEvents.reserve(EVENT_SLOTS);
+    m_aScanner.setEntityReplacementDictionary(&m_aEntityReplacementDictionary);
+
     m_aEntityReplacementDictionary.insert(std::pair<std::string, std::string>("amp", "&"));
     m_aEntityReplacementDictionary.insert(std::pair<std::string, std::string>("lt", "<"));
     m_aEntityReplacementDictionary.insert(std::pair<std::string, std::string>("gt", ">"));
@@ -62,7 +110,7 @@ XMLEventReader::~XMLEventReader()
 
 bool XMLEventReader::hasNext()
 {
-    if (m_aEvents.size() > 0)
+    if (m_nEventCount > 0)
     {
         return true;
     }
@@ -76,51 +124,153 @@ bool XMLEventReader::hasNext()
         m_bHasNextCalled = true;
     }
 
-    char cByte = '\0';
-    m_aStream.get(cByte);
+    return ReadEvents();
+}
 
-    if (m_aStream.eof() == true)
+/**
+ * @details The event is moved out of a slot of the reader, its
+ *     std::unique_ptr is the only allocation per event besides the
+ *     content of the event (the StartElement with its QName and
+ *     attributes, the text, ...). XMLEventReader::nextEvents() doesn't
+ *     need that one.
+ */
+std::unique_ptr<XMLEvent> XMLEventReader::nextEvent()
+{
+    if (m_nEventCount <= 0 &&
+        m_bHasNextCalled == false)
     {
-        return false;
+        if (hasNext() != true)
+        {
+            throw new std::logic_error("Attempted XMLEventReader::nextEvent() while there isn't one instead of checking XMLEventReader::hasNext() first.");
+        }
     }
 
-    if (m_aStream.bad() == true)
-    {
-        throw new std::runtime_error("Stream is bad.");
-    }
+    m_bHasNextCalled = false;
 
-    if (cByte == '<')
-    {
-        return HandleTag();
-    }
-    else
+    if (m_nEventCount <= 0)
     {
-        return HandleText(cByte);
+        throw new std::logic_error("XMLEventReader::nextEvent() while there isn't one, ignoring XMLEventReader::hasNext() == false.");
     }
+
+    AllocationScope aScope(AllocationStats::CATEGORY_EVENTS);
+    std::unique_ptr<XMLEvent> pEvent(new XMLEvent(std::move(FrontEvent())));
+    PopEvent();
+
+    m_bStartElementReturned = pEvent->isStartElement();
+
+    return pEvent;
 }
 
-std::unique_ptr<XMLEvent> XMLEventReader::nextEvent()
+/**
+ * @brief Reads up to nMax events into aEvents, which gets cleared first.
+ *     Parsing continues in one loop without the per-event checks of
+ *     XMLEventReader::hasNext() and XMLEventReader::nextEvent(), and
+ *     aEvents keeps its capacity when reused for the next call. The events
+ *     are moved from the slots of the reader into aEvents, so once it has
+ *     its capacity, nothing is allocated but the content of the events.
+ * @retval Number of events read, less than nMax only at the end of the
+ *     input. If an exception is thrown, aEvents holds the events which
+ *     preceded the error.
+ */
+std::size_t XMLEventReader::nextEvents(std::vector<XMLEvent>& aEvents, std::size_t nMax)
 {
-    if (m_aEvents.size() <= 0 &&
-        m_bHasNextCalled == false)
+    aEvents.clear();
+
+    while (aEvents.size() < nMax)
     {
-        if (hasNext() != true)
+        if (m_nEventCount <= 0)
         {
-            throw new std::logic_error("Attempted XMLEventReader::nextEvent() while there isn't one instead of checking XMLEventReader::hasNext() first.");
+            if (ReadEvents() != true)
+            {
+                break;
+            }
+        }
+
+        {
+            AllocationScope aScope(AllocationStats::CATEGORY_EVENTS);
+            aEvents.push_back(std::move(FrontEvent()));
         }
+
+        PopEvent();
     }
 
     m_bHasNextCalled = false;
+    m_bStartElementReturned = aEvents.size() > 0 && aEvents.back().isStartElement() == true;
+
+    return aEvents.size();
+}
+
+/**
+ * @brief Consumes the rest of the element whose StartElement was just
+ *     returned by XMLEventReader::nextEvent(), including its EndElement.
+ *     The subtree is only searched for markup by XMLScanner::skipElement()
+ *     to keep track of the depth, no events are constructed for it.
+ * @details Well-formedness isn't checked within the skipped subtree,
+ *     entities aren't resolved.
+ * @retval false after an error in the input if not throwing.
+ */
+bool XMLEventReader::skipElement()
+{
+    return SkipScannedElement(m_aScanner);
+}
+
+/**
+ * @brief Starts over with the next document read from aStream, as if the
+ *     reader was newly constructed on it, but keeping its buffers, the
+ *     entity replacement dictionary and all settings.
+ */
+void XMLEventReader::reset(std::istream& aStream)
+{
+    Reset(aStream.rdbuf());
+    m_pOwnedBuffer.reset(nullptr);
+}
+
+/**
+ * @brief Same as XMLEventReader::reset(std::istream&), reading from pBuffer,
+ *     which will be destroyed together with the reader.
+ */
+void XMLEventReader::reset(std::unique_ptr<std::streambuf> pBuffer)
+{
+    if (pBuffer == nullptr)
+    {
+        throw new std::invalid_argument("Nullptr passed.");
+    }
 
-    if (m_aEvents.size() <= 0)
+    Reset(pBuffer.get());
+    m_pOwnedBuffer = std::move(pBuffer);
+}
+
+/**
+ * @brief Puts all settings back to how a new reader starts out, and drops
+ *     the entities added to the dictionary. Needs to be called before
+ *     reading starts, usually right after XMLEventReader::reset().
+ */
+void XMLEventReader::restoreDefaults()
+{
+    if (m_bStarted == true)
     {
-        throw new std::logic_error("XMLEventReader::nextEvent() while there isn't one, ignoring XMLEventReader::hasNext() == false.");
+        throw new std::logic_error("Settings can't be restored after reading has started.");
     }
 
-    std::unique_ptr<XMLEvent> pEvent = std::move(m_aEvents.front());
-    m_aEvents.pop();
+    // The built-in entities can't be redefined, so if there are only five,
+    // there's nothing to drop.
+    if (m_aEntityReplacementDictionary.size() != 5)
+    {
+        m_aEntityReplacementDictionary.clear();
+        m_aEntityReplacementDictionary.insert(std::pair<std::string, std::string>("amp", "&"));
+        m_aEntityReplacementDictionary.insert(std::pair<std::string, std::string>("lt", "<"));
+        m_aEntityReplacementDictionary.insert(std::pair<std::string, std::string>("gt", ">"));
+        m_aEntityReplacementDictionary.insert(std::pair<std::string, std::string>("apos", "'"));
+        m_aEntityReplacementDictionary.insert(std::pair<std::string, std::string>("quot", "\""));
+    }
 
-    return std::move(pEvent);
+    m_bIgnoreWhitespace = false;
+    m_bIgnoreComments = false;
+    m_bIgnoreProcessingInstructions = false;
+    m_bMultipleDocuments = false;
+    m_bThrowOnError = true;
+    m_bLocationTracking = false;
+    m_bSourceRanges = false;
 }
 
 int XMLEventReader::addToEntityReplacementDictionary(const std::string& strName, const std::string& strReplacementText)
@@ -138,1034 +288,543 @@ int XMLEventReader::addToEntityReplacementDictionary(const std::string& strName,
        return 0;
 }
 
-bool XMLEventReader::HandleTag()
+/**
+ * @brief Text that consists of whitespace only won't be reported
+ *     as Characters event.
+ */
+void XMLEventReader::setIgnoreWhitespace(bool bIgnoreWhitespace)
 {
-    char cByte = '\0';
-    m_aStream.get(cByte);
+    m_bIgnoreWhitespace = bIgnoreWhitespace;
+}
 
-    if (m_aStream.eof() == true)
-    {
-        throw new std::runtime_error("Tag incomplete.");
-    }
+void XMLEventReader::setIgnoreComments(bool bIgnoreComments)
+{
+    m_bIgnoreComments = bIgnoreComments;
+}
 
-    if (m_aStream.bad() == true)
-    {
-        throw new std::runtime_error("Stream is bad.");
-    }
+void XMLEventReader::setIgnoreProcessingInstructions(bool bIgnoreProcessingInstructions)
+{
+    m_bIgnoreProcessingInstructions = bIgnoreProcessingInstructions;
+}
 
-    if (cByte == '?')
-    {
-        if (HandleProcessingInstruction() == true)
-        {
-            return true;
-        }
-        else
-        {
-            m_bHasNextCalled = false;
-            return hasNext();
-        }
-    }
-    else if (cByte == '/')
-    {
-        return HandleTagEnd();
-    }
-    else if (cByte == '!')
-    {
-        return HandleMarkupDeclaration();
-    }
-    else if (std::isalpha(cByte, m_aLocale) == true ||
-             cByte == '_')
-    {
-        return HandleTagStart(cByte);
-    }
-    else
+/**
+ * @brief For input of several documents one after another, like messages
+ *     written into the same stream. Each document is reported between a
+ *     StartDocument and an EndDocument event. A document ends with the
+ *     end of its root element, at an XML declaration or at the end of
+ *     the input, the next one starts with its XML declaration or its
+ *     first event. Whitespace between documents isn't reported, while
+ *     comments and processing instructions after a root element become
+ *     part of the next document. Needs to be set before reading starts.
+ */
+void XMLEventReader::setMultipleDocuments(bool bMultipleDocuments)
+{
+    if (m_bStarted == true)
     {
-        int nByte(cByte);
-        std::stringstream aMessage;
-        aMessage << "Unknown byte '" << cByte << "' (0x"
-                 << std::hex << std::uppercase << nByte << std::nouppercase << std::dec
-                 << ") within element.";
-        throw new std::runtime_error(aMessage.str());
+        throw new std::logic_error("Multiple documents mode can't be changed after reading has started.");
     }
+
+    m_bMultipleDocuments = bMultipleDocuments;
 }
 
-bool XMLEventReader::HandleTagStart(const char& cFirstByte)
+/**
+ * @brief Events carry the range of the input they were read from (see
+ *     XMLEvent::getSourceOffset()), so XMLEventWriter::setSource() can
+ *     copy unmodified events instead of serializing them again. The
+ *     offsets are the positions of the scanner, location tracking isn't
+ *     needed for them. Needs to be set before reading starts.
+ */
+void XMLEventReader::setSourceRanges(bool bSourceRanges)
 {
-    char cByte = '\0';
-    m_aStream.get(cByte);
-
-    if (m_aStream.eof() == true)
+    if (m_bStarted == true)
     {
-        throw new std::runtime_error("Tag start incomplete.");
+        throw new std::logic_error("Source ranges can't be changed after reading has started.");
     }
 
-    if (m_aStream.bad() == true)
+    m_bSourceRanges = bSourceRanges;
+}
+
+/**
+ * @brief Events and errors get the Location in the input attached. Needs
+ *     to be set before reading starts.
+ */
+void XMLEventReader::setLocationTracking(bool bLocationTracking)
+{
+    if (m_bStarted == true)
     {
-        throw new std::runtime_error("Stream is bad.");
+        throw new std::logic_error("Location tracking can't be changed after reading has started.");
     }
 
-    std::unique_ptr<std::string> pNamePrefix(nullptr);
-    std::unique_ptr<std::string> pNameLocalPart(new std::string());
-    std::unique_ptr<std::list<std::unique_ptr<Attribute>>> pAttributes(new std::list<std::unique_ptr<Attribute>>);
-
-    pNameLocalPart->push_back(cFirstByte);
+    m_bLocationTracking = bLocationTracking;
+}
 
-    do
+/**
+ * @brief Current read position, unknown if location tracking isn't enabled.
+ */
+Location XMLEventReader::getLocation()
+{
+    if (m_bLocationTracking != true)
     {
-        /** @todo Check, if special characters appear at the very start where not allowed.
-          * This might apply for the namespace prefix as well as for the element name. */
-
-        if (cByte == ':')
-        {
-            if (pNamePrefix != nullptr)
-            {
-                throw new std::runtime_error("There can't be two prefixes in element name.");
-            }
-
-            pNamePrefix = std::move(pNameLocalPart);
-            pNameLocalPart.reset(new std::string());
-        }
-        else if (cByte == '>')
-        {
-            if (pNamePrefix == nullptr)
-            {
-                pNamePrefix.reset(new std::string);
-            }
-
-            std::unique_ptr<QName> pName(new QName("", *pNameLocalPart, *pNamePrefix));
-            std::unique_ptr<StartElement> pStartElement(new StartElement(std::move(pName), std::move(pAttributes)));
-            std::unique_ptr<XMLEvent> pEvent(new XMLEvent(std::move(pStartElement),
-                                                          nullptr,
-                                                          nullptr,
-                                                          nullptr,
-                                                          nullptr));
-            m_aEvents.push(std::move(pEvent));
-            break;
-        }
-        else if (cByte == '/')
-        {
-            m_aStream.get(cByte);
-
-            if (m_aStream.eof() == true)
-            {
-                throw new std::runtime_error("Tag start incomplete.");
-            }
-
-            if (m_aStream.bad() == true)
-            {
-                throw new std::runtime_error("Stream is bad.");
-            }
-
-            if (cByte != '>')
-            {
-                throw new std::runtime_error("Empty start + end tag end without closing '>'.");
-            }
-
-            if (pNamePrefix == nullptr)
-            {
-                pNamePrefix.reset(new std::string);
-            }
-
-            std::unique_ptr<QName> pName(new QName("", *pNameLocalPart, *pNamePrefix));
-            std::unique_ptr<StartElement> pStartElement(new StartElement(std::move(pName), std::move(pAttributes)));
-            std::unique_ptr<XMLEvent> pEvent(new XMLEvent(std::move(pStartElement),
-                                                          nullptr,
-                                                          nullptr,
-                                                          nullptr,
-                                                          nullptr));
-            m_aEvents.push(std::move(pEvent));
-
-            pName = std::unique_ptr<QName>(new QName("", *pNameLocalPart, *pNamePrefix));
-            std::unique_ptr<EndElement> pEndElement(new EndElement(std::move(pName)));
-            pEvent = std::unique_ptr<XMLEvent>(new XMLEvent(nullptr,
-                                                            std::move(pEndElement),
-                                                            nullptr,
-                                                            nullptr,
-                                                            nullptr));
-            m_aEvents.push(std::move(pEvent));
+        return Location();
+    }
 
-            break;
-        }
-        else if (std::isspace(cByte, m_aLocale) != 0)
-        {
-            if (pNameLocalPart->length() <= 0)
-            {
-                throw new std::runtime_error("Start tag name begins with whitespace.");
-            }
+    return m_aScanner.getLocation();
+}
 
-            while (true)
-            {
-                m_aStream.get(cByte);
-
-                if (m_aStream.eof() == true)
-                {
-                    throw new std::runtime_error("Tag start incomplete.");
-                }
-
-                if (m_aStream.bad() == true)
-                {
-                    throw new std::runtime_error("Stream is bad.");
-                }
-
-                if (cByte == '>')
-                {
-                    break;
-                }
-                else if (std::isspace(cByte, m_aLocale) != 0)
-                {
-                    // Ignore/consume.
-                }
-                else if (cByte == '/')
-                {
-                    m_aStream.unget();
-
-                    if (m_aStream.bad() == true)
-                    {
-                        throw new std::runtime_error("Stream is bad.");
-                    }
-
-                    break;
-                }
-                else
-                {
-                    HandleAttributes(cByte, pAttributes);
-                    break;
-                }
-            }
-        }
-        else if (std::isalnum(cByte, m_aLocale) == true ||
-                 cByte == '-' ||
-                 cByte == '_' ||
-                 cByte == '.')
-        {
-            pNameLocalPart->push_back(cByte);
-        }
-        else
-        {
-            int nByte(cByte);
-            std::stringstream aMessage;
-            aMessage << "Character '" << cByte << "' (0x"
-                     << std::hex << std::uppercase << nByte << std::nouppercase << std::dec
-                     << ") not supported in a start tag name.";
-            throw new std::runtime_error(aMessage.str());
-        }
+/**
+ * @brief If disabled, errors in the input aren't thrown as XMLStreamException
+ *     but end the input instead: XMLEventReader::hasNext() and
+ *     XMLEventReader::skipElement() return false, and the error can be
+ *     retrieved with XMLEventReader::getError(). Makes rejecting malformed
+ *     input about as cheap as reading it. Enabled by default.
+ */
+void XMLEventReader::setThrowOnError(bool bThrowOnError)
+{
+    m_bThrowOnError = bThrowOnError;
+}
 
-        m_aStream.get(cByte);
+/**
+ * @brief The error which ended the input if XMLEventReader::setThrowOnError()
+ *     is disabled, XMLStreamError::ERROR_NONE otherwise.
+ */
+const XMLStreamError& XMLEventReader::getError() const
+{
+    return m_aError;
+}
 
-        if (m_aStream.eof() == true)
-        {
-            throw new std::runtime_error("Tag start incomplete.");
-        }
+/**
+ * @brief Parses constructs until there's at least one event in the queue.
+ *     Constructs which are ignored or don't result in an event (like the
+ *     XML declaration) are consumed on the way.
+ * @retval false at the end of the input or after an error in the input
+ *     if not throwing.
+ */
+bool XMLEventReader::ReadEvents()
+{
+    return ScanEvents(m_aScanner);
+}
 
-        if (m_aStream.bad() == true)
-        {
-            throw new std::runtime_error("Stream is bad.");
-        }
+bool XMLEventReader::Fail(XMLStreamError::Code eCode)
+{
+    return Fail(XMLStreamError(eCode, getLocation()));
+}
 
-    } while (true);
+/**
+ * @brief Rewinds the parser state onto pBuffer. Derived readers
+ *     rewind their own state and call this.
+ */
+void XMLEventReader::Reset(std::streambuf* pBuffer)
+{
+    if (pBuffer == nullptr)
+    {
+        throw new std::invalid_argument("Nullptr passed.");
+    }
 
-    return true;
+    m_aStream.rdbuf(pBuffer);
+    // The scanner keeps its buffer with its capacity.
+    m_aScanner.setInput(nullptr, 0);
+    m_pPendingName.reset();
+    m_pPendingAttributes.reset();
+    m_aEventLocation = Location();
+    m_bStarted = false;
+    m_bHasNextCalled = false;
+    m_bStartElementReturned = false;
+    m_nEventFirst = 0;
+    m_nEventCount = 0;
+    m_bDocumentOpen = false;
+    m_nDocumentDepth = 0;
+    m_aError = XMLStreamError();
 }
 
-bool XMLEventReader::HandleTagEnd()
+/**
+ * @brief Throws aError as XMLStreamException or, if not throwing, records
+ *     it. Parsing stops at the first error either way. The scanner knows
+ *     the location of its errors, which is only reported with location
+ *     tracking enabled, same as for the events.
+ * @retval Always false, for returning it from the parsing methods.
+ */
+bool XMLEventReader::Fail(const XMLStreamError& aError)
 {
-    char cByte = '\0';
-    m_aStream.get(cByte);
+    XMLStreamError aReportedError(aError);
 
-    if (m_aStream.eof() == true)
+    if (m_bLocationTracking != true)
     {
-        throw new std::runtime_error("Tag end incomplete.");
+        aReportedError.setLocation(Location());
     }
 
-    if (m_aStream.bad() == true)
+    if (m_bThrowOnError == true)
     {
-        throw new std::runtime_error("Stream is bad.");
+        throw new XMLStreamException(aReportedError.getMessage(), aReportedError.getLocation());
     }
 
-    std::unique_ptr<std::string> pNamePrefix(nullptr);
-    std::unique_ptr<std::string> pNameLocalPart(new std::string());
+    m_aError = aReportedError;
 
-    // No validity check for the XML element name is needed
-    // if end tags are compared to start tags and the start
-    // tags were already checked.
-
-    bool bComplete = false;
+    return false;
+}
 
-    do
-    {
-        if (cByte == ':')
-        {
-            if (pNamePrefix != nullptr)
-            {
-                throw new std::runtime_error("There can't be two prefixes in the element name.");
-            }
+/**
+ * @retval false if aSpan refers to a buffer of the scanner where entity
+ *     references were replaced, see XMLScanner::isInput().
+ */
+bool XMLEventReader::IsScannedInput(const XMLSpan& aSpan) const
+{
+    return m_aScanner.isInput(aSpan);
+}
 
-            pNamePrefix = std::move(pNameLocalPart);
-            pNameLocalPart.reset(new std::string());
-        }
-        else if (cByte == '>')
-        {
-            if (pNamePrefix == nullptr)
-            {
-                pNamePrefix.reset(new std::string);
-            }
+void XMLEventReader::PushStartElement()
+{
+    AllocationScope aEventScope(AllocationStats::CATEGORY_EVENTS);
+    std::unique_ptr<StartElement> pStartElement(new StartElement(std::move(m_pPendingName), std::move(m_pPendingAttributes)));
+    PushEvent(XMLEvent(std::move(pStartElement),
+                       nullptr,
+                       nullptr,
+                       nullptr,
+                       nullptr));
+}
 
-            std::unique_ptr<QName> pName(new QName("", *pNameLocalPart, *pNamePrefix));
-            std::unique_ptr<EndElement> pEndElement(new EndElement(std::move(pName)));
-            std::unique_ptr<XMLEvent> pEvent(new XMLEvent(nullptr,
-                                                          std::move(pEndElement),
-                                                          nullptr,
-                                                          nullptr,
-                                                          nullptr));
-            m_aEvents.push(std::move(pEvent));
+/**
+ * @brief Moves aEvent into the next free slot of the ring. The slots get
+ *     allocated once and are reused from then on.
+ */
+void XMLEventReader::PushEvent(XMLEvent&& aEvent)
+{
+    if (m_bMultipleDocuments != true)
+    {
+        PushSlot(std::move(aEvent));
+        return;
+    }
 
-            bComplete = true;
-            break;
-        }
-        else if (std::isalnum(cByte, m_aLocale) == true ||
-                 cByte == '-' ||
-                 cByte == '_' ||
-                 cByte == '.')
-        {
-            pNameLocalPart->push_back(cByte);
-        }
-        else
+    if (m_bDocumentOpen != true)
+    {
+        if (aEvent.isCharacters() == true &&
+            IsWhitespace(aEvent.asCharacters().getData()) == true)
         {
-            int nByte(cByte);
-            std::stringstream aMessage;
-            aMessage << "Character '" << cByte << "' (0x"
-                     << std::hex << std::uppercase << nByte << std::nouppercase << std::dec
-                     << ") not supported in an end tag name.";
-            throw new std::runtime_error(aMessage.str());
+            return;
         }
 
-        m_aStream.get(cByte);
+        OpenDocument();
+    }
 
-        if (m_aStream.eof() == true)
-        {
-            throw new std::runtime_error("End tag incomplete.");
-        }
+    bool bRootEnded = false;
 
-        if (m_aStream.bad() == true)
-        {
-            throw new std::runtime_error("Stream is bad.");
-        }
+    if (aEvent.isStartElement() == true)
+    {
+        ++m_nDocumentDepth;
+    }
+    else if (aEvent.isEndElement() == true &&
+             m_nDocumentDepth > 0)
+    {
+        --m_nDocumentDepth;
+        bRootEnded = m_nDocumentDepth <= 0;
+    }
 
-    } while (true);
+    PushSlot(std::move(aEvent));
 
-    if (bComplete != true)
+    if (bRootEnded == true)
     {
-        throw new std::runtime_error("End tag incomplete.");
+        CloseDocument();
     }
-
-    return true;
 }
 
-bool XMLEventReader::HandleText(const char& cFirstByte)
+void XMLEventReader::PushSlot(XMLEvent&& aEvent)
 {
-    std::unique_ptr<std::string> pData(new std::string);
-
-    if (cFirstByte == '&')
+    if (m_nEventCount >= EVENT_SLOTS)
     {
-        std::unique_ptr<std::string> pResolvedText = nullptr;
+        throw new std::logic_error("XMLEventReader event slots exhausted.");
+    }
+
+    aEvent.setLocation(m_aEventLocation);
 
-        ResolveEntity(pResolvedText);
-        pData->append(*pResolvedText);
+    std::size_t nSlot = (m_nEventFirst + m_nEventCount) & (EVENT_SLOTS - 1);
+
+    if (nSlot < m_aEvents.size())
+    {
+        m_aEvents[nSlot] = std::move(aEvent);
     }
     else
     {
-        pData->push_back(cFirstByte);
+        AllocationScope aEventScope(AllocationStats::CATEGORY_EVENTS);
+        m_aEvents.push_back(std::move(aEvent));
     }
 
-    char cByte = '\0';
+    ++m_nEventCount;
+}
+
+/**
+ * @brief Attaches [nBegin, nEnd) of the input to the events pushed from
+ *     nFirst on, which stem from a single construct. The range goes to
+ *     the event of the construct (to the StartDocument for an XML
+ *     declaration), the events reported along get an empty range in
+ *     front of or behind it, like the EndElement of an empty-element tag.
+ */
+void XMLEventReader::SetSourceRanges(std::size_t nFirst, std::size_t nBegin, std::size_t nEnd)
+{
+    std::size_t nConstruct = m_nEventCount;
 
-    while (true)
+    for (std::size_t i = nFirst; i < m_nEventCount; i++)
     {
-        m_aStream.get(cByte);
+        XMLEvent& aEvent = m_aEvents[(m_nEventFirst + i) & (EVENT_SLOTS - 1)];
 
-        if (m_aStream.eof() == true)
+        if (aEvent.isStartDocument() == true)
         {
-            break;
+            nConstruct = i;
         }
-
-        if (m_aStream.bad() == true)
+        else if (aEvent.isEndDocument() != true)
         {
-            throw new std::runtime_error("Stream is bad.");
+            nConstruct = i;
+            break;
         }
+    }
 
-        if (cByte == '<')
-        {
-            m_aStream.unget();
-
-            if (m_aStream.bad() == true)
-            {
-                throw new std::runtime_error("Stream is bad.");
-            }
+    for (std::size_t i = nFirst; i < m_nEventCount; i++)
+    {
+        XMLEvent& aEvent = m_aEvents[(m_nEventFirst + i) & (EVENT_SLOTS - 1)];
 
-            break;
+        if (i < nConstruct)
+        {
+            aEvent.setSourceRange(nBegin, 0);
         }
-        else if (cByte == '&')
+        else if (i == nConstruct)
         {
-            std::unique_ptr<std::string> pResolvedText = nullptr;
-
-            ResolveEntity(pResolvedText);
-            pData->append(*pResolvedText);
+            aEvent.setSourceRange(nBegin, nEnd - nBegin);
         }
         else
         {
-            pData->push_back(cByte);
+            aEvent.setSourceRange(nEnd, 0);
         }
     }
-
-    std::unique_ptr<Characters> pCharacters(new Characters(std::move(pData)));
-    std::unique_ptr<XMLEvent> pEvent(new XMLEvent(nullptr,
-                                                  nullptr,
-                                                  std::move(pCharacters),
-                                                  nullptr,
-                                                  nullptr));
-    m_aEvents.push(std::move(pEvent));
-
-    return true;
 }
 
-bool XMLEventReader::HandleProcessingInstruction()
+/**
+ * @brief Reports the start of a document, ending the open one first.
+ */
+void XMLEventReader::OpenDocument()
 {
-    std::unique_ptr<std::string> pTarget = nullptr;
-
-    HandleProcessingInstructionTarget(pTarget);
-
-    if (pTarget == nullptr)
+    if (m_bDocumentOpen == true)
     {
-        throw new std::runtime_error("Processing instruction without target name.");
+        CloseDocument();
     }
 
-    if (pTarget->length() == 3)
-    {
-        if ((pTarget->at(0) == 'x' ||
-             pTarget->at(0) == 'X') &&
-            (pTarget->at(1) == 'm' ||
-             pTarget->at(1) == 'M') &&
-            (pTarget->at(2) == 'l' ||
-             pTarget->at(2) == 'L'))
-        {
-            /** @todo This should read the XML declaration instructions instead
-              * of just consuming/ignoring it. */
-
-            char cByte('\0');
-            int nMatchCount = 0;
-
-            while (nMatchCount < 2)
-            {
-                m_aStream.get(cByte);
-
-                if (m_aStream.eof() == true)
-                {
-                    throw new std::runtime_error("XML declaration incomplete.");
-                }
-
-                if (m_aStream.bad() == true)
-                {
-                    throw new std::runtime_error("Stream is bad.");
-                }
-
-                if (cByte == '?' &&
-                    nMatchCount <= 0)
-                {
-                    nMatchCount++;
-                }
-                else if (cByte == '>' &&
-                        nMatchCount <= 1)
-                {
-                    return false;
-                }
-            }
-
-            return false;
-        }
-    }
-
-    std::unique_ptr<std::string> pData(new std::string);
-    char cByte('\0');
-    int nMatchCount = 0;
-
-    while (nMatchCount < 2)
-    {
-        m_aStream.get(cByte);
-
-        if (m_aStream.eof() == true)
-        {
-            throw new std::runtime_error("Processing instruction data incomplete.");
-        }
-
-        if (m_aStream.bad() == true)
-        {
-            throw new std::runtime_error("Stream is bad.");
-        }
-
-        if (cByte == '?' &&
-            nMatchCount <= 0)
-        {
-            nMatchCount++;
-        }
-        else if (cByte == '>' &&
-                 nMatchCount <= 1)
-        {
-            //nMatchCount++;
+    AllocationScope aEventScope(AllocationStats::CATEGORY_EVENTS);
+    PushSlot(XMLEvent(std::unique_ptr<StartDocument>(new StartDocument)));
 
-            std::unique_ptr<ProcessingInstruction> pProcessingInstruction(new ProcessingInstruction(std::move(pTarget), std::move(pData)));
-            std::unique_ptr<XMLEvent> pEvent(new XMLEvent(nullptr,
-                                                          nullptr,
-                                                          nullptr,
-                                                          nullptr,
-                                                          std::move(pProcessingInstruction)));
-            m_aEvents.push(std::move(pEvent));
-
-            return true;
-        }
-        else
-        {
-            if (nMatchCount > 0)
-            {
-                pData->push_back('?');
-            }
-
-            nMatchCount = 0;
-
-            pData->push_back(cByte);
-        }
-    }
-
-    return false;
+    m_bDocumentOpen = true;
+    m_nDocumentDepth = 0;
 }
 
-bool XMLEventReader::HandleProcessingInstructionTarget(std::unique_ptr<std::string>& pTarget)
+void XMLEventReader::CloseDocument()
 {
-    std::unique_ptr<std::string> pName = nullptr;
-    char cByte('\0');
-    int nMatchCount = 0;
+    AllocationScope aEventScope(AllocationStats::CATEGORY_EVENTS);
+    PushSlot(XMLEvent(std::unique_ptr<EndDocument>(new EndDocument)));
 
-    while (nMatchCount < 2)
-    {
-        m_aStream.get(cByte);
-
-        if (m_aStream.eof() == true)
-        {
-            throw new std::runtime_error("Processing instruction target name incomplete.");
-        }
-
-        if (m_aStream.bad() == true)
-        {
-            throw new std::runtime_error("Stream is bad.");
-        }
-
-        if (cByte == '?' &&
-            nMatchCount <= 0)
-        {
-            nMatchCount++;
-        }
-        else if (cByte == '>' &&
-                 nMatchCount <= 1)
-        {
-            throw new std::runtime_error("Processing instruction ended before processing instruction target name could be read.");
-        }
-        else if (std::isspace(cByte, m_aLocale) != 0)
-        {
-            if (pName == nullptr)
-            {
-                throw new std::runtime_error("Processing instruction without target name.");
-            }
-
-            pTarget = std::move(pName);
-
-            return true;
-        }
-        else
-        {
-            if (nMatchCount > 0)
-            {
-                throw new std::runtime_error("Processing instruction target name interrupted by '?'.");
-            }
-
-            if (pName == nullptr)
-            {
-                if (std::isalpha(cByte, m_aLocale) != true)
-                {
-                    int nByte(cByte);
-                    std::stringstream aMessage;
-                    aMessage << "Character '" << cByte << "' (0x"
-                               << std::hex << std::uppercase << nByte << std::nouppercase << std::dec
-                               << ") not supported as first character of an processing instruction target name.";
-                    throw new std::runtime_error(aMessage.str());
-                }
-
-                pName = std::unique_ptr<std::string>(new std::string);
-            }
-
-            pName->push_back(cByte);
-        }
-    }
-
-    return false;
+    m_bDocumentOpen = false;
+    m_nDocumentDepth = 0;
 }
 
-bool XMLEventReader::HandleMarkupDeclaration()
+/**
+ * @brief For an element skipped in the input, the EndElement of which
+ *     wasn't pushed.
+ */
+void XMLEventReader::EndSkippedElement()
 {
-    char cByte = '\0';
-    m_aStream.get(cByte);
-
-    if (m_aStream.eof() == true)
+    if (m_bMultipleDocuments != true ||
+        m_nDocumentDepth <= 0)
     {
-        throw new std::runtime_error("Markup declaration incomplete.");
+        return;
     }
 
-    if (m_aStream.bad() == true)
-    {
-        throw new std::runtime_error("Steam is bad.");
-    }
+    --m_nDocumentDepth;
 
-    if (cByte == '-')
+    if (m_nDocumentDepth <= 0)
     {
-        return HandleComment();
+        m_aEventLocation = getLocation();
+        CloseDocument();
     }
-    else
-    {
-        throw new std::runtime_error("Markup declaration type not implemented yet.");
-    }
-
-    return true;
 }
 
-bool XMLEventReader::HandleComment()
+bool XMLEventReader::IsWhitespace(const std::string& strText)
 {
-    char cByte = '\0';
-    m_aStream.get(cByte);
-
-    if (m_aStream.eof() == true)
-    {
-        throw new std::runtime_error("Comment incomplete.");
-    }
-
-    if (m_aStream.bad() == true)
-    {
-        throw new std::runtime_error("Stream is bad.");
-    }
-
-    if (cByte != '-')
-    {
-        throw new std::runtime_error("Comment malformed.");
-    }
-
-    std::unique_ptr<std::string> pData(new std::string);
-
-    unsigned int nMatchCount = 0;
-    const unsigned int END_SEQUENCE_LENGTH = 3;
-    char cEndSequence[END_SEQUENCE_LENGTH] = { '-', '-', '>' };
+    return IsWhitespace(strText.data(), strText.length());
+}
 
-    do
+bool XMLEventReader::IsWhitespace(const char* pText, std::size_t nLength)
+{
+    for (std::size_t i = 0; i < nLength; i++)
     {
-        m_aStream.get(cByte);
-
-        if (m_aStream.eof() == true)
-        {
-            throw new std::runtime_error("Comment incomplete.");
-        }
-
-        if (m_aStream.bad() == true)
-        {
-            throw new std::runtime_error("Stream is bad.");
-        }
-
-        if (cByte == cEndSequence[nMatchCount])
+        if (std::isspace(pText[i], m_aLocale) == 0)
         {
-            if (nMatchCount + 1 < END_SEQUENCE_LENGTH)
-            {
-                ++nMatchCount;
-            }
-            else
-            {
-                std::unique_ptr<Comment> pComment(new Comment(std::move(pData)));
-                std::unique_ptr<XMLEvent> pEvent(new XMLEvent(nullptr,
-                                                              nullptr,
-                                                              nullptr,
-                                                              std::move(pComment),
-                                                              nullptr));
-                m_aEvents.push(std::move(pEvent));
-
-                break;
-            }
-        }
-        else
-        {
-            if (nMatchCount > 0)
-            {
-                // Instead of strncpy() and C-style char*.
-                for (unsigned int i = 0; i < nMatchCount; i++)
-                {
-                    pData->push_back(cEndSequence[i]);
-                }
-
-                pData->push_back(cByte);
-                nMatchCount = 0;
-            }
-            else
-            {
-                pData->push_back(cByte);
-            }
+            return false;
         }
-
-    } while (true);
+    }
 
     return true;
 }
 
-bool XMLEventReader::HandleAttributes(const char& cFirstByte, std::unique_ptr<std::list<std::unique_ptr<Attribute>>>& pAttributes)
+/**
+ * @brief The oldest pending event, there needs to be one.
+ */
+XMLEvent& XMLEventReader::FrontEvent()
 {
-    if (pAttributes == nullptr)
-    {
-        throw new std::invalid_argument("nullptr passed.");
-    }
-
-    std::unique_ptr<QName> pAttributeName(nullptr);
-    std::unique_ptr<std::string> pAttributeValue(nullptr);
+    return m_aEvents[m_nEventFirst];
+}
 
-    HandleAttributeName(cFirstByte, pAttributeName);
-    HandleAttributeValue(pAttributeValue);
+/**
+ * @brief Releases the slot of the oldest pending event for reuse.
+ */
+void XMLEventReader::PopEvent()
+{
+    m_nEventFirst = (m_nEventFirst + 1) & (EVENT_SLOTS - 1);
+    --m_nEventCount;
+}
 
-    pAttributes->push_back(std::unique_ptr<Attribute>(new Attribute(std::move(pAttributeName), std::move(pAttributeValue))));
+XMLEventReader::EventBuilder::EventBuilder(XMLEventReader& aReader):
+  m_aReader(aReader)
+{
 
-    char cByte('\0');
+}
 
-    do
+void XMLEventReader::EventBuilder::onStartElement(const XMLSpan& aPrefix, const XMLSpan& aLocalPart)
+{
     {
-        m_aStream.get(cByte);
-
-        if (m_aStream.eof() == true)
-        {
-            throw new std::runtime_error("Tag start incomplete.");
-        }
-
-        if (m_aStream.bad() == true)
-        {
-            throw new std::runtime_error("Stream is bad.");
-        }
-
-        if (cByte == '>')
-        {
-            // Not part of the attributes any more and indicator for outer
-            // methods to complete the StartElement.
-            m_aStream.unget();
-
-            break;
-        }
-        else if (cByte == '/')
-        {
-            m_aStream.get(cByte);
-
-            if (m_aStream.eof() == true)
-            {
-                throw new std::runtime_error("Tag start incomplete.");
-            }
-
-            if (m_aStream.bad() == true)
-            {
-                throw new std::runtime_error("Stream is bad.");
-            }
-
-            if (cByte != '>')
-            {
-                throw new std::runtime_error("Empty start + end tag end without closing '>'.");
-            }
-
-            m_aStream.unget();
-
-            if (m_aStream.bad() == true)
-            {
-                throw new std::runtime_error("Stream is bad.");
-            }
-
-            m_aStream.unget();
-
-            if (m_aStream.bad() == true)
-            {
-                throw new std::runtime_error("Stream is bad.");
-            }
-
-            break;
-        }
-        else if (std::isspace(cByte, m_aLocale) != 0)
-        {
-            // Ignore/consume.
-            continue;
-        }
-        else
-        {
-            HandleAttributeName(cByte, pAttributeName);
-            HandleAttributeValue(pAttributeValue);
+        AllocationScope aNameScope(AllocationStats::CATEGORY_NAMES);
+        m_aReader.m_pPendingName = std::make_shared<QName>("",
+                                                           std::string(aLocalPart.m_pData, aLocalPart.m_nLength),
+                                                           std::string(aPrefix.m_pData, aPrefix.m_nLength));
+    }
 
-            pAttributes->push_back(std::unique_ptr<Attribute>(new Attribute(std::move(pAttributeName), std::move(pAttributeValue))));
-        }
+    AllocationScope aAttributeScope(AllocationStats::CATEGORY_ATTRIBUTES);
+    m_aReader.m_pPendingAttributes.reset(new std::list<std::unique_ptr<Attribute>>);
+}
 
-    } while (true);
+void XMLEventReader::EventBuilder::onAttribute(const XMLSpan& aPrefix, const XMLSpan& aLocalPart, const XMLSpan& aValue)
+{
+    AllocationScope aAttributeScope(AllocationStats::CATEGORY_ATTRIBUTES);
+    std::unique_ptr<QName> pName(new QName("",
+                                           std::string(aLocalPart.m_pData, aLocalPart.m_nLength),
+                                           std::string(aPrefix.m_pData, aPrefix.m_nLength)));
+    std::unique_ptr<std::string> pValue(new std::string(aValue.m_pData, aValue.m_nLength));
 
-    return true;
+    m_aReader.m_pPendingAttributes->push_back(std::unique_ptr<Attribute>(new Attribute(std::move(pName), std::move(pValue))));
 }
 
-bool XMLEventReader::HandleAttributeName(const char& cFirstByte, std::unique_ptr<QName>& pName)
+/**
+ * @brief Of an empty element tag, the StartElement is still pending, and
+ *     the EndElement shares its QName.
+ */
+void XMLEventReader::EventBuilder::onEndElement(const XMLSpan& aPrefix, const XMLSpan& aLocalPart)
 {
-    std::unique_ptr<std::string> pNamePrefix(nullptr);
-    std::unique_ptr<std::string> pNameLocalPart(new std::string());
-
-    char cByte(cFirstByte);
+    std::shared_ptr<QName> pName(m_aReader.m_pPendingName);
 
-    if (cByte == ':')
-    {
-        pNamePrefix.reset(new std::string());
-    }
-    else if (std::isalnum(cByte, m_aLocale) == true ||
-             cByte == '_')
+    if (pName != nullptr)
     {
-        pNameLocalPart->push_back(cByte);
+        m_aReader.PushStartElement();
     }
     else
     {
-        int nByte(cByte);
-        std::stringstream aMessage;
-        aMessage << "Character '" << cByte << "' (0x"
-                 << std::hex << std::uppercase << nByte << std::nouppercase << std::dec
-                 << ") not supported as first character of an attribute name.";
-        throw new std::runtime_error(aMessage.str());
+        AllocationScope aNameScope(AllocationStats::CATEGORY_NAMES);
+        pName = std::make_shared<QName>("",
+                                        std::string(aLocalPart.m_pData, aLocalPart.m_nLength),
+                                        std::string(aPrefix.m_pData, aPrefix.m_nLength));
     }
 
-    do
-    {
-        m_aStream.get(cByte);
-
-        if (m_aStream.eof() == true)
-        {
-            throw new std::runtime_error("Attribute name incomplete.");
-        }
-
-        if (m_aStream.bad() == true)
-        {
-            throw new std::runtime_error("Stream is bad.");
-        }
-
-        if (cByte == ':')
-        {
-            if (pNamePrefix != nullptr)
-            {
-                throw new std::runtime_error("There can't be two prefixes in attribute name.");
-            }
-
-            pNamePrefix = std::move(pNameLocalPart);
-            pNameLocalPart.reset(new std::string());
-        }
-        else if (std::isspace(cByte, m_aLocale) != 0)
-        {
-            cByte = ConsumeWhitespace();
-
-            if (cByte == '\0')
-            {
-                throw new std::runtime_error("Attribute incomplete.");
-            }
-            else if (cByte != '=')
-            {
-                throw new std::runtime_error("Attribute name is malformed.");
-            }
-
-            // To make sure that the next loop iteration will end up in cByte == '='.
-            m_aStream.unget();
-
-            if (m_aStream.bad() == true)
-            {
-                throw new std::runtime_error("Stream is bad.");
-            }
-        }
-        else if (cByte == '=')
-        {
-            if (pNamePrefix == nullptr)
-            {
-                pNamePrefix.reset(new std::string);
-            }
-
-            pName = std::unique_ptr<QName>(new QName("", *pNameLocalPart, *pNamePrefix));
-
-            return true;
-        }
-        else if (std::isalnum(cByte, m_aLocale) == true ||
-                 cByte == '-' ||
-                 cByte == '_' ||
-                 cByte == '.')
-        {
-            pNameLocalPart->push_back(cByte);
-        }
-        else
-        {
-            int nByte(cByte);
-            std::stringstream aMessage;
-            aMessage << "Character '" << cByte << "' (0x"
-                     << std::hex << std::uppercase << nByte << std::nouppercase << std::dec
-                     << ") not supported in an attribute name.";
-            throw new std::runtime_error(aMessage.str());
-        }
-
-    } while (true);
-
-    return false;
+    AllocationScope aEventScope(AllocationStats::CATEGORY_EVENTS);
+    std::unique_ptr<EndElement> pEndElement(new EndElement(std::move(pName)));
+    m_aReader.PushEvent(XMLEvent(nullptr,
+                                 std::move(pEndElement),
+                                 nullptr,
+                                 nullptr,
+                                 nullptr));
 }
 
-bool XMLEventReader::HandleAttributeValue(std::unique_ptr<std::string>& pValue)
+void XMLEventReader::EventBuilder::onText(const XMLSpan& aText)
 {
-    pValue = std::unique_ptr<std::string>(new std::string);
-    char cDelimiter(ConsumeWhitespace());
-
-    if (cDelimiter == '\0')
-    {
-        throw new std::runtime_error("Attribute is missing its value.");
-    }
-    else if (cDelimiter != '\'' &&
-             cDelimiter != '"')
+    // Only text with entity references replaced isn't in the input, and
+    // that's never considered to be whitespace.
+    if (m_aReader.m_bIgnoreWhitespace == true &&
+        m_aReader.IsScannedInput(aText) == true &&
+        m_aReader.IsWhitespace(aText.m_pData, aText.m_nLength) == true)
     {
-        int nByte(cDelimiter);
-        std::stringstream aMessage;
-        aMessage << "Attribute value doesn't start with a delimiter like ''' or '\"', instead, '" << cDelimiter << "' (0x"
-                 << std::hex << std::uppercase << nByte << std::nouppercase << std::dec
-                 << ") was found.";
-        throw new std::runtime_error(aMessage.str());
+        return;
     }
 
-    char cByte('\0');
+    std::unique_ptr<std::string> pData(nullptr);
 
-    do
     {
-        m_aStream.get(cByte);
-
-        if (m_aStream.eof() == true)
-        {
-            throw new std::runtime_error("Attribute value incomplete.");
-        }
-
-        if (m_aStream.bad() == true)
-        {
-            throw new std::runtime_error("Stream is bad.");
-        }
-
-        if (cByte == cDelimiter)
-        {
-            return true;
-        }
-        else if (cByte == '&')
-        {
-            std::unique_ptr<std::string> pResolvedText = nullptr;
-
-            ResolveEntity(pResolvedText);
-            pValue->append(*pResolvedText);
-        }
-        else
-        {
-            pValue->push_back(cByte);
-        }
-
-    } while (true);
+        AllocationScope aTextScope(AllocationStats::CATEGORY_TEXT);
+        pData.reset(new std::string(aText.m_pData, aText.m_nLength));
+    }
 
-    return false;
+    AllocationScope aEventScope(AllocationStats::CATEGORY_EVENTS);
+    std::unique_ptr<Characters> pCharacters(new Characters(std::move(pData)));
+    m_aReader.PushEvent(XMLEvent(nullptr,
+                                 nullptr,
+                                 std::move(pCharacters),
+                                 nullptr,
+                                 nullptr));
 }
 
-void XMLEventReader::ResolveEntity(std::unique_ptr<std::string>& pResolvedText)
+void XMLEventReader::EventBuilder::onComment(const XMLSpan& aText)
 {
-    if (pResolvedText != nullptr)
+    if (m_aReader.m_bIgnoreComments == true)
     {
-        throw new std::invalid_argument("No nullptr passed.");
+        return;
     }
 
-    char cByte = '\0';
-    m_aStream.get(cByte);
+    std::unique_ptr<std::string> pData(nullptr);
 
-    if (m_aStream.eof() == true)
     {
-        throw new std::runtime_error("Entity incomplete.");
+        AllocationScope aTextScope(AllocationStats::CATEGORY_TEXT);
+        pData.reset(new std::string(aText.m_pData, aText.m_nLength));
     }
 
-    if (m_aStream.bad() == true)
-    {
-        throw new std::runtime_error("Stream is bad.");
-    }
+    AllocationScope aEventScope(AllocationStats::CATEGORY_EVENTS);
+    std::unique_ptr<Comment> pComment(new Comment(std::move(pData)));
+    m_aReader.PushEvent(XMLEvent(nullptr,
+                                 nullptr,
+                                 nullptr,
+                                 std::move(pComment),
+                                 nullptr));
+}
 
-    if (cByte == ';')
+void XMLEventReader::EventBuilder::onProcessingInstruction(const XMLSpan& aTarget, const XMLSpan& aData)
+{
+    if (m_aReader.m_bIgnoreProcessingInstructions == true)
     {
-        throw new std::runtime_error("Entity has no name.");
+        return;
     }
-    else
-    {
-        std::unique_ptr<std::string> pEntityName(new std::string);
-        pEntityName->push_back(cByte);
 
-        do
-        {
-            m_aStream.get(cByte);
+    std::unique_ptr<std::string> pTarget(nullptr);
+    std::unique_ptr<std::string> pData(nullptr);
 
-            if (m_aStream.eof() == true)
-            {
-                throw new std::runtime_error("Entity incomplete.");
-            }
-
-            if (m_aStream.bad() == true)
-            {
-                throw new std::runtime_error("Stream is bad.");
-            }
-
-            if (cByte == ';')
-            {
-                break;
-            }
-
-            pEntityName->push_back(cByte);
-
-        } while (true);
-
-        std::map<std::string, std::string>::iterator iter = m_aEntityReplacementDictionary.find(*pEntityName);
+    {
+        AllocationScope aNameScope(AllocationStats::CATEGORY_NAMES);
+        pTarget.reset(new std::string(aTarget.m_pData, aTarget.m_nLength));
+    }
 
-        if (iter != m_aEntityReplacementDictionary.end())
-        {
-            pResolvedText = std::unique_ptr<std::string>(new std::string(iter->second));
-        }
-        else
-        {
-            std::stringstream aMessage;
-            aMessage << "Unable to resolve entity '&" << *pEntityName << ";'.";
-            throw new std::runtime_error(aMessage.str());
-        }
+    {
+        AllocationScope aTextScope(AllocationStats::CATEGORY_TEXT);
+        pData.reset(new std::string(aData.m_pData, aData.m_nLength));
     }
+
+    AllocationScope aEventScope(AllocationStats::CATEGORY_EVENTS);
+    std::unique_ptr<ProcessingInstruction> pProcessingInstruction(new ProcessingInstruction(std::move(pTarget), std::move(pData)));
+    m_aReader.PushEvent(XMLEvent(nullptr,
+                                 nullptr,
+                                 nullptr,
+                                 nullptr,
+                                 std::move(pProcessingInstruction)));
 }
 
 /**
- * @retval Returns the first non-whitespace character or '\0' in
- *     case of end-of-file.
+ * @brief The XML declaration isn't reported, it only starts the next
+ *     document in multiple documents mode.
  */
-char XMLEventReader::ConsumeWhitespace()
+void XMLEventReader::EventBuilder::onXMLDeclaration()
 {
-    char cByte('\0');
-
-    do
+    if (m_aReader.m_bMultipleDocuments == true)
     {
-        m_aStream.get(cByte);
-
-        if (m_aStream.eof() == true)
-        {
-            return '\0';
-        }
-
-        if (m_aStream.bad() == true)
-        {
-            throw new std::runtime_error("Stream is bad.");
-        }
-
-        if (std::isspace(cByte, m_aLocale) == 0)
-        {
-            return cByte;
-        }
-
-    } while (true);
+        m_aReader.OpenDocument();
+    }
 }
 
 }
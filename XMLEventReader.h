@@ -24,54 +24,264 @@
 #define _CPPSTAX_XMLEVENTREADER_H
 
 #include "XMLEvent.h"
+#include "XMLStreamError.h"
 #include "Attribute.h"
+#include "QName.h"
+#include "Location.h"
+#include "XMLScanner.h"
+#include "XMLParserPolicy.h"
 #include <istream>
+#include <streambuf>
 #include <locale>
 #include <memory>
-#include <queue>
 #include <map>
+#include <vector>
+#include <list>
+#include <stdexcept>
+#include <cstddef>
 
 namespace cppstax
 {
 
+/**
+ * @brief Pulls events from an XMLScanner of XMLDefaultPolicy, which
+ *     reports each construct to an EventBuilder. Readers with a scanner
+ *     of another policy (see XMLStructuralEventReader and
+ *     XMLPolicyEventReader) drive it with ScanEvents() and
+ *     SkipScannedElement() the same way, so there's one grammar for all
+ *     of them.
+ */
 class XMLEventReader
 {
 public:
     XMLEventReader(std::istream& aStream);
-    ~XMLEventReader();
+    XMLEventReader(std::unique_ptr<std::streambuf> pBuffer);
+    virtual ~XMLEventReader();
 
-    bool hasNext();
-    std::unique_ptr<XMLEvent> nextEvent();
+    virtual bool hasNext();
+    virtual std::unique_ptr<XMLEvent> nextEvent();
+    virtual std::size_t nextEvents(std::vector<XMLEvent>& aEvents, std::size_t nMax);
+    virtual bool skipElement();
+    void reset(std::istream& aStream);
+    void reset(std::unique_ptr<std::streambuf> pBuffer);
+    virtual void restoreDefaults();
 
 public:
     int addToEntityReplacementDictionary(const std::string& strName, const std::string& strReplacementText);
 
+public:
+    void setIgnoreWhitespace(bool bIgnoreWhitespace);
+    void setIgnoreComments(bool bIgnoreComments);
+    void setIgnoreProcessingInstructions(bool bIgnoreProcessingInstructions);
+    void setMultipleDocuments(bool bMultipleDocuments);
+    virtual void setSourceRanges(bool bSourceRanges);
+    virtual void setLocationTracking(bool bLocationTracking);
+    virtual Location getLocation();
+    void setThrowOnError(bool bThrowOnError);
+    const XMLStreamError& getError() const;
+
+protected:
+    XMLEventReader(std::streambuf* pBuffer);
+
 protected:
-    bool HandleTag();
-    bool HandleTagStart(const char& cFirstByte);
-    bool HandleTagEnd();
-    bool HandleText(const char& cFirstByte);
-    bool HandleProcessingInstruction();
-    bool HandleProcessingInstructionTarget(std::unique_ptr<std::string>& pTarget);
-    bool HandleMarkupDeclaration();
-    bool HandleComment();
-    bool HandleAttributes(const char& cFirstByte, std::unique_ptr<std::list<std::unique_ptr<Attribute>>>& pAttributes);
-    bool HandleAttributeName(const char& cFirstByte, std::unique_ptr<QName>& pName);
-    bool HandleAttributeValue(std::unique_ptr<std::string>& pValue);
+    virtual bool ReadEvents();
+    virtual void Reset(std::streambuf* pBuffer);
+    virtual bool IsScannedInput(const XMLSpan& aSpan) const;
+
+protected:
+    /** Handler of the XMLScanner, pushes the events. */
+    class EventBuilder
+    {
+    public:
+        EventBuilder(XMLEventReader& aReader);
+
+    public:
+        void onStartElement(const XMLSpan& aPrefix, const XMLSpan& aLocalPart);
+        void onAttribute(const XMLSpan& aPrefix, const XMLSpan& aLocalPart, const XMLSpan& aValue);
+        void onEndElement(const XMLSpan& aPrefix, const XMLSpan& aLocalPart);
+        void onText(const XMLSpan& aText);
+        void onComment(const XMLSpan& aText);
+        void onProcessingInstruction(const XMLSpan& aTarget, const XMLSpan& aData);
+        void onXMLDeclaration();
+
+    protected:
+        XMLEventReader& m_aReader;
+
+    };
 
 protected:
-    void ResolveEntity(std::unique_ptr<std::string>& pResolvedText);
-    char ConsumeWhitespace();
+    template<class Scanner>
+    bool ScanEvents(Scanner& aScanner);
+    template<class Scanner>
+    bool SkipScannedElement(Scanner& aScanner);
+    void PushStartElement();
+    void PushEvent(XMLEvent&& aEvent);
+    void PushSlot(XMLEvent&& aEvent);
+    void SetSourceRanges(std::size_t nFirst, std::size_t nBegin, std::size_t nEnd);
+    void OpenDocument();
+    void CloseDocument();
+    void EndSkippedElement();
+    bool IsWhitespace(const std::string& strText);
+    bool IsWhitespace(const char* pText, std::size_t nLength);
+    XMLEvent& FrontEvent();
+    void PopEvent();
+    bool Fail(XMLStreamError::Code eCode);
+    bool Fail(const XMLStreamError& aError);
 
 protected:
-    std::istream& m_aStream;
+    std::istream m_aStream;
+    std::unique_ptr<std::streambuf> m_pOwnedBuffer;
+    EventBuilder m_aBuilder;
+    XMLScanner<XMLDefaultPolicy, EventBuilder> m_aScanner;
+    /** Of the StartElement the attributes are reported for, pushed after
+      * the start tag. */
+    std::shared_ptr<QName> m_pPendingName;
+    std::unique_ptr<std::list<std::unique_ptr<Attribute>>> m_pPendingAttributes;
+    bool m_bLocationTracking;
+    Location m_aEventLocation;
+    bool m_bStarted;
     std::locale m_aLocale;
     bool m_bHasNextCalled;
-    std::queue<std::unique_ptr<XMLEvent>> m_aEvents;
+    bool m_bStartElementReturned;
+    /** Ring of event slots, the events pending are m_nEventCount from
+      * m_nEventFirst on. */
+    std::vector<XMLEvent> m_aEvents;
+    std::size_t m_nEventFirst;
+    std::size_t m_nEventCount;
     std::map<std::string, std::string> m_aEntityReplacementDictionary;
+    bool m_bIgnoreWhitespace;
+    bool m_bIgnoreComments;
+    bool m_bIgnoreProcessingInstructions;
+    bool m_bMultipleDocuments;
+    /** If a StartDocument was reported without its EndDocument yet. */
+    bool m_bDocumentOpen;
+    /** Depth of the elements reported in the open document. */
+    unsigned int m_nDocumentDepth;
+    bool m_bSourceRanges;
+    bool m_bThrowOnError;
+    XMLStreamError m_aError;
 
 };
 
+/**
+ * @brief XMLEventReader::ReadEvents() with aScanner, which gets the
+ *     stream as its source when reading starts.
+ */
+template<class Scanner>
+bool XMLEventReader::ScanEvents(Scanner& aScanner)
+{
+    if (m_bStarted != true)
+    {
+        m_bStarted = true;
+
+        if (m_aStream.rdbuf() == nullptr)
+        {
+            return Fail(XMLStreamError::ERROR_STREAM_BAD);
+        }
+
+        aScanner.setSource(m_aStream.rdbuf());
+    }
+
+    if (m_aError.getCode() != XMLStreamError::ERROR_NONE)
+    {
+        return false;
+    }
+
+    do
+    {
+        if (m_bLocationTracking == true)
+        {
+            m_aEventLocation = aScanner.getLocation();
+        }
+
+        std::size_t nFirst = m_nEventCount;
+        std::size_t nBegin = aScanner.getPosition();
+
+        if (aScanner.scanConstruct() != true)
+        {
+            if (aScanner.getError().getCode() != XMLStreamError::ERROR_NONE)
+            {
+                m_pPendingName.reset();
+                m_pPendingAttributes.reset();
+
+                return Fail(aScanner.getError());
+            }
+
+            if (m_bDocumentOpen == true)
+            {
+                CloseDocument();
+                return true;
+            }
+
+            return false;
+        }
+
+        if (m_pPendingName != nullptr)
+        {
+            PushStartElement();
+        }
+
+        if (m_bSourceRanges == true)
+        {
+            SetSourceRanges(nFirst, nBegin, aScanner.getPosition());
+        }
+
+    } while (m_nEventCount <= 0);
+
+    return true;
+}
+
+/**
+ * @brief XMLEventReader::skipElement() with aScanner.
+ */
+template<class Scanner>
+bool XMLEventReader::SkipScannedElement(Scanner& aScanner)
+{
+    if (m_bStartElementReturned != true)
+    {
+        throw new std::logic_error("Attempted XMLEventReader::skipElement() without XMLEventReader::nextEvent() having returned a StartElement.");
+    }
+
+    m_bStartElementReturned = false;
+    m_bHasNextCalled = false;
+
+    unsigned int nDepth = 1;
+
+    // Events already read ahead are part of the subtree.
+    while (m_nEventCount > 0)
+    {
+        if (FrontEvent().isStartElement() == true)
+        {
+            ++nDepth;
+        }
+        else if (FrontEvent().isEndElement() == true)
+        {
+            --nDepth;
+        }
+
+        PopEvent();
+
+        if (nDepth <= 0)
+        {
+            return true;
+        }
+    }
+
+    if (m_aError.getCode() != XMLStreamError::ERROR_NONE)
+    {
+        return false;
+    }
+
+    if (aScanner.skipElement(nDepth) != true)
+    {
+        return Fail(aScanner.getError());
+    }
+
+    EndSkippedElement();
+
+    return true;
+}
+
 }
 
 #endif
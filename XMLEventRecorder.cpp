@@ -0,0 +1,265 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLEventRecorder.cpp
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#include "XMLEventRecorder.h"
+#include <stdexcept>
+#include <cstring>
+
+namespace cppstax
+{
+
+namespace
+{
+
+const std::size_t BUFFER_SIZE = 65536;
+
+}
+
+const char XMLEventRecorder::HEADER[8] = { 'C', 'p', 'p', 'S', 't', 'A', 'X', 1 };
+
+XMLEventRecorder::XMLEventRecorder(std::ostream& aStream):
+  XMLEventRecorder(aStream.rdbuf())
+{
+
+}
+
+/**
+ * @brief Writes to pBuffer, which will be destroyed together
+ *     with the recorder.
+ */
+XMLEventRecorder::XMLEventRecorder(std::unique_ptr<std::streambuf> pBuffer):
+  XMLEventRecorder(pBuffer.get())
+{
+    m_pOwnedBuffer = std::move(pBuffer);
+}
+
+XMLEventRecorder::XMLEventRecorder(std::streambuf* pBuffer):
+  m_pTarget(pBuffer),
+  m_pOwnedBuffer(nullptr),
+  m_aBuffer(BUFFER_SIZE),
+  m_nPosition(0)
+{
+    if (m_pTarget == nullptr)
+    {
+        throw new std::invalid_argument("Nullptr passed.");
+    }
+
+    Write(HEADER, sizeof(HEADER));
+}
+
+/**
+ * @details Output still buffered gets written, errors doing so are lost.
+ *     Call XMLEventRecorder::flush() before to get them.
+ */
+XMLEventRecorder::~XMLEventRecorder()
+{
+    try
+    {
+        Flush();
+    }
+    catch (std::exception* pException)
+    {
+        delete pException;
+    }
+}
+
+void XMLEventRecorder::add(XMLEvent& aEvent)
+{
+    if (aEvent.isStartElement() == true)
+    {
+        StartElement& aStartElement = aEvent.asStartElement();
+        const std::shared_ptr<std::list<std::shared_ptr<Attribute>>> pAttributes = aStartElement.getAttributes();
+
+        // Names get defined in front of the record which refers to them.
+        std::size_t nNameID = InternName(aStartElement.getName());
+
+        m_aAttributeNameIDs.clear();
+
+        for (std::list<std::shared_ptr<Attribute>>::const_iterator iter = pAttributes->begin();
+             iter != pAttributes->end();
+             iter++)
+        {
+            m_aAttributeNameIDs.push_back(InternName((*iter)->getName()));
+        }
+
+        Write(static_cast<char>(RECORD_START_ELEMENT));
+        WriteNumber(nNameID);
+        WriteNumber(m_aAttributeNameIDs.size());
+
+        std::size_t nAttribute = 0;
+
+        for (std::list<std::shared_ptr<Attribute>>::const_iterator iter = pAttributes->begin();
+             iter != pAttributes->end();
+             iter++)
+        {
+            WriteNumber(m_aAttributeNameIDs[nAttribute]);
+            WriteString((*iter)->getValue());
+            ++nAttribute;
+        }
+    }
+    else if (aEvent.isEndElement() == true)
+    {
+        std::size_t nNameID = InternName(aEvent.asEndElement().getName());
+
+        Write(static_cast<char>(RECORD_END_ELEMENT));
+        WriteNumber(nNameID);
+    }
+    else if (aEvent.isCharacters() == true)
+    {
+        Write(static_cast<char>(RECORD_CHARACTERS));
+        WriteString(aEvent.asCharacters().getData());
+    }
+    else if (aEvent.isComment() == true)
+    {
+        Write(static_cast<char>(RECORD_COMMENT));
+        WriteString(aEvent.asComment().getText());
+    }
+    else if (aEvent.isProcessingInstruction() == true)
+    {
+        ProcessingInstruction& aProcessingInstruction = aEvent.asProcessingInstruction();
+
+        Write(static_cast<char>(RECORD_PROCESSING_INSTRUCTION));
+        WriteString(aProcessingInstruction.getTarget());
+        WriteString(aProcessingInstruction.getData());
+    }
+    else if (aEvent.isStartDocument() == true)
+    {
+        Write(static_cast<char>(RECORD_START_DOCUMENT));
+    }
+    else if (aEvent.isEndDocument() == true)
+    {
+        Write(static_cast<char>(RECORD_END_DOCUMENT));
+    }
+}
+
+/**
+ * @brief Hands all output so far to the stream buffer and synchronizes it.
+ */
+void XMLEventRecorder::flush()
+{
+    Flush();
+
+    if (m_pTarget->pubsync() != 0)
+    {
+        throw new std::runtime_error("Couldn't write to the output stream.");
+    }
+}
+
+/**
+ * @brief ID of aName, writes a RECORD_NAME if it's new.
+ */
+std::size_t XMLEventRecorder::InternName(const QName& aName)
+{
+    m_strNameKey.assign(aName.getNamespaceURI());
+    m_strNameKey.push_back('\0');
+    m_strNameKey.append(aName.getLocalPart());
+    m_strNameKey.push_back('\0');
+    m_strNameKey.append(aName.getPrefix());
+
+    std::unordered_map<std::string, std::size_t>::const_iterator iter = m_aNameIDs.find(m_strNameKey);
+
+    if (iter != m_aNameIDs.end())
+    {
+        return iter->second;
+    }
+
+    std::size_t nNameID = m_aNameIDs.size();
+    m_aNameIDs.insert(std::pair<std::string, std::size_t>(m_strNameKey, nNameID));
+
+    Write(static_cast<char>(RECORD_NAME));
+    WriteString(aName.getNamespaceURI());
+    WriteString(aName.getLocalPart());
+    WriteString(aName.getPrefix());
+
+    return nNameID;
+}
+
+void XMLEventRecorder::WriteNumber(std::size_t nNumber)
+{
+    while (nNumber >= 0x80)
+    {
+        Write(static_cast<char>((nNumber & 0x7F) | 0x80));
+        nNumber >>= 7;
+    }
+
+    Write(static_cast<char>(nNumber));
+}
+
+void XMLEventRecorder::WriteString(const std::string& strText)
+{
+    WriteNumber(strText.length());
+    Write(strText.data(), strText.length());
+}
+
+/**
+ * @brief Runs which don't fit into the buffer any more are passed on
+ *     without copying them into it.
+ */
+void XMLEventRecorder::Write(const char* pData, std::size_t nLength)
+{
+    if (nLength > m_aBuffer.size() - m_nPosition)
+    {
+        Flush();
+
+        if (nLength >= m_aBuffer.size())
+        {
+            if (m_pTarget->sputn(pData, nLength) != static_cast<std::streamsize>(nLength))
+            {
+                throw new std::runtime_error("Couldn't write to the output stream.");
+            }
+
+            return;
+        }
+    }
+
+    std::memcpy(&m_aBuffer[0] + m_nPosition, pData, nLength);
+    m_nPosition += nLength;
+}
+
+void XMLEventRecorder::Write(char cByte)
+{
+    if (m_nPosition >= m_aBuffer.size())
+    {
+        Flush();
+    }
+
+    m_aBuffer[m_nPosition] = cByte;
+    ++m_nPosition;
+}
+
+void XMLEventRecorder::Flush()
+{
+    if (m_nPosition <= 0)
+    {
+        return;
+    }
+
+    std::streamsize nLength = m_nPosition;
+    m_nPosition = 0;
+
+    if (m_pTarget->sputn(&m_aBuffer[0], nLength) != nLength)
+    {
+        throw new std::runtime_error("Couldn't write to the output stream.");
+    }
+}
+
+}
@@ -0,0 +1,109 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLEventRecorder.h
+ * @brief Records XMLEvents in a compact binary format, which
+ *     XMLReplayEventReader reads back as the same events.
+ * @details The recording starts with XMLEventRecorder::HEADER, followed by
+ *     records which each start with a RecordType byte. Numbers are
+ *     written as unsigned varints (7 bits per byte, least significant
+ *     first, the high bit set on all but the last byte), strings as their
+ *     length followed by their bytes. Names are interned: a RECORD_NAME
+ *     with the namespace URI, local part and prefix defines the next name
+ *     ID (counting from 0) the first time a name comes up, element and
+ *     attribute names are written as ID from then on. The payload is:
+ *     - RECORD_START_ELEMENT: name ID, attribute count, then name ID and
+ *       value of each attribute.
+ *     - RECORD_END_ELEMENT: name ID.
+ *     - RECORD_CHARACTERS, RECORD_COMMENT: the text.
+ *     - RECORD_PROCESSING_INSTRUCTION: target and data.
+ *     - RECORD_START_DOCUMENT, RECORD_END_DOCUMENT: none.
+ *     Locations and source ranges of the events aren't recorded.
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#ifndef _CPPSTAX_XMLEVENTRECORDER_H
+#define _CPPSTAX_XMLEVENTRECORDER_H
+
+#include "XMLEvent.h"
+#include <ostream>
+#include <streambuf>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstddef>
+
+namespace cppstax
+{
+
+class XMLEventRecorder
+{
+public:
+    enum RecordType
+    {
+        RECORD_NAME = 1,
+        RECORD_START_ELEMENT,
+        RECORD_END_ELEMENT,
+        RECORD_CHARACTERS,
+        RECORD_COMMENT,
+        RECORD_PROCESSING_INSTRUCTION,
+        RECORD_START_DOCUMENT,
+        RECORD_END_DOCUMENT
+    };
+
+    /** @brief "CppStAX" and the format version. */
+    static const char HEADER[8];
+
+public:
+    XMLEventRecorder(std::ostream& aStream);
+    XMLEventRecorder(std::unique_ptr<std::streambuf> pBuffer);
+    ~XMLEventRecorder();
+
+public:
+    void add(XMLEvent& aEvent);
+    void flush();
+
+protected:
+    XMLEventRecorder(std::streambuf* pBuffer);
+
+protected:
+    std::size_t InternName(const QName& aName);
+    void WriteNumber(std::size_t nNumber);
+    void WriteString(const std::string& strText);
+    void Write(const char* pData, std::size_t nLength);
+    void Write(char cByte);
+    void Flush();
+
+protected:
+    std::streambuf* m_pTarget;
+    std::unique_ptr<std::streambuf> m_pOwnedBuffer;
+    std::vector<char> m_aBuffer;
+    /** End of the output collected in m_aBuffer. */
+    std::size_t m_nPosition;
+    /** Name IDs by namespace URI, local part and prefix, separated
+      * by '\0'. */
+    std::unordered_map<std::string, std::size_t> m_aNameIDs;
+    std::string m_strNameKey;
+    std::vector<std::size_t> m_aAttributeNameIDs;
+
+};
+
+}
+
+#endif
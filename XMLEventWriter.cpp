@@ -0,0 +1,506 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLEventWriter.cpp
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#include "XMLEventWriter.h"
+#include <stdexcept>
+#include <cstring>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace cppstax
+{
+
+namespace
+{
+
+const std::size_t BUFFER_SIZE = 65536;
+const char XML_DECLARATION[] = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>";
+
+/**
+ * @retval Position of the first '&', '<' or cDelimiter in the nLength
+ *     bytes at pData, or nLength if there's none. For attribute values
+ *     (cDelimiter '"') also of the first '\t', '\n' or '\r', which
+ *     attribute-value normalization would otherwise turn into spaces.
+ */
+std::size_t FindEscape(const char* pData, std::size_t nLength, char cDelimiter)
+{
+    const bool bAttribute = cDelimiter == '"';
+    std::size_t nPosition = 0;
+
+#if defined(__SSE2__)
+    const __m128i aAmpersand = _mm_set1_epi8('&');
+    const __m128i aLessThan = _mm_set1_epi8('<');
+    const __m128i aDelimiter = _mm_set1_epi8(cDelimiter);
+    const __m128i aTab = _mm_set1_epi8('\t');
+    const __m128i aLineFeed = _mm_set1_epi8('\n');
+    const __m128i aCarriageReturn = _mm_set1_epi8('\r');
+
+    while (nLength - nPosition >= 16)
+    {
+        __m128i aBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + nPosition));
+        __m128i aMatches = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(aBlock, aAmpersand),
+                                                     _mm_cmpeq_epi8(aBlock, aLessThan)),
+                                        _mm_cmpeq_epi8(aBlock, aDelimiter));
+
+        if (bAttribute == true)
+        {
+            aMatches = _mm_or_si128(aMatches,
+                                    _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(aBlock, aTab),
+                                                              _mm_cmpeq_epi8(aBlock, aLineFeed)),
+                                                 _mm_cmpeq_epi8(aBlock, aCarriageReturn)));
+        }
+
+        unsigned int nMask = _mm_movemask_epi8(aMatches);
+
+        if (nMask != 0)
+        {
+            return nPosition + __builtin_ctz(nMask);
+        }
+
+        nPosition += 16;
+    }
+#endif
+
+    for (; nPosition < nLength; nPosition++)
+    {
+        if (pData[nPosition] == '&' ||
+            pData[nPosition] == '<' ||
+            pData[nPosition] == cDelimiter)
+        {
+            break;
+        }
+
+        if (bAttribute == true &&
+            (pData[nPosition] == '\t' ||
+             pData[nPosition] == '\n' ||
+             pData[nPosition] == '\r'))
+        {
+            break;
+        }
+    }
+
+    return nPosition;
+}
+
+}
+
+XMLEventWriter::XMLEventWriter(std::ostream& aStream):
+  XMLEventWriter(aStream.rdbuf())
+{
+
+}
+
+/**
+ * @brief Writes to pBuffer, which will be destroyed together
+ *     with the writer.
+ */
+XMLEventWriter::XMLEventWriter(std::unique_ptr<std::streambuf> pBuffer):
+  XMLEventWriter(pBuffer.get())
+{
+    m_pOwnedBuffer = std::move(pBuffer);
+}
+
+XMLEventWriter::XMLEventWriter(std::streambuf* pBuffer):
+  m_pTarget(pBuffer),
+  m_pOwnedBuffer(nullptr),
+  m_aBuffer(BUFFER_SIZE),
+  m_nPosition(0),
+  m_bStartTagOpen(false),
+  m_pSource(nullptr),
+  m_nSourceLength(0),
+  m_nSourceBegin(0),
+  m_nSourceEnd(0),
+  m_bEmptyElementCopied(false)
+{
+    if (m_pTarget == nullptr)
+    {
+        throw new std::invalid_argument("Nullptr passed.");
+    }
+}
+
+/**
+ * @details Output still buffered gets written, errors doing so are lost.
+ *     Call XMLEventWriter::flush() before to get them.
+ */
+XMLEventWriter::~XMLEventWriter()
+{
+    try
+    {
+        WritePending();
+        Flush();
+    }
+    catch (std::exception* pException)
+    {
+        delete pException;
+    }
+}
+
+/**
+ * @brief Input the events passed to XMLEventWriter::add() were read from
+ *     with XMLEventReader::setSourceRanges(). Events which carry a source
+ *     range get copied from it unchanged, events constructed otherwise
+ *     are written from their content.
+ * @param[in] pData Needs to stay valid while the writer is in use,
+ *     nullptr to write all events from their content.
+ * @details The EndElement of an empty-element tag has an empty range.
+ *     It completes the tag if the StartElement was written from its
+ *     content, and isn't written at all after the tag was copied.
+ */
+void XMLEventWriter::setSource(const char* pData, std::size_t nLength)
+{
+    WritePending();
+
+    m_pSource = pData;
+    m_nSourceLength = nLength;
+    m_nSourceBegin = 0;
+    m_nSourceEnd = 0;
+    m_bEmptyElementCopied = false;
+}
+
+/**
+ * @brief Writes aEvent. An EndDocument doesn't write anything.
+ */
+void XMLEventWriter::add(XMLEvent& aEvent)
+{
+    if (m_pSource != nullptr &&
+        aEvent.hasSourceRange() == true)
+    {
+        if (aEvent.isEndElement() != true ||
+            aEvent.getSourceLength() > 0 ||
+            m_bStartTagOpen != true)
+        {
+            CopySource(aEvent.getSourceOffset(), aEvent.getSourceLength());
+
+            m_bEmptyElementCopied = aEvent.isStartElement() == true &&
+                                    aEvent.getSourceLength() >= 2 &&
+                                    m_pSource[aEvent.getSourceOffset() + aEvent.getSourceLength() - 2] == '/';
+            return;
+        }
+    }
+
+    if (m_bEmptyElementCopied == true)
+    {
+        m_bEmptyElementCopied = false;
+
+        if (aEvent.isEndElement() == true)
+        {
+            return;
+        }
+    }
+
+    if (aEvent.isStartElement() == true)
+    {
+        writeStartElement(aEvent.asStartElement());
+    }
+    else if (aEvent.isEndElement() == true)
+    {
+        writeEndElement(aEvent.asEndElement());
+    }
+    else if (aEvent.isCharacters() == true)
+    {
+        writeCharacters(aEvent.asCharacters().getData());
+    }
+    else if (aEvent.isComment() == true)
+    {
+        writeComment(aEvent.asComment().getText());
+    }
+    else if (aEvent.isProcessingInstruction() == true)
+    {
+        ProcessingInstruction& aProcessingInstruction = aEvent.asProcessingInstruction();
+        writeProcessingInstruction(aProcessingInstruction.getTarget(), aProcessingInstruction.getData());
+    }
+    else if (aEvent.isStartDocument() == true)
+    {
+        writeStartDocument();
+    }
+}
+
+void XMLEventWriter::writeStartDocument()
+{
+    WritePending();
+    Write(XML_DECLARATION, sizeof(XML_DECLARATION) - 1);
+}
+
+/**
+ * @brief The '>' gets written with the next output, which makes it "/>"
+ *     if that's the matching end tag.
+ */
+void XMLEventWriter::writeStartElement(const StartElement& aStartElement)
+{
+    WritePending();
+
+    const QName& aName = aStartElement.getName();
+
+    Write('<');
+    WriteName(aName);
+
+    m_strStartTagPrefix.assign(aName.getPrefix());
+    m_strStartTagLocalPart.assign(aName.getLocalPart());
+
+    const std::shared_ptr<std::list<std::shared_ptr<Attribute>>> pAttributes = aStartElement.getAttributes();
+
+    for (std::list<std::shared_ptr<Attribute>>::const_iterator iter = pAttributes->begin();
+         iter != pAttributes->end();
+         iter++)
+    {
+        Write(' ');
+        WriteName((*iter)->getName());
+        Write("=\"", 2);
+        WriteEscaped((*iter)->getValue(), '"');
+        Write('"');
+    }
+
+    m_bStartTagOpen = true;
+}
+
+void XMLEventWriter::writeEndElement(const EndElement& aEndElement)
+{
+    const QName& aName = aEndElement.getName();
+
+    if (m_bStartTagOpen == true &&
+        aName.getLocalPart() == m_strStartTagLocalPart &&
+        aName.getPrefix() == m_strStartTagPrefix)
+    {
+        m_bStartTagOpen = false;
+        Write("/>", 2);
+        return;
+    }
+
+    WritePending();
+    Write("</", 2);
+    WriteName(aName);
+    Write('>');
+}
+
+void XMLEventWriter::writeCharacters(const std::string& strText)
+{
+    WritePending();
+    WriteEscaped(strText, '>');
+}
+
+/**
+ * @param[in] strText Is written as is, it can't contain "--".
+ */
+void XMLEventWriter::writeComment(const std::string& strText)
+{
+    WritePending();
+    Write("<!--", 4);
+    Write(strText.data(), strText.length());
+    Write("-->", 3);
+}
+
+/**
+ * @param[in] strData Is written as is, it can't contain "?>".
+ */
+void XMLEventWriter::writeProcessingInstruction(const std::string& strTarget, const std::string& strData)
+{
+    WritePending();
+    Write("<?", 2);
+    Write(strTarget.data(), strTarget.length());
+
+    if (strData.empty() != true)
+    {
+        Write(' ');
+        Write(strData.data(), strData.length());
+    }
+
+    Write("?>", 2);
+}
+
+/**
+ * @brief Hands all output so far to the stream buffer and synchronizes it.
+ */
+void XMLEventWriter::flush()
+{
+    WritePending();
+    Flush();
+
+    if (m_pTarget->pubsync() != 0)
+    {
+        throw new std::runtime_error("Couldn't write to the output stream.");
+    }
+}
+
+void XMLEventWriter::CopySource(std::streamoff nOffset, std::streamoff nLength)
+{
+    if (nOffset < 0 ||
+        nLength < 0 ||
+        static_cast<std::size_t>(nOffset) > m_nSourceLength ||
+        static_cast<std::size_t>(nLength) > m_nSourceLength - nOffset)
+    {
+        throw new std::invalid_argument("Source range of the event is outside of the source.");
+    }
+
+    if (m_bStartTagOpen == true)
+    {
+        m_bStartTagOpen = false;
+        Write('>');
+    }
+
+    if (static_cast<std::size_t>(nOffset) != m_nSourceEnd)
+    {
+        WritePending();
+
+        m_nSourceBegin = nOffset;
+        m_nSourceEnd = nOffset;
+    }
+
+    m_nSourceEnd += nLength;
+}
+
+/**
+ * @brief Writes what's held back for the next output: the source range
+ *     to be copied or the '>' of the last start tag.
+ */
+void XMLEventWriter::WritePending()
+{
+    if (m_nSourceEnd > m_nSourceBegin)
+    {
+        Write(m_pSource + m_nSourceBegin, m_nSourceEnd - m_nSourceBegin);
+        m_nSourceBegin = m_nSourceEnd;
+    }
+
+    if (m_bStartTagOpen == true)
+    {
+        m_bStartTagOpen = false;
+        Write('>');
+    }
+}
+
+void XMLEventWriter::WriteName(const QName& aName)
+{
+    const std::string& strPrefix = aName.getPrefix();
+
+    if (strPrefix.empty() != true)
+    {
+        Write(strPrefix.data(), strPrefix.length());
+        Write(':');
+    }
+
+    Write(aName.getLocalPart().data(), aName.getLocalPart().length());
+}
+
+/**
+ * @brief Escapes '&', '<' and cDelimiter, which is '>' for text (so "]]>"
+ *     can't come up) or '"' for attribute values. In attribute values,
+ *     '\t', '\n' and '\r' are written as character references.
+ */
+void XMLEventWriter::WriteEscaped(const std::string& strText, char cDelimiter)
+{
+    const char* pData = strText.data();
+    std::size_t nLength = strText.length();
+
+    while (nLength > 0)
+    {
+        std::size_t nClean = FindEscape(pData, nLength, cDelimiter);
+
+        Write(pData, nClean);
+
+        if (nClean >= nLength)
+        {
+            break;
+        }
+
+        switch (pData[nClean])
+        {
+        case '&':
+            Write("&amp;", 5);
+            break;
+        case '<':
+            Write("&lt;", 4);
+            break;
+        case '>':
+            Write("&gt;", 4);
+            break;
+        case '"':
+            Write("&quot;", 6);
+            break;
+        case '\t':
+            Write("&#9;", 4);
+            break;
+        case '\n':
+            Write("&#10;", 5);
+            break;
+        case '\r':
+            Write("&#13;", 5);
+            break;
+        }
+
+        pData += nClean + 1;
+        nLength -= nClean + 1;
+    }
+}
+
+/**
+ * @brief Runs which don't fit into the buffer any more are passed on
+ *     without copying them into it.
+ */
+void XMLEventWriter::Write(const char* pData, std::size_t nLength)
+{
+    if (nLength > m_aBuffer.size() - m_nPosition)
+    {
+        Flush();
+
+        if (nLength >= m_aBuffer.size())
+        {
+            if (m_pTarget->sputn(pData, nLength) != static_cast<std::streamsize>(nLength))
+            {
+                throw new std::runtime_error("Couldn't write to the output stream.");
+            }
+
+            return;
+        }
+    }
+
+    std::memcpy(&m_aBuffer[0] + m_nPosition, pData, nLength);
+    m_nPosition += nLength;
+}
+
+void XMLEventWriter::Write(char cByte)
+{
+    if (m_nPosition >= m_aBuffer.size())
+    {
+        Flush();
+    }
+
+    m_aBuffer[m_nPosition] = cByte;
+    ++m_nPosition;
+}
+
+void XMLEventWriter::Flush()
+{
+    if (m_nPosition <= 0)
+    {
+        return;
+    }
+
+    std::streamsize nLength = m_nPosition;
+    m_nPosition = 0;
+
+    if (m_pTarget->sputn(&m_aBuffer[0], nLength) != nLength)
+    {
+        throw new std::runtime_error("Couldn't write to the output stream.");
+    }
+}
+
+}
@@ -0,0 +1,103 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLEventWriter.h
+ * @brief Writes XMLEvents as XML.
+ * @details Output is collected in a large buffer which is handed to the
+ *     stream buffer as a whole when full. Text and attribute values are
+ *     searched for bytes which need escaping 16 at a time where SSE2 is
+ *     available, the runs in between get copied unchanged. A start tag
+ *     directly followed by its end tag is written as empty-element tag.
+ *     With the input at hand (see XMLEventWriter::setSource()), events
+ *     which carry their source range get copied from it instead; ranges
+ *     which follow each other are copied in one go, so untouched regions
+ *     get passed through as a whole.
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#ifndef _CPPSTAX_XMLEVENTWRITER_H
+#define _CPPSTAX_XMLEVENTWRITER_H
+
+#include "XMLEvent.h"
+#include <ostream>
+#include <streambuf>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace cppstax
+{
+
+class XMLEventWriter
+{
+public:
+    XMLEventWriter(std::ostream& aStream);
+    XMLEventWriter(std::unique_ptr<std::streambuf> pBuffer);
+    ~XMLEventWriter();
+
+public:
+    void setSource(const char* pData, std::size_t nLength);
+    void add(XMLEvent& aEvent);
+    void writeStartDocument();
+    void writeStartElement(const StartElement& aStartElement);
+    void writeEndElement(const EndElement& aEndElement);
+    void writeCharacters(const std::string& strText);
+    void writeComment(const std::string& strText);
+    void writeProcessingInstruction(const std::string& strTarget, const std::string& strData);
+    void flush();
+
+protected:
+    XMLEventWriter(std::streambuf* pBuffer);
+
+protected:
+    void CopySource(std::streamoff nOffset, std::streamoff nLength);
+    void WritePending();
+    void WriteName(const QName& aName);
+    void WriteEscaped(const std::string& strText, char cDelimiter);
+    void Write(const char* pData, std::size_t nLength);
+    void Write(char cByte);
+    void Flush();
+
+protected:
+    std::streambuf* m_pTarget;
+    std::unique_ptr<std::streambuf> m_pOwnedBuffer;
+    std::vector<char> m_aBuffer;
+    /** End of the output collected in m_aBuffer. */
+    std::size_t m_nPosition;
+    /** If the '>' of the last start tag wasn't written yet. */
+    bool m_bStartTagOpen;
+    /** Name of the last start tag, an end tag only completes it as
+      * empty-element tag if it's the same. */
+    std::string m_strStartTagPrefix;
+    std::string m_strStartTagLocalPart;
+    const char* m_pSource;
+    std::size_t m_nSourceLength;
+    /** Range of m_pSource to be copied, which gets extended as long as
+      * the source ranges of the events follow each other. */
+    std::size_t m_nSourceBegin;
+    std::size_t m_nSourceEnd;
+    /** If the last event was a StartElement copied as empty-element tag,
+      * which its EndElement must not be written after. */
+    bool m_bEmptyElementCopied;
+
+};
+
+}
+
+#endif
@@ -0,0 +1,329 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLIndex.cpp
+ * @details Index file layout, all numbers little endian: "CPPSTAXI",
+ *     version (4 bytes), name count (4 bytes), per name its length
+ *     (4 bytes) and bytes, entry count (8 bytes), per entry start and
+ *     end offset (8 bytes each), depth and name ID (4 bytes each).
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#include "XMLIndex.h"
+#include "RangeStreamBuffer.h"
+#include "XMLStreamException.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace cppstax
+{
+
+namespace
+{
+
+const char INDEX_MAGIC[8] = { 'C', 'P', 'P', 'S', 'T', 'A', 'X', 'I' };
+const unsigned int INDEX_VERSION = 1;
+
+}
+
+/**
+ * @brief Reads all events of aReader and records the position of every
+ *     element.
+ * @param[in] aReader Needs to be at the start of the document.
+ * @param[in] nMaxDepth Elements deeper than that aren't indexed and get
+ *     skipped without parsing them, 0 for no limit.
+ */
+int XMLIndex::build(XMLEventReader& aReader, unsigned int nMaxDepth)
+{
+    m_aEntries.clear();
+    m_aNames.clear();
+    m_aNameIDs.clear();
+
+    aReader.setLocationTracking(true);
+    aReader.setIgnoreWhitespace(true);
+    aReader.setIgnoreComments(true);
+    aReader.setIgnoreProcessingInstructions(true);
+
+    // Entries of the elements which are still open.
+    std::vector<std::size_t> aOpenEntries;
+
+    while (aReader.hasNext() == true)
+    {
+        std::unique_ptr<XMLEvent> pEvent = aReader.nextEvent();
+
+        if (pEvent->isStartElement() == true)
+        {
+            Entry aEntry;
+            aEntry.m_nStart = pEvent->getLocation().getCharacterOffset();
+            aEntry.m_nEnd = -1;
+            aEntry.m_nDepth = aOpenEntries.size() + 1;
+            aEntry.m_nNameID = GetNameID(pEvent->asStartElement().getName());
+
+            m_aEntries.push_back(aEntry);
+
+            if (nMaxDepth > 0 &&
+                aEntry.m_nDepth >= nMaxDepth)
+            {
+                aReader.skipElement();
+                m_aEntries.back().m_nEnd = aReader.getLocation().getCharacterOffset();
+            }
+            else
+            {
+                aOpenEntries.push_back(m_aEntries.size() - 1);
+            }
+        }
+        else if (pEvent->isEndElement() == true)
+        {
+            if (aOpenEntries.empty() == true)
+            {
+                throw new XMLStreamException("End element without start element.", pEvent->getLocation());
+            }
+
+            // The reader didn't read ahead, as the end element is the last
+            // event it has read.
+            m_aEntries.at(aOpenEntries.back()).m_nEnd = aReader.getLocation().getCharacterOffset();
+            aOpenEntries.pop_back();
+        }
+    }
+
+    if (aOpenEntries.empty() != true)
+    {
+        throw new XMLStreamException("Document ended before all elements were closed.", aReader.getLocation());
+    }
+
+    return 0;
+}
+
+int XMLIndex::write(std::ostream& aStream) const
+{
+    aStream.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    WriteNumber(aStream, INDEX_VERSION, 4);
+    WriteNumber(aStream, m_aNames.size(), 4);
+
+    for (std::vector<std::string>::const_iterator iter = m_aNames.begin();
+         iter != m_aNames.end();
+         iter++)
+    {
+        WriteNumber(aStream, iter->length(), 4);
+        aStream.write(iter->data(), iter->length());
+    }
+
+    WriteNumber(aStream, m_aEntries.size(), 8);
+
+    for (std::vector<Entry>::const_iterator iter = m_aEntries.begin();
+         iter != m_aEntries.end();
+         iter++)
+    {
+        WriteNumber(aStream, iter->m_nStart, 8);
+        WriteNumber(aStream, iter->m_nEnd, 8);
+        WriteNumber(aStream, iter->m_nDepth, 4);
+        WriteNumber(aStream, iter->m_nNameID, 4);
+    }
+
+    if (aStream.bad() == true)
+    {
+        throw new std::runtime_error("Stream is bad.");
+    }
+
+    return 0;
+}
+
+int XMLIndex::read(std::istream& aStream)
+{
+    m_aEntries.clear();
+    m_aNames.clear();
+    m_aNameIDs.clear();
+
+    char cMagic[sizeof(INDEX_MAGIC)];
+    aStream.read(cMagic, sizeof(cMagic));
+
+    if (aStream.gcount() != sizeof(cMagic) ||
+        std::equal(cMagic, cMagic + sizeof(cMagic), INDEX_MAGIC) != true)
+    {
+        throw new std::runtime_error("Not an index file.");
+    }
+
+    if (ReadNumber(aStream, 4) != INDEX_VERSION)
+    {
+        throw new std::runtime_error("Index file version not supported.");
+    }
+
+    unsigned long long nNameCount = ReadNumber(aStream, 4);
+
+    for (unsigned long long i = 0; i < nNameCount; i++)
+    {
+        std::string strName(ReadNumber(aStream, 4), '\0');
+
+        if (strName.empty() != true)
+        {
+            aStream.read(&strName[0], strName.length());
+
+            if (aStream.gcount() != static_cast<std::streamsize>(strName.length()))
+            {
+                throw new std::runtime_error("Index file incomplete.");
+            }
+        }
+
+        m_aNameIDs.insert(std::pair<std::string, unsigned int>(strName, m_aNames.size()));
+        m_aNames.push_back(strName);
+    }
+
+    unsigned long long nEntryCount = ReadNumber(aStream, 8);
+
+    for (unsigned long long i = 0; i < nEntryCount; i++)
+    {
+        Entry aEntry;
+        aEntry.m_nStart = ReadNumber(aStream, 8);
+        aEntry.m_nEnd = ReadNumber(aStream, 8);
+        aEntry.m_nDepth = ReadNumber(aStream, 4);
+        aEntry.m_nNameID = ReadNumber(aStream, 4);
+
+        if (aEntry.m_nNameID >= m_aNames.size() ||
+            aEntry.m_nEnd < aEntry.m_nStart)
+        {
+            throw new std::runtime_error("Index file is malformed.");
+        }
+
+        m_aEntries.push_back(aEntry);
+    }
+
+    return 0;
+}
+
+std::size_t XMLIndex::getEntryCount() const
+{
+    return m_aEntries.size();
+}
+
+const XMLIndex::Entry& XMLIndex::getEntry(std::size_t nEntry) const
+{
+    return m_aEntries.at(nEntry);
+}
+
+/**
+ * @brief Element name as it appears in the document, with prefix if any.
+ */
+const std::string& XMLIndex::getName(unsigned int nNameID) const
+{
+    return m_aNames.at(nNameID);
+}
+
+/**
+ * @param[in] strName Element name, with prefix if any.
+ * @retval Entries of all elements with that name, in document order.
+ */
+std::vector<std::size_t> XMLIndex::findEntries(const std::string& strName) const
+{
+    std::vector<std::size_t> aResult;
+    std::unordered_map<std::string, unsigned int>::const_iterator iterName = m_aNameIDs.find(strName);
+
+    if (iterName == m_aNameIDs.end())
+    {
+        return aResult;
+    }
+
+    for (std::size_t i = 0; i < m_aEntries.size(); i++)
+    {
+        if (m_aEntries[i].m_nNameID == iterName->second)
+        {
+            aResult.push_back(i);
+        }
+    }
+
+    return aResult;
+}
+
+/**
+ * @brief Creates a reader for only the element of the entry, including
+ *     its start and end tag.
+ * @param[in] aDocument The indexed document, needs to be seekable and to
+ *     stay valid while the reader is in use. Locations reported by the
+ *     reader are relative to the start of the element.
+ */
+std::unique_ptr<XMLEventReader> XMLIndex::openEntry(std::istream& aDocument, std::size_t nEntry) const
+{
+    const Entry& aEntry = m_aEntries.at(nEntry);
+    std::unique_ptr<std::streambuf> pBuffer(new RangeStreamBuffer(aDocument.rdbuf(),
+                                                                  aEntry.m_nStart,
+                                                                  aEntry.m_nEnd - aEntry.m_nStart));
+
+    return std::unique_ptr<XMLEventReader>(new XMLEventReader(std::move(pBuffer)));
+}
+
+unsigned int XMLIndex::GetNameID(const QName& aName)
+{
+    std::string strName;
+
+    if (aName.getPrefix().empty() == true)
+    {
+        strName = aName.getLocalPart();
+    }
+    else
+    {
+        strName = aName.getPrefix() + ":" + aName.getLocalPart();
+    }
+
+    std::unordered_map<std::string, unsigned int>::iterator iter = m_aNameIDs.find(strName);
+
+    if (iter != m_aNameIDs.end())
+    {
+        return iter->second;
+    }
+
+    unsigned int nNameID = m_aNames.size();
+
+    m_aNameIDs.insert(std::pair<std::string, unsigned int>(strName, nNameID));
+    m_aNames.push_back(strName);
+
+    return nNameID;
+}
+
+void XMLIndex::WriteNumber(std::ostream& aStream, unsigned long long nNumber, unsigned int nBytes)
+{
+    for (unsigned int i = 0; i < nBytes; i++)
+    {
+        aStream.put(static_cast<char>((nNumber >> (i * 8)) & 0xFF));
+    }
+}
+
+unsigned long long XMLIndex::ReadNumber(std::istream& aStream, unsigned int nBytes)
+{
+    unsigned long long nNumber = 0;
+
+    for (unsigned int i = 0; i < nBytes; i++)
+    {
+        char cByte = '\0';
+        aStream.get(cByte);
+
+        if (aStream.eof() == true)
+        {
+            throw new std::runtime_error("Index file incomplete.");
+        }
+
+        if (aStream.bad() == true)
+        {
+            throw new std::runtime_error("Stream is bad.");
+        }
+
+        nNumber |= static_cast<unsigned long long>(static_cast<unsigned char>(cByte)) << (i * 8);
+    }
+
+    return nNumber;
+}
+
+}
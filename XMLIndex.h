@@ -0,0 +1,79 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLIndex.h
+ * @brief Structural index of the elements of a document, to parse single
+ *     elements again later without reading the document from the start.
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#ifndef _CPPSTAX_XMLINDEX_H
+#define _CPPSTAX_XMLINDEX_H
+
+#include "XMLEventReader.h"
+#include <istream>
+#include <ostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace cppstax
+{
+
+class XMLIndex
+{
+public:
+    struct Entry
+    {
+        /** Byte offset of the '<' of the start tag. */
+        std::streamoff m_nStart;
+        /** Byte offset after the '>' of the end tag. */
+        std::streamoff m_nEnd;
+        /** 1 for the root element. */
+        unsigned int m_nDepth;
+        unsigned int m_nNameID;
+    };
+
+public:
+    int build(XMLEventReader& aReader, unsigned int nMaxDepth);
+    int write(std::ostream& aStream) const;
+    int read(std::istream& aStream);
+
+public:
+    std::size_t getEntryCount() const;
+    const Entry& getEntry(std::size_t nEntry) const;
+    const std::string& getName(unsigned int nNameID) const;
+    std::vector<std::size_t> findEntries(const std::string& strName) const;
+    std::unique_ptr<XMLEventReader> openEntry(std::istream& aDocument, std::size_t nEntry) const;
+
+protected:
+    unsigned int GetNameID(const QName& aName);
+    static void WriteNumber(std::ostream& aStream, unsigned long long nNumber, unsigned int nBytes);
+    static unsigned long long ReadNumber(std::istream& aStream, unsigned int nBytes);
+
+protected:
+    std::vector<Entry> m_aEntries;
+    std::vector<std::string> m_aNames;
+    std::unordered_map<std::string, unsigned int> m_aNameIDs;
+
+};
+
+}
+
+#endif
@@ -21,13 +21,72 @@
  */
 
 #include "XMLInputFactory.h"
+#include "XMLStructuralEventReader.h"
+#include "XMLPolicyEventReader.h"
+#include "XMLParserPolicy.h"
 
 namespace cppstax
 {
 
+XMLInputFactory::XMLInputFactory():
+  m_eEngine(ENGINE_DEFAULT)
+{
+
+}
+
 std::unique_ptr<XMLEventReader> XMLInputFactory::createXMLEventReader(std::istream& stream)
 {
+    if (m_eEngine == ENGINE_STRUCTURAL_INDEX)
+    {
+        return std::unique_ptr<XMLEventReader>(new XMLStructuralEventReader(stream));
+    }
+    else if (m_eEngine == ENGINE_COMPILED_MINIMAL)
+    {
+        return std::unique_ptr<XMLEventReader>(new XMLPolicyEventReader<XMLMinimalPolicy>(stream));
+    }
+    else if (m_eEngine == ENGINE_COMPILED_DEFAULT)
+    {
+        return std::unique_ptr<XMLEventReader>(new XMLPolicyEventReader<XMLDefaultPolicy>(stream));
+    }
+    else if (m_eEngine == ENGINE_COMPILED_FULL)
+    {
+        return std::unique_ptr<XMLEventReader>(new XMLPolicyEventReader<XMLFullPolicy>(stream));
+    }
+
     return std::unique_ptr<XMLEventReader>(new XMLEventReader(stream));
 }
 
+std::unique_ptr<XMLEventReader> XMLInputFactory::createXMLEventReader(std::unique_ptr<std::streambuf> pBuffer)
+{
+    if (m_eEngine == ENGINE_STRUCTURAL_INDEX)
+    {
+        return std::unique_ptr<XMLEventReader>(new XMLStructuralEventReader(std::move(pBuffer)));
+    }
+    else if (m_eEngine == ENGINE_COMPILED_MINIMAL)
+    {
+        return std::unique_ptr<XMLEventReader>(new XMLPolicyEventReader<XMLMinimalPolicy>(std::move(pBuffer)));
+    }
+    else if (m_eEngine == ENGINE_COMPILED_DEFAULT)
+    {
+        return std::unique_ptr<XMLEventReader>(new XMLPolicyEventReader<XMLDefaultPolicy>(std::move(pBuffer)));
+    }
+    else if (m_eEngine == ENGINE_COMPILED_FULL)
+    {
+        return std::unique_ptr<XMLEventReader>(new XMLPolicyEventReader<XMLFullPolicy>(std::move(pBuffer)));
+    }
+
+    return std::unique_ptr<XMLEventReader>(new XMLEventReader(std::move(pBuffer)));
+}
+
+/**
+ * @brief Selects the implementation of the readers created from now on.
+ *     ENGINE_DEFAULT, ENGINE_STRUCTURAL_INDEX and ENGINE_COMPILED_DEFAULT
+ *     report the same events, the other compiled ones what their policy
+ *     selects, see XMLParserPolicy.h.
+ */
+void XMLInputFactory::setEngine(Engine eEngine)
+{
+    m_eEngine = eEngine;
+}
+
 }
@@ -26,6 +26,7 @@
 
 #include "XMLEventReader.h"
 #include <istream>
+#include <streambuf>
 #include <memory>
 
 namespace cppstax
@@ -33,8 +34,35 @@ namespace cppstax
 
 class XMLInputFactory
 {
+public:
+    enum Engine
+    {
+        /** XMLEventReader. */
+        ENGINE_DEFAULT,
+        /** XMLStructuralEventReader. */
+        ENGINE_STRUCTURAL_INDEX,
+        /** XMLPolicyEventReader<XMLMinimalPolicy>, these have the
+          * XMLScanner of XMLEventReader compiled with another policy. */
+        ENGINE_COMPILED_MINIMAL,
+        /** XMLPolicyEventReader<XMLDefaultPolicy>, the scanner of
+          * ENGINE_DEFAULT. */
+        ENGINE_COMPILED_DEFAULT,
+        /** XMLPolicyEventReader<XMLFullPolicy>. */
+        ENGINE_COMPILED_FULL
+    };
+
+public:
+    XMLInputFactory();
+
 public:
     std::unique_ptr<XMLEventReader> createXMLEventReader(std::istream& stream);
+    std::unique_ptr<XMLEventReader> createXMLEventReader(std::unique_ptr<std::streambuf> pBuffer);
+
+public:
+    void setEngine(Engine eEngine);
+
+protected:
+    Engine m_eEngine;
 
 };
 
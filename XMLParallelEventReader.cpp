@@ -0,0 +1,662 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLParallelEventReader.cpp
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#include "XMLParallelEventReader.h"
+#include "MemoryStreamBuffer.h"
+#include <ios>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+#include <iterator>
+
+namespace cppstax
+{
+
+namespace
+{
+
+/** Events a chunk reader hands over at once. */
+const std::size_t EVENT_BATCH_SIZE = 256;
+
+}
+
+XMLParallelEventReader::XMLParallelEventReader(const char* pData, std::size_t nLength, unsigned int nThreads):
+  XMLEventReader(std::unique_ptr<std::streambuf>(new MemoryStreamBuffer(pData, nLength))),
+  m_pData(pData),
+  m_nLength(nLength),
+  m_nChunkSize(64 * 1024),
+  m_pThreadPool(new ThreadPool(nThreads)),
+  m_nEvent(0),
+  m_bParallel(false),
+  m_bRootStarted(false),
+  m_bChunkReady(false),
+  m_nChunkOffset(0),
+  m_nScanOffset(0),
+  m_nScanDepth(0),
+  m_bScanComplete(false),
+  m_nSequentialOffset(0)
+{
+
+}
+
+XMLParallelEventReader::~XMLParallelEventReader()
+{
+    // Chunks still being parsed by the pool need to be finished before
+    // they get destroyed, the ones not started yet are discarded.
+    m_pThreadPool.reset(nullptr);
+}
+
+/**
+ * @brief The chunks are parsed from the document in memory, so there's
+ *     no other stream to continue with.
+ */
+void XMLParallelEventReader::Reset(std::streambuf*)
+{
+    throw new std::logic_error("XMLParallelEventReader can't be reset onto a stream.");
+}
+
+bool XMLParallelEventReader::hasNext()
+{
+    if (m_bParallel != true)
+    {
+        return XMLEventReader::hasNext();
+    }
+
+    if (m_pSequentialReader != nullptr)
+    {
+        if (m_pSequentialReader->hasNext() == true)
+        {
+            return true;
+        }
+
+        return FailSequential();
+    }
+
+    while (m_aChunks.size() > 0)
+    {
+        Chunk* pChunk = m_aChunks.front().get();
+
+        if (m_bChunkReady != true)
+        {
+            {
+                std::unique_lock<std::mutex> aLock(m_aMutex);
+
+                while (pChunk->m_bDone != true)
+                {
+                    m_aChunkDone.wait(aLock);
+                }
+            }
+
+            if (pChunk->m_aError.getCode() != XMLStreamError::ERROR_NONE &&
+                pChunk->m_pException == nullptr)
+            {
+                ReadSequentially(pChunk);
+                return hasNext();
+            }
+
+            m_bChunkReady = true;
+            m_nEvent = 0;
+        }
+
+        if (m_nEvent < pChunk->m_aEvents.size())
+        {
+            return true;
+        }
+
+        // The events in front of an exception are delivered first.
+        if (pChunk->m_pException != nullptr)
+        {
+            return FailChunk(pChunk);
+        }
+
+        m_aChunkLocation = TranslateLocation(pChunk->m_aEndLocation);
+        m_aChunks.pop_front();
+        m_bChunkReady = false;
+
+        AddChunk();
+    }
+
+    return false;
+}
+
+std::unique_ptr<XMLEvent> XMLParallelEventReader::nextEvent()
+{
+    if (m_bParallel != true)
+    {
+        std::unique_ptr<XMLEvent> pEvent = XMLEventReader::nextEvent();
+
+        if (m_bRootStarted != true &&
+            pEvent->isStartElement() == true)
+        {
+            m_bRootStarted = true;
+
+            // Unless the root element is empty, the scanner is now
+            // positioned right behind the root start tag. Several
+            // documents are read sequentially.
+            if (m_nEventCount <= 0 &&
+                m_bMultipleDocuments != true)
+            {
+                StartChunks();
+            }
+        }
+
+        return pEvent;
+    }
+
+    if (hasNext() != true)
+    {
+        throw new std::logic_error("Attempted XMLParallelEventReader::nextEvent() while there isn't one instead of checking XMLParallelEventReader::hasNext() first.");
+    }
+
+    std::unique_ptr<XMLEvent> pEvent = nullptr;
+
+    if (m_pSequentialReader != nullptr)
+    {
+        pEvent = m_pSequentialReader->nextEvent();
+        TranslateEvent(*pEvent, m_nSequentialOffset);
+    }
+    else
+    {
+        pEvent = std::unique_ptr<XMLEvent>(new XMLEvent(std::move(m_aChunks.front()->m_aEvents.at(m_nEvent))));
+        ++m_nEvent;
+        TranslateEvent(*pEvent, m_aChunks.front()->m_nOffset);
+    }
+
+    m_bStartElementReturned = pEvent->isStartElement();
+
+    return pEvent;
+}
+
+/**
+ * @brief Moves the events already constructed by the chunk readers out
+ *     of their storage.
+ */
+std::size_t XMLParallelEventReader::nextEvents(std::vector<XMLEvent>& aEvents, std::size_t nMax)
+{
+    aEvents.clear();
+
+    while (aEvents.size() < nMax &&
+           hasNext() == true)
+    {
+        if (m_bParallel != true)
+        {
+            aEvents.push_back(std::move(*nextEvent()));
+            continue;
+        }
+
+        if (m_pSequentialReader != nullptr)
+        {
+            aEvents.push_back(std::move(*m_pSequentialReader->nextEvent()));
+            TranslateEvent(aEvents.back(), m_nSequentialOffset);
+            continue;
+        }
+
+        aEvents.push_back(std::move(m_aChunks.front()->m_aEvents.at(m_nEvent)));
+        ++m_nEvent;
+        TranslateEvent(aEvents.back(), m_aChunks.front()->m_nOffset);
+    }
+
+    m_bStartElementReturned = aEvents.size() > 0 && aEvents.back().isStartElement() == true;
+
+    return aEvents.size();
+}
+
+/**
+ * @brief Other than XMLEventReader::skipElement(), the events of the
+ *     subtree are constructed anyway by the chunk readers and just
+ *     dropped here.
+ */
+bool XMLParallelEventReader::skipElement()
+{
+    if (m_bParallel != true)
+    {
+        return XMLEventReader::skipElement();
+    }
+
+    if (m_bStartElementReturned != true)
+    {
+        throw new std::logic_error("Attempted XMLParallelEventReader::skipElement() without XMLParallelEventReader::nextEvent() having returned a StartElement.");
+    }
+
+    m_bStartElementReturned = false;
+
+    unsigned int nDepth = 1;
+
+    while (nDepth > 0 &&
+           hasNext() == true)
+    {
+        std::unique_ptr<XMLEvent> pSequentialEvent = nullptr;
+        XMLEvent* pEvent = nullptr;
+
+        if (m_pSequentialReader != nullptr)
+        {
+            pSequentialEvent = m_pSequentialReader->nextEvent();
+            pEvent = pSequentialEvent.get();
+        }
+        else
+        {
+            pEvent = &m_aChunks.front()->m_aEvents.at(m_nEvent);
+            ++m_nEvent;
+        }
+
+        if (pEvent->isStartElement() == true)
+        {
+            ++nDepth;
+        }
+        else if (pEvent->isEndElement() == true)
+        {
+            --nDepth;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Approximate size of the chunks the root element content gets
+ *     split into. A chunk ends in front of the first record start tag
+ *     behind the chunk size, so a single large record isn't split.
+ *     Events of chunks in flight are held in memory, so small chunks
+ *     keep them in the cache until they're delivered.
+ */
+void XMLParallelEventReader::setChunkSize(std::size_t nChunkSize)
+{
+    if (nChunkSize <= 0)
+    {
+        throw new std::invalid_argument("Chunk size of 0.");
+    }
+
+    m_nChunkSize = nChunkSize;
+}
+
+void XMLParallelEventReader::StartChunks()
+{
+    m_nChunkOffset = m_aScanner.getPosition();
+
+    if (m_bLocationTracking == true)
+    {
+        m_aChunkLocation = m_aScanner.getLocation();
+    }
+
+    m_nScanOffset = m_nChunkOffset;
+    m_nScanDepth = 0;
+    m_bParallel = true;
+
+    // Enough chunks in flight to keep every thread busy while the
+    // consumer handles the front chunk.
+    for (unsigned int i = 0, nMax = m_pThreadPool->getThreadCount() * 2; i < nMax; i++)
+    {
+        if (AddChunk() != true)
+        {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Schedules the next chunk for parsing. The root end tag and
+ *     whatever follows it is the last chunk.
+ */
+bool XMLParallelEventReader::AddChunk()
+{
+    if (m_pThreadPool == nullptr ||
+        m_nChunkOffset >= m_nLength)
+    {
+        return false;
+    }
+
+    std::size_t nEnd = m_nLength;
+
+    if (m_bScanComplete != true)
+    {
+        nEnd = FindSplit(m_nChunkOffset + m_nChunkSize);
+    }
+
+    if (nEnd <= m_nChunkOffset)
+    {
+        nEnd = m_nLength;
+    }
+
+    std::unique_ptr<Chunk> pChunk(new Chunk);
+    pChunk->m_nOffset = m_nChunkOffset;
+    pChunk->m_nLength = nEnd - m_nChunkOffset;
+    pChunk->m_pException = nullptr;
+    pChunk->m_bDone = false;
+
+    Chunk* pTask = pChunk.get();
+    m_aChunks.push_back(std::move(pChunk));
+    m_pThreadPool->addTask([this, pTask](unsigned int) { ParseChunk(pTask); });
+
+    m_nChunkOffset = nEnd;
+
+    return true;
+}
+
+/**
+ * @brief Continues the raw scan up to the first start tag of a child of
+ *     the root element at or behind nTarget, skipping over comments,
+ *     processing instructions, CDATA sections and attribute values.
+ * @retval Offset of the '<' of that start tag, or of the root end tag if
+ *     it was reached first.
+ */
+std::size_t XMLParallelEventReader::FindSplit(std::size_t nTarget)
+{
+    const char* pEnd = m_pData + m_nLength;
+    const char* pPosition = m_pData + m_nScanOffset;
+
+    while (pPosition != nullptr)
+    {
+        pPosition = static_cast<const char*>(std::memchr(pPosition, '<', pEnd - pPosition));
+
+        if (pPosition == nullptr ||
+            pEnd - pPosition < 2)
+        {
+            break;
+        }
+
+        std::size_t nOffset = pPosition - m_pData;
+        char cByte = pPosition[1];
+
+        if (cByte == '/')
+        {
+            if (m_nScanDepth <= 0)
+            {
+                m_nScanOffset = nOffset;
+                m_bScanComplete = true;
+                return nOffset;
+            }
+
+            --m_nScanDepth;
+            pPosition = static_cast<const char*>(std::memchr(pPosition, '>', pEnd - pPosition));
+        }
+        else if (cByte == '?')
+        {
+            pPosition = FindSequence(pPosition + 2, "?>", 2);
+        }
+        else if (cByte == '!')
+        {
+            if (pEnd - pPosition >= 4 &&
+                std::memcmp(pPosition, "<!--", 4) == 0)
+            {
+                pPosition = FindSequence(pPosition + 4, "-->", 3);
+            }
+            else if (pEnd - pPosition >= 9 &&
+                     std::memcmp(pPosition, "<![CDATA[", 9) == 0)
+            {
+                pPosition = FindSequence(pPosition + 9, "]]>", 3);
+            }
+            else
+            {
+                pPosition = static_cast<const char*>(std::memchr(pPosition, '>', pEnd - pPosition));
+            }
+        }
+        else
+        {
+            if (m_nScanDepth <= 0 &&
+                nOffset >= nTarget)
+            {
+                m_nScanOffset = nOffset;
+                return nOffset;
+            }
+
+            // Start tag, '>' and '/' might appear in attribute values.
+            char cQuote = '\0';
+
+            for (++pPosition; pPosition < pEnd; pPosition++)
+            {
+                if (cQuote != '\0')
+                {
+                    if (*pPosition == cQuote)
+                    {
+                        cQuote = '\0';
+                    }
+                }
+                else if (*pPosition == '"' ||
+                         *pPosition == '\'')
+                {
+                    cQuote = *pPosition;
+                }
+                else if (*pPosition == '>')
+                {
+                    break;
+                }
+            }
+
+            if (pPosition >= pEnd)
+            {
+                break;
+            }
+
+            if (*(pPosition - 1) != '/')
+            {
+                ++m_nScanDepth;
+            }
+        }
+
+        if (pPosition != nullptr)
+        {
+            // Behind the '>'.
+            ++pPosition;
+        }
+    }
+
+    // Incomplete, the readers of the remaining chunk will report that.
+    m_nScanOffset = m_nLength;
+    m_bScanComplete = true;
+
+    return m_nLength;
+}
+
+/**
+ * @retval Position of the last byte of the sequence, or nullptr.
+ */
+const char* XMLParallelEventReader::FindSequence(const char* pPosition, const char* pSequence, std::size_t nSequenceLength)
+{
+    const char* pEnd = m_pData + m_nLength;
+
+    while (pEnd - pPosition >= static_cast<std::ptrdiff_t>(nSequenceLength))
+    {
+        pPosition = static_cast<const char*>(std::memchr(pPosition, pSequence[0], pEnd - pPosition));
+
+        if (pPosition == nullptr ||
+            pEnd - pPosition < static_cast<std::ptrdiff_t>(nSequenceLength))
+        {
+            return nullptr;
+        }
+
+        if (std::memcmp(pPosition, pSequence, nSequenceLength) == 0)
+        {
+            return pPosition + nSequenceLength - 1;
+        }
+
+        ++pPosition;
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Gives a reader of a part of the document the settings of this
+ *     one.
+ */
+void XMLParallelEventReader::ConfigureReader(XMLEventReader& aReader)
+{
+    aReader.setIgnoreWhitespace(m_bIgnoreWhitespace);
+    aReader.setIgnoreComments(m_bIgnoreComments);
+    aReader.setIgnoreProcessingInstructions(m_bIgnoreProcessingInstructions);
+    aReader.setLocationTracking(m_bLocationTracking);
+    aReader.setSourceRanges(m_bSourceRanges);
+    aReader.setThrowOnError(false);
+
+    for (std::map<std::string, std::string>::const_iterator iter = m_aEntityReplacementDictionary.begin();
+         iter != m_aEntityReplacementDictionary.end();
+         iter++)
+    {
+        if (iter->first != "amp" &&
+            iter->first != "lt" &&
+            iter->first != "gt" &&
+            iter->first != "apos" &&
+            iter->first != "quot")
+        {
+            aReader.addToEntityReplacementDictionary(iter->first, iter->second);
+        }
+    }
+}
+
+/**
+ * @brief Runs on a thread of the pool.
+ */
+void XMLParallelEventReader::ParseChunk(Chunk* pChunk)
+{
+    std::vector<XMLEvent> aEvents;
+
+    try
+    {
+        XMLEventReader aReader(std::unique_ptr<std::streambuf>(new MemoryStreamBuffer(m_pData + pChunk->m_nOffset, pChunk->m_nLength)));
+        ConfigureReader(aReader);
+
+        while (aReader.nextEvents(aEvents, EVENT_BATCH_SIZE) > 0)
+        {
+            std::move(aEvents.begin(), aEvents.end(), std::back_inserter(pChunk->m_aEvents));
+        }
+
+        pChunk->m_aEndLocation = aReader.getLocation();
+        pChunk->m_aError = aReader.getError();
+    }
+    catch (...)
+    {
+        // The events in front of the error.
+        std::move(aEvents.begin(), aEvents.end(), std::back_inserter(pChunk->m_aEvents));
+        pChunk->m_pException = std::current_exception();
+    }
+
+    {
+        std::lock_guard<std::mutex> aLock(m_aMutex);
+        pChunk->m_bDone = true;
+    }
+
+    m_aChunkDone.notify_all();
+}
+
+/**
+ * @brief Drops the chunks and continues with reading the document from
+ *     the start of pChunk, which failed, to its end. None of the events
+ *     of pChunk were delivered yet, and the chunks in front of it ended
+ *     where a sequential reader would have been at the start of pChunk,
+ *     so the events and the first error are the ones of XMLEventReader.
+ */
+void XMLParallelEventReader::ReadSequentially(Chunk* pChunk)
+{
+    m_nSequentialOffset = pChunk->m_nOffset;
+
+    // The chunk tasks refer to m_aChunks.
+    m_pThreadPool->cancel();
+    m_aChunks.clear();
+    m_bChunkReady = false;
+    m_nChunkOffset = m_nLength;
+
+    m_pSequentialReader.reset(new XMLEventReader(std::unique_ptr<std::streambuf>(new MemoryStreamBuffer(m_pData + m_nSequentialOffset, m_nLength - m_nSequentialOffset))));
+    ConfigureReader(*m_pSequentialReader);
+}
+
+/**
+ * @brief Stops parsing and rethrows an exception of a chunk which isn't
+ *     about its input.
+ */
+bool XMLParallelEventReader::FailChunk(Chunk* pChunk)
+{
+    std::exception_ptr pException = pChunk->m_pException;
+
+    // The chunk tasks refer to m_aChunks.
+    m_pThreadPool->cancel();
+    m_aChunks.clear();
+    m_bChunkReady = false;
+    m_nChunkOffset = m_nLength;
+
+    std::rethrow_exception(pException);
+
+    return false;
+}
+
+/**
+ * @brief Ends the sequential reading, reporting its error with the
+ *     location translated to the document.
+ * @retval false if not throwing.
+ */
+bool XMLParallelEventReader::FailSequential()
+{
+    XMLStreamError aError = m_pSequentialReader->getError();
+    m_pSequentialReader.reset(nullptr);
+
+    if (aError.getCode() == XMLStreamError::ERROR_NONE)
+    {
+        return false;
+    }
+
+    aError.setLocation(TranslateLocation(aError.getLocation()));
+
+    return Fail(aError);
+}
+
+/**
+ * @brief Translates the location and source range of an event read from
+ *     the document at nOffset on.
+ */
+void XMLParallelEventReader::TranslateEvent(XMLEvent& aEvent, std::size_t nOffset)
+{
+    if (m_bLocationTracking == true)
+    {
+        aEvent.setLocation(TranslateLocation(aEvent.getLocation()));
+    }
+
+    if (m_bSourceRanges == true &&
+        aEvent.hasSourceRange() == true)
+    {
+        aEvent.setSourceRange(nOffset + aEvent.getSourceOffset(), aEvent.getSourceLength());
+    }
+}
+
+/**
+ * @brief Translates a location relative to the front chunk, or to where
+ *     the sequential reading started.
+ */
+Location XMLParallelEventReader::TranslateLocation(const Location& aLocation)
+{
+    if (aLocation.isKnown() != true ||
+        m_aChunkLocation.isKnown() != true)
+    {
+        return Location();
+    }
+
+    long nColumnNumber = aLocation.getColumnNumber();
+
+    if (aLocation.getLineNumber() <= 1)
+    {
+        nColumnNumber += m_aChunkLocation.getColumnNumber() - 1;
+    }
+
+    return Location(m_aChunkLocation.getCharacterOffset() + aLocation.getCharacterOffset(),
+                    m_aChunkLocation.getLineNumber() + aLocation.getLineNumber() - 1,
+                    nColumnNumber);
+}
+
+}
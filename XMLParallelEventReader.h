@@ -0,0 +1,135 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLParallelEventReader.h
+ * @brief Parses a document which is in memory with several threads.
+ * @details The prolog up to the root StartElement is read sequentially.
+ *     The content of the root element is then split in front of start
+ *     tags of children of the root element (records), found by a raw
+ *     scan for markup which doesn't construct events and so runs at
+ *     memory speed. The chunks are parsed concurrently by readers of
+ *     their own on a thread pool and their events get delivered in
+ *     document order, the same as a sequential XMLEventReader would
+ *     return them. Only a limited number of chunks is in flight at the
+ *     same time, so memory use doesn't grow with the document size. A
+ *     chunk reader only sees the input up to the end of its chunk, so
+ *     its error might not be the one the rest of the document leads to:
+ *     from a chunk that failed on, the document is read sequentially
+ *     instead, which reports the same events and the same first error
+ *     as XMLEventReader. In
+ *     multiple documents mode (see
+ *     XMLEventReader::setMultipleDocuments()), all of the input is read
+ *     sequentially.
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#ifndef _CPPSTAX_XMLPARALLELEVENTREADER_H
+#define _CPPSTAX_XMLPARALLELEVENTREADER_H
+
+#include "XMLEventReader.h"
+#include "ThreadPool.h"
+#include <memory>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <cstddef>
+
+namespace cppstax
+{
+
+class XMLParallelEventReader : public XMLEventReader
+{
+public:
+    /**
+     * @param[in] pData Document, needs to stay valid while the reader
+     *     is in use.
+     * @param[in] nThreads 0 for the number of hardware threads.
+     */
+    XMLParallelEventReader(const char* pData, std::size_t nLength, unsigned int nThreads);
+    virtual ~XMLParallelEventReader();
+
+    virtual bool hasNext();
+    virtual std::unique_ptr<XMLEvent> nextEvent();
+    virtual std::size_t nextEvents(std::vector<XMLEvent>& aEvents, std::size_t nMax);
+    virtual bool skipElement();
+
+public:
+    void setChunkSize(std::size_t nChunkSize);
+
+protected:
+    struct Chunk
+    {
+        std::size_t m_nOffset;
+        std::size_t m_nLength;
+        std::vector<XMLEvent> m_aEvents;
+        /** Relative to the chunk. */
+        Location m_aEndLocation;
+        /** Error in the input, relative to the chunk. */
+        XMLStreamError m_aError;
+        std::exception_ptr m_pException;
+        bool m_bDone;
+    };
+
+protected:
+    virtual void Reset(std::streambuf* pBuffer);
+    void StartChunks();
+    bool AddChunk();
+    std::size_t FindSplit(std::size_t nTarget);
+    const char* FindSequence(const char* pPosition, const char* pSequence, std::size_t nSequenceLength);
+    void ConfigureReader(XMLEventReader& aReader);
+    void ParseChunk(Chunk* pChunk);
+    void ReadSequentially(Chunk* pChunk);
+    bool FailChunk(Chunk* pChunk);
+    bool FailSequential();
+    void TranslateEvent(XMLEvent& aEvent, std::size_t nOffset);
+    Location TranslateLocation(const Location& aLocation);
+
+protected:
+    const char* m_pData;
+    std::size_t m_nLength;
+    std::size_t m_nChunkSize;
+    std::unique_ptr<ThreadPool> m_pThreadPool;
+    /** Chunks in flight, the front one is being delivered. */
+    std::deque<std::unique_ptr<Chunk>> m_aChunks;
+    std::size_t m_nEvent;
+    std::mutex m_aMutex;
+    std::condition_variable m_aChunkDone;
+    bool m_bParallel;
+    bool m_bRootStarted;
+    /** If the front chunk is parsed and its events are being delivered. */
+    bool m_bChunkReady;
+    /** Start of the next chunk not added yet. */
+    std::size_t m_nChunkOffset;
+    /** Position and element depth of the raw scan for split points. */
+    std::size_t m_nScanOffset;
+    unsigned int m_nScanDepth;
+    bool m_bScanComplete;
+    /** Location of the start of the front chunk in the document. */
+    Location m_aChunkLocation;
+    /** Reads the rest of the document after a chunk failed, from the
+      * start of that chunk at m_nSequentialOffset on. */
+    std::unique_ptr<XMLEventReader> m_pSequentialReader;
+    std::size_t m_nSequentialOffset;
+
+};
+
+}
+
+#endif
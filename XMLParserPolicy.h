@@ -0,0 +1,125 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLParserPolicy.h
+ * @brief Prebuilt feature sets for XMLScanner, which XMLEventReader,
+ *     XMLStructuralEventReader, XMLPolicyEventReader, XMLPushParser,
+ *     XMLDecoder and XMLValidator are built on.
+ * @details A policy is any type with the following static bool constants.
+ *     They are only tested in conditions the compiler resolves, so the code
+ *     of a disabled feature isn't part of the instantiation.
+ *     ENTITY_RESOLUTION: entity references in text and attribute values
+ *     are replaced, otherwise '&' is an ordinary byte and references are
+ *     reported as written, without being checked.
+ *     IGNORE_WHITESPACE: text consisting of whitespace only isn't reported.
+ *     REPORT_COMMENTS, REPORT_PROCESSING_INSTRUCTIONS: comments and
+ *     processing instructions are reported, otherwise only skipped.
+ *     LOCATION_TRACKING: events of XMLPolicyEventReader get their Location
+ *     attached.
+ *     CHECK_END_TAGS: end tags need to match the innermost open start tag
+ *     and all elements need to be closed at the end of the input.
+ *     STRUCTURAL_INDEX: the delimiters of text, attribute values and tags
+ *     are found in an index of the structural bytes '<', '>', '&', '"'
+ *     and '\'', which stage 1 builds a few kilobytes ahead, instead of
+ *     by searching the input for each of them.
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#ifndef _CPPSTAX_XMLPARSERPOLICY_H
+#define _CPPSTAX_XMLPARSERPOLICY_H
+
+namespace cppstax
+{
+
+/**
+ * @brief Elements, attributes and text only, as fast as it gets.
+ */
+struct XMLMinimalPolicy
+{
+    static const bool ENTITY_RESOLUTION = false;
+    static const bool IGNORE_WHITESPACE = false;
+    static const bool REPORT_COMMENTS = false;
+    static const bool REPORT_PROCESSING_INSTRUCTIONS = false;
+    static const bool LOCATION_TRACKING = false;
+    static const bool CHECK_END_TAGS = false;
+    static const bool STRUCTURAL_INDEX = false;
+};
+
+/**
+ * @brief The scanner of XMLEventReader, which applies its settings to
+ *     what gets reported.
+ */
+struct XMLDefaultPolicy
+{
+    static const bool ENTITY_RESOLUTION = true;
+    static const bool IGNORE_WHITESPACE = false;
+    static const bool REPORT_COMMENTS = true;
+    static const bool REPORT_PROCESSING_INSTRUCTIONS = true;
+    static const bool LOCATION_TRACKING = false;
+    static const bool CHECK_END_TAGS = false;
+    static const bool STRUCTURAL_INDEX = false;
+};
+
+/**
+ * @brief XMLDefaultPolicy with the structural index, which
+ *     XMLStructuralEventReader is built on.
+ */
+struct XMLStructuralPolicy
+{
+    static const bool ENTITY_RESOLUTION = true;
+    static const bool IGNORE_WHITESPACE = false;
+    static const bool REPORT_COMMENTS = true;
+    static const bool REPORT_PROCESSING_INSTRUCTIONS = true;
+    static const bool LOCATION_TRACKING = false;
+    static const bool CHECK_END_TAGS = false;
+    static const bool STRUCTURAL_INDEX = true;
+};
+
+/**
+ * @brief Every feature which adds to what gets reported or checked.
+ *     Ignoring whitespace removes from it, so it's left to custom policies.
+ */
+struct XMLFullPolicy
+{
+    static const bool ENTITY_RESOLUTION = true;
+    static const bool IGNORE_WHITESPACE = false;
+    static const bool REPORT_COMMENTS = true;
+    static const bool REPORT_PROCESSING_INSTRUCTIONS = true;
+    static const bool LOCATION_TRACKING = true;
+    static const bool CHECK_END_TAGS = true;
+    static const bool STRUCTURAL_INDEX = false;
+};
+
+/**
+ * @brief The checks of XMLFullPolicy with nothing reported but elements,
+ *     attributes and text, which XMLValidator is built on.
+ */
+struct XMLValidatingPolicy
+{
+    static const bool ENTITY_RESOLUTION = true;
+    static const bool IGNORE_WHITESPACE = false;
+    static const bool REPORT_COMMENTS = false;
+    static const bool REPORT_PROCESSING_INSTRUCTIONS = false;
+    static const bool LOCATION_TRACKING = true;
+    static const bool CHECK_END_TAGS = true;
+    static const bool STRUCTURAL_INDEX = false;
+};
+
+}
+
+#endif
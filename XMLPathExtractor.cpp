@@ -0,0 +1,572 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLPathExtractor.cpp
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#include "XMLPathExtractor.h"
+#include "XMLStreamException.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace cppstax
+{
+
+XMLPathExtractor::XMLPathExtractor():
+  m_nInitialState(0),
+  m_bCompiled(false)
+{
+
+}
+
+/**
+ * @details Expressions are compiled together on the next call of
+ *     XMLPathExtractor::extract().
+ */
+int XMLPathExtractor::addExpression(const std::string& strExpression, const MatchCallback& aCallback)
+{
+    if (strExpression.empty() == true ||
+        strExpression.at(0) != '/')
+    {
+        throw new std::invalid_argument("Path expression doesn't start with '/'.");
+    }
+
+    Expression aExpression;
+    aExpression.m_aCallback = aCallback;
+    aExpression.m_nFirstState = -1;
+
+    std::size_t nPosition = 0;
+    const std::size_t nLength = strExpression.length();
+
+    while (nPosition < nLength)
+    {
+        if (aExpression.m_aSteps.empty() != true &&
+            aExpression.m_aSteps.back().m_eType != STEP_ELEMENT)
+        {
+            throw new std::invalid_argument("Only the last step of a path expression can select text() or an attribute.");
+        }
+
+        if (strExpression.at(nPosition) != '/')
+        {
+            throw new std::invalid_argument("Path expression step doesn't start with '/'.");
+        }
+
+        Step aStep;
+        aStep.m_bDescendant = false;
+        aStep.m_eType = STEP_ELEMENT;
+        aStep.m_nNameID = -1;
+
+        ++nPosition;
+
+        if (nPosition < nLength &&
+            strExpression.at(nPosition) == '/')
+        {
+            aStep.m_bDescendant = true;
+            ++nPosition;
+        }
+
+        if (nPosition < nLength &&
+            strExpression.at(nPosition) == '@')
+        {
+            aStep.m_eType = STEP_ATTRIBUTE;
+            ++nPosition;
+        }
+
+        std::size_t nNameEnd = strExpression.find_first_of("/[]=", nPosition);
+
+        if (nNameEnd == std::string::npos)
+        {
+            nNameEnd = nLength;
+        }
+
+        aStep.m_strName = strExpression.substr(nPosition, nNameEnd - nPosition);
+        nPosition = nNameEnd;
+
+        if (aStep.m_strName.empty() == true)
+        {
+            throw new std::invalid_argument("Path expression step without name.");
+        }
+
+        if (aStep.m_eType == STEP_ELEMENT &&
+            aStep.m_strName == "text()")
+        {
+            aStep.m_eType = STEP_TEXT;
+        }
+
+        while (nPosition < nLength &&
+               strExpression.at(nPosition) == '[')
+        {
+            if (aStep.m_eType != STEP_ELEMENT)
+            {
+                throw new std::invalid_argument("Predicates are only supported for element steps.");
+            }
+
+            ++nPosition;
+
+            if (nPosition >= nLength ||
+                strExpression.at(nPosition) != '@')
+            {
+                throw new std::invalid_argument("Only attribute predicates are supported.");
+            }
+
+            ++nPosition;
+
+            Predicate aPredicate;
+            aPredicate.m_bHasValue = false;
+
+            nNameEnd = strExpression.find_first_of("=]", nPosition);
+
+            if (nNameEnd == std::string::npos)
+            {
+                throw new std::invalid_argument("Predicate incomplete.");
+            }
+
+            aPredicate.m_strAttributeName = strExpression.substr(nPosition, nNameEnd - nPosition);
+            nPosition = nNameEnd;
+
+            if (aPredicate.m_strAttributeName.empty() == true)
+            {
+                throw new std::invalid_argument("Predicate without attribute name.");
+            }
+
+            if (strExpression.at(nPosition) == '=')
+            {
+                ++nPosition;
+
+                if (nPosition >= nLength ||
+                    (strExpression.at(nPosition) != '\'' &&
+                     strExpression.at(nPosition) != '"'))
+                {
+                    throw new std::invalid_argument("Predicate value isn't quoted.");
+                }
+
+                std::size_t nValueEnd = strExpression.find(strExpression.at(nPosition), nPosition + 1);
+
+                if (nValueEnd == std::string::npos)
+                {
+                    throw new std::invalid_argument("Predicate value incomplete.");
+                }
+
+                aPredicate.m_bHasValue = true;
+                aPredicate.m_strValue = strExpression.substr(nPosition + 1, nValueEnd - nPosition - 1);
+                nPosition = nValueEnd + 1;
+            }
+
+            if (nPosition >= nLength ||
+                strExpression.at(nPosition) != ']')
+            {
+                throw new std::invalid_argument("Predicate incomplete.");
+            }
+
+            ++nPosition;
+
+            aStep.m_aPredicates.push_back(aPredicate);
+        }
+
+        aExpression.m_aSteps.push_back(aStep);
+    }
+
+    m_aExpressions.push_back(aExpression);
+    m_bCompiled = false;
+
+    return 0;
+}
+
+/**
+ * @brief Reads events from aReader until its end and calls the callbacks
+ *     of matching expressions.
+ */
+int XMLPathExtractor::extract(XMLEventReader& aReader)
+{
+    if (m_bCompiled != true)
+    {
+        Compile();
+    }
+
+    std::vector<int> aStack;
+    std::vector<Collector> aCollectors;
+
+    aStack.push_back(m_nInitialState);
+
+    while (aReader.hasNext() == true)
+    {
+        std::unique_ptr<XMLEvent> pEvent = aReader.nextEvent();
+
+        if (pEvent->isStartElement() == true)
+        {
+            const StartElement& aStartElement = pEvent->asStartElement();
+            int nState = NextState(aStack.back(), GetNameID(aStartElement.getName()), aStartElement);
+
+            if (nState == 0 &&
+                aCollectors.empty() == true)
+            {
+                // No expression can match within this subtree.
+                aReader.skipElement();
+                continue;
+            }
+
+            aStack.push_back(nState);
+
+            const State& aState = m_aStates.at(nState);
+
+            for (std::vector<std::size_t>::const_iterator iter = aState.m_aAttributeMatches.begin();
+                 iter != aState.m_aAttributeMatches.end();
+                 iter++)
+            {
+                const Expression& aExpression = m_aExpressions.at(*iter);
+                const std::shared_ptr<Attribute> pAttribute = FindAttribute(aStartElement, aExpression.m_aSteps.back().m_strName);
+
+                if (pAttribute != nullptr)
+                {
+                    aExpression.m_aCallback(pAttribute->getValue());
+                }
+            }
+
+            for (std::vector<std::size_t>::const_iterator iter = aState.m_aElementMatches.begin();
+                 iter != aState.m_aElementMatches.end();
+                 iter++)
+            {
+                Collector aCollector;
+                aCollector.m_nExpression = *iter;
+                aCollector.m_nDepth = aStack.size();
+                aCollectors.push_back(aCollector);
+            }
+        }
+        else if (pEvent->isEndElement() == true)
+        {
+            std::vector<Collector>::iterator iterComplete = aCollectors.end();
+
+            while (iterComplete != aCollectors.begin() &&
+                   (iterComplete - 1)->m_nDepth >= aStack.size())
+            {
+                --iterComplete;
+            }
+
+            for (std::vector<Collector>::iterator iter = iterComplete;
+                 iter != aCollectors.end();
+                 iter++)
+            {
+                m_aExpressions.at(iter->m_nExpression).m_aCallback(iter->m_strValue);
+            }
+
+            aCollectors.erase(iterComplete, aCollectors.end());
+
+            if (aStack.size() <= 1)
+            {
+                throw new XMLStreamException("End element without start element.", pEvent->getLocation());
+            }
+
+            aStack.pop_back();
+        }
+        else if (pEvent->isCharacters() == true)
+        {
+            const std::string& strData = pEvent->asCharacters().getData();
+            const State& aState = m_aStates.at(aStack.back());
+
+            for (std::vector<std::size_t>::const_iterator iter = aState.m_aTextMatches.begin();
+                 iter != aState.m_aTextMatches.end();
+                 iter++)
+            {
+                m_aExpressions.at(*iter).m_aCallback(strData);
+            }
+
+            for (std::vector<Collector>::iterator iter = aCollectors.begin();
+                 iter != aCollectors.end();
+                 iter++)
+            {
+                iter->m_strValue.append(strData);
+            }
+        }
+    }
+
+    return 0;
+}
+
+void XMLPathExtractor::Compile()
+{
+    m_aExpressionStates.clear();
+    m_aStates.clear();
+    m_aStateIDs.clear();
+    m_aNameIDs.clear();
+
+    std::vector<int> aInitialStates;
+
+    for (std::size_t i = 0; i < m_aExpressions.size(); i++)
+    {
+        Expression& aExpression = m_aExpressions.at(i);
+
+        aExpression.m_nFirstState = m_aExpressionStates.size();
+        aInitialStates.push_back(aExpression.m_nFirstState);
+
+        for (std::size_t j = 0; j <= aExpression.m_aSteps.size(); j++)
+        {
+            m_aExpressionStates.push_back(std::pair<std::size_t, std::size_t>(i, j));
+        }
+
+        for (std::vector<Step>::iterator iter = aExpression.m_aSteps.begin();
+             iter != aExpression.m_aSteps.end();
+             iter++)
+        {
+            if (iter->m_eType != STEP_ELEMENT ||
+                iter->m_strName == "*")
+            {
+                iter->m_nNameID = -1;
+                continue;
+            }
+
+            // Name ID 0 is for all names which don't occur in any expression.
+            std::unordered_map<std::string, int>::iterator iterName = m_aNameIDs.find(iter->m_strName);
+
+            if (iterName == m_aNameIDs.end())
+            {
+                iterName = m_aNameIDs.insert(std::pair<std::string, int>(iter->m_strName, m_aNameIDs.size() + 1)).first;
+            }
+
+            iter->m_nNameID = iterName->second;
+        }
+    }
+
+    // State 0 is the dead state, in which no expression can match anymore.
+    std::vector<int> aDeadStates;
+    GetState(aDeadStates);
+
+    m_nInitialState = GetState(aInitialStates);
+    m_bCompiled = true;
+}
+
+int XMLPathExtractor::GetState(std::vector<int>& aExpressionStates)
+{
+    std::sort(aExpressionStates.begin(), aExpressionStates.end());
+    aExpressionStates.erase(std::unique(aExpressionStates.begin(), aExpressionStates.end()), aExpressionStates.end());
+
+    std::map<std::vector<int>, int>::iterator iter = m_aStateIDs.find(aExpressionStates);
+
+    if (iter != m_aStateIDs.end())
+    {
+        return iter->second;
+    }
+
+    State aState;
+    aState.m_aExpressionStates = aExpressionStates;
+
+    Transition aTransition;
+    aTransition.m_nState = -1;
+    aTransition.m_bConditional = false;
+    aState.m_aTransitions.resize(m_aNameIDs.size() + 1, aTransition);
+
+    for (std::vector<int>::const_iterator iterState = aExpressionStates.begin();
+         iterState != aExpressionStates.end();
+         iterState++)
+    {
+        const std::pair<std::size_t, std::size_t>& aExpressionState = m_aExpressionStates.at(*iterState);
+        const std::vector<Step>& aSteps = m_aExpressions.at(aExpressionState.first).m_aSteps;
+
+        if (aExpressionState.second >= aSteps.size())
+        {
+            aState.m_aElementMatches.push_back(aExpressionState.first);
+        }
+        else if (aExpressionState.second + 1 == aSteps.size())
+        {
+            if (aSteps.back().m_eType == STEP_TEXT)
+            {
+                aState.m_aTextMatches.push_back(aExpressionState.first);
+            }
+            else if (aSteps.back().m_eType == STEP_ATTRIBUTE)
+            {
+                aState.m_aAttributeMatches.push_back(aExpressionState.first);
+            }
+        }
+    }
+
+    int nState = m_aStates.size();
+
+    m_aStates.push_back(aState);
+    m_aStateIDs.insert(std::pair<std::vector<int>, int>(aExpressionStates, nState));
+
+    return nState;
+}
+
+int XMLPathExtractor::GetNameID(const QName& aName)
+{
+    std::unordered_map<std::string, int>::const_iterator iter;
+
+    if (aName.getPrefix().empty() == true)
+    {
+        iter = m_aNameIDs.find(aName.getLocalPart());
+    }
+    else
+    {
+        iter = m_aNameIDs.find(aName.getPrefix() + ":" + aName.getLocalPart());
+    }
+
+    if (iter == m_aNameIDs.end())
+    {
+        return 0;
+    }
+
+    return iter->second;
+}
+
+/**
+ * @details Transitions which don't depend on predicates are computed
+ *     only once per state and name.
+ */
+int XMLPathExtractor::NextState(int nState, int nNameID, const StartElement& aStartElement)
+{
+    const Transition& aTransition = m_aStates.at(nState).m_aTransitions.at(nNameID);
+
+    if (aTransition.m_nState >= 0)
+    {
+        return aTransition.m_nState;
+    }
+
+    std::vector<int> aTargets;
+    bool bConditional = aTransition.m_bConditional;
+
+    if (bConditional != true)
+    {
+        CollectTargets(nState, nNameID, nullptr, aTargets, bConditional);
+
+        if (bConditional != true)
+        {
+            int nNextState = GetState(aTargets);
+            m_aStates.at(nState).m_aTransitions.at(nNameID).m_nState = nNextState;
+            return nNextState;
+        }
+
+        m_aStates.at(nState).m_aTransitions.at(nNameID).m_bConditional = true;
+        aTargets.clear();
+    }
+
+    CollectTargets(nState, nNameID, &aStartElement, aTargets, bConditional);
+
+    return GetState(aTargets);
+}
+
+/**
+ * @param[in] pStartElement If nullptr, bConditional gets set if a target
+ *     depends on predicates.
+ */
+void XMLPathExtractor::CollectTargets(int nState, int nNameID, const StartElement* pStartElement, std::vector<int>& aTargets, bool& bConditional)
+{
+    const std::vector<int>& aExpressionStates = m_aStates.at(nState).m_aExpressionStates;
+
+    for (std::vector<int>::const_iterator iter = aExpressionStates.begin();
+         iter != aExpressionStates.end();
+         iter++)
+    {
+        const std::pair<std::size_t, std::size_t>& aExpressionState = m_aExpressionStates.at(*iter);
+        const std::vector<Step>& aSteps = m_aExpressions.at(aExpressionState.first).m_aSteps;
+
+        if (aExpressionState.second >= aSteps.size())
+        {
+            continue;
+        }
+
+        const Step& aStep = aSteps.at(aExpressionState.second);
+
+        if (aStep.m_bDescendant == true)
+        {
+            // Stays active for deeper levels.
+            aTargets.push_back(*iter);
+        }
+
+        if (aStep.m_eType != STEP_ELEMENT)
+        {
+            continue;
+        }
+
+        if (aStep.m_nNameID >= 0 &&
+            aStep.m_nNameID != nNameID)
+        {
+            continue;
+        }
+
+        if (aStep.m_aPredicates.empty() != true)
+        {
+            bConditional = true;
+
+            if (pStartElement == nullptr ||
+                MatchesPredicates(aStep, *pStartElement) != true)
+            {
+                continue;
+            }
+        }
+
+        aTargets.push_back(*iter + 1);
+    }
+}
+
+bool XMLPathExtractor::MatchesPredicates(const Step& aStep, const StartElement& aStartElement)
+{
+    for (std::vector<Predicate>::const_iterator iter = aStep.m_aPredicates.begin();
+         iter != aStep.m_aPredicates.end();
+         iter++)
+    {
+        const std::shared_ptr<Attribute> pAttribute = FindAttribute(aStartElement, iter->m_strAttributeName);
+
+        if (pAttribute == nullptr)
+        {
+            return false;
+        }
+
+        if (iter->m_bHasValue == true &&
+            pAttribute->getValue() != iter->m_strValue)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @param[in] strName Attribute name, optionally with prefix.
+ * @retval nullptr In case the attribute couldn't be found.
+ */
+const std::shared_ptr<Attribute> XMLPathExtractor::FindAttribute(const StartElement& aStartElement, const std::string& strName)
+{
+    const std::shared_ptr<std::list<std::shared_ptr<Attribute>>> pAttributes = aStartElement.getAttributes();
+
+    for (std::list<std::shared_ptr<Attribute>>::const_iterator iter = pAttributes->begin();
+         iter != pAttributes->end();
+         iter++)
+    {
+        const QName& aName = (*iter)->getName();
+
+        if (aName.getPrefix().empty() == true)
+        {
+            if (aName.getLocalPart() == strName)
+            {
+                return *iter;
+            }
+        }
+        else if (strName.length() == aName.getPrefix().length() + 1 + aName.getLocalPart().length() &&
+                 strName.compare(0, aName.getPrefix().length(), aName.getPrefix()) == 0 &&
+                 strName.at(aName.getPrefix().length()) == ':' &&
+                 strName.compare(aName.getPrefix().length() + 1, std::string::npos, aName.getLocalPart()) == 0)
+        {
+            return *iter;
+        }
+    }
+
+    return nullptr;
+}
+
+}
@@ -0,0 +1,147 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLPathExtractor.h
+ * @brief Extracts the values of a set of path expressions in a single
+ *     pass over the events of a XMLEventReader.
+ * @details Supported is a small XPath subset: absolute location paths
+ *     of child ('/') and descendant ('//') steps with element names or
+ *     '*', attribute predicates like [@name] or [@name='value'], and
+ *     text() or @name as last step. All expressions are compiled into
+ *     one automaton over the element stack. Subtrees in which no
+ *     expression can match anymore are skipped with
+ *     XMLEventReader::skipElement().
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#ifndef _CPPSTAX_XMLPATHEXTRACTOR_H
+#define _CPPSTAX_XMLPATHEXTRACTOR_H
+
+#include "XMLEventReader.h"
+#include "StartElement.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <functional>
+
+namespace cppstax
+{
+
+class XMLPathExtractor
+{
+public:
+    /**
+     * @brief Gets called with the string value of a matched element (its
+     *     text including the text of its descendants), the data of a
+     *     matched text node or the value of a matched attribute.
+     */
+    typedef std::function<void(const std::string& strValue)> MatchCallback;
+
+public:
+    XMLPathExtractor();
+
+public:
+    int addExpression(const std::string& strExpression, const MatchCallback& aCallback);
+    int extract(XMLEventReader& aReader);
+
+protected:
+    enum StepType
+    {
+        STEP_ELEMENT,
+        STEP_TEXT,
+        STEP_ATTRIBUTE
+    };
+
+    struct Predicate
+    {
+        std::string m_strAttributeName;
+        bool m_bHasValue;
+        std::string m_strValue;
+    };
+
+    struct Step
+    {
+        bool m_bDescendant;
+        StepType m_eType;
+        /** Element or attribute name, "*" matches any element. */
+        std::string m_strName;
+        /** -1 for "*". */
+        int m_nNameID;
+        std::vector<Predicate> m_aPredicates;
+    };
+
+    struct Expression
+    {
+        std::vector<Step> m_aSteps;
+        MatchCallback m_aCallback;
+        /** ID of the automaton state for 0 steps matched. */
+        int m_nFirstState;
+    };
+
+    struct Transition
+    {
+        /** -1 if not computed yet. */
+        int m_nState;
+        /** If set, the target depends on predicates and needs to be
+          * evaluated for each element. */
+        bool m_bConditional;
+    };
+
+    /** A set of expression states, each meaning that the first n steps
+      * of an expression have matched. */
+    struct State
+    {
+        std::vector<int> m_aExpressionStates;
+        std::vector<Transition> m_aTransitions;
+        std::vector<std::size_t> m_aElementMatches;
+        std::vector<std::size_t> m_aTextMatches;
+        std::vector<std::size_t> m_aAttributeMatches;
+    };
+
+    struct Collector
+    {
+        std::size_t m_nExpression;
+        std::size_t m_nDepth;
+        std::string m_strValue;
+    };
+
+protected:
+    void Compile();
+    int GetState(std::vector<int>& aExpressionStates);
+    int GetNameID(const QName& aName);
+    int NextState(int nState, int nNameID, const StartElement& aStartElement);
+    void CollectTargets(int nState, int nNameID, const StartElement* pStartElement, std::vector<int>& aTargets, bool& bConditional);
+    bool MatchesPredicates(const Step& aStep, const StartElement& aStartElement);
+    const std::shared_ptr<Attribute> FindAttribute(const StartElement& aStartElement, const std::string& strName);
+
+protected:
+    std::vector<Expression> m_aExpressions;
+    /** Expression index and number of matched steps per expression state ID. */
+    std::vector<std::pair<std::size_t, std::size_t>> m_aExpressionStates;
+    std::vector<State> m_aStates;
+    std::map<std::vector<int>, int> m_aStateIDs;
+    std::unordered_map<std::string, int> m_aNameIDs;
+    int m_nInitialState;
+    bool m_bCompiled;
+
+};
+
+}
+
+#endif
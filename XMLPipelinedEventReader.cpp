@@ -0,0 +1,402 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLPipelinedEventReader.cpp
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#include "XMLPipelinedEventReader.h"
+#include <stdexcept>
+
+namespace cppstax
+{
+
+namespace
+{
+
+/** Batches in the ring, a power of 2. */
+const std::size_t RING_SIZE = 16;
+const std::size_t BATCH_SIZE = 128;
+/** Checks of the other side's counter before blocking. */
+const unsigned int SPIN_COUNT = 64;
+
+/** The reader whose parser thread is the current thread. */
+thread_local const XMLPipelinedEventReader* g_pParsingReader = nullptr;
+
+}
+
+XMLPipelinedEventReader::XMLPipelinedEventReader(std::istream& aStream):
+  XMLEventReader(aStream),
+  m_aRing(RING_SIZE),
+  m_nHead(0),
+  m_nTail(0),
+  m_bDone(false),
+  m_bStopping(false),
+  m_bProducerWaiting(false),
+  m_bConsumerWaiting(false),
+  m_pException(nullptr),
+  m_bThreadStarted(false),
+  m_nEvent(0),
+  m_bBatchHeld(false),
+  m_bStartElementDelivered(false)
+{
+
+}
+
+XMLPipelinedEventReader::XMLPipelinedEventReader(std::unique_ptr<std::streambuf> pBuffer):
+  XMLEventReader(std::move(pBuffer)),
+  m_aRing(RING_SIZE),
+  m_nHead(0),
+  m_nTail(0),
+  m_bDone(false),
+  m_bStopping(false),
+  m_bProducerWaiting(false),
+  m_bConsumerWaiting(false),
+  m_pException(nullptr),
+  m_bThreadStarted(false),
+  m_nEvent(0),
+  m_bBatchHeld(false),
+  m_bStartElementDelivered(false)
+{
+
+}
+
+/**
+ * @details If the parser thread is blocked reading the stream, this waits
+ *     for the read to return.
+ */
+XMLPipelinedEventReader::~XMLPipelinedEventReader()
+{
+    if (m_bThreadStarted == true)
+    {
+        m_bStopping = true;
+        Wake();
+        m_aThread.join();
+    }
+}
+
+/**
+ * @brief Stops the parser thread, which gets started again for the next
+ *     document. The batches keep their capacity.
+ */
+void XMLPipelinedEventReader::Reset(std::streambuf* pBuffer)
+{
+    if (m_bThreadStarted == true)
+    {
+        m_bStopping = true;
+        Wake();
+        m_aThread.join();
+        m_bThreadStarted = false;
+    }
+
+    XMLEventReader::Reset(pBuffer);
+
+    for (std::vector<Batch>::iterator iter = m_aRing.begin();
+         iter != m_aRing.end();
+         iter++)
+    {
+        iter->clear();
+    }
+
+    m_nHead = 0;
+    m_nTail = 0;
+    m_bDone = false;
+    m_bStopping = false;
+    m_bProducerWaiting = false;
+    m_bConsumerWaiting = false;
+    m_pException = nullptr;
+    m_nEvent = 0;
+    m_bBatchHeld = false;
+    m_bStartElementDelivered = false;
+}
+
+bool XMLPipelinedEventReader::hasNext()
+{
+    if (m_bThreadStarted != true)
+    {
+        m_bThreadStarted = true;
+        m_aThread = std::thread(&XMLPipelinedEventReader::Produce, this);
+    }
+
+    while (true)
+    {
+        if (m_bBatchHeld == true)
+        {
+            Batch& aBatch = m_aRing[m_nTail.load(std::memory_order_relaxed) & (RING_SIZE - 1)];
+
+            if (m_nEvent < aBatch.size())
+            {
+                return true;
+            }
+
+            aBatch.clear();
+            m_nEvent = 0;
+            m_bBatchHeld = false;
+            m_nTail.store(m_nTail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            Wake();
+        }
+
+        if (WaitForBatch() != true)
+        {
+            if (m_pException != nullptr)
+            {
+                std::exception_ptr pException = m_pException;
+                m_pException = nullptr;
+                std::rethrow_exception(pException);
+            }
+
+            return false;
+        }
+
+        m_bBatchHeld = true;
+    }
+}
+
+std::unique_ptr<XMLEvent> XMLPipelinedEventReader::nextEvent()
+{
+    if (hasNext() != true)
+    {
+        throw new std::logic_error("Attempted XMLPipelinedEventReader::nextEvent() while there isn't one instead of checking XMLPipelinedEventReader::hasNext() first.");
+    }
+
+    Batch& aBatch = m_aRing[m_nTail.load(std::memory_order_relaxed) & (RING_SIZE - 1)];
+    std::unique_ptr<XMLEvent> pEvent(new XMLEvent(std::move(aBatch[m_nEvent])));
+    ++m_nEvent;
+
+    m_bStartElementDelivered = pEvent->isStartElement();
+
+    return pEvent;
+}
+
+/**
+ * @brief Moves the events already constructed by the parser thread out
+ *     of their storage.
+ */
+std::size_t XMLPipelinedEventReader::nextEvents(std::vector<XMLEvent>& aEvents, std::size_t nMax)
+{
+    aEvents.clear();
+
+    while (aEvents.size() < nMax &&
+           hasNext() == true)
+    {
+        aEvents.push_back(std::move(m_aRing[m_nTail.load(std::memory_order_relaxed) & (RING_SIZE - 1)][m_nEvent]));
+        ++m_nEvent;
+    }
+
+    m_bStartElementDelivered = aEvents.size() > 0 && aEvents.back().isStartElement() == true;
+
+    return aEvents.size();
+}
+
+/**
+ * @brief Other than XMLEventReader::skipElement(), the events of the
+ *     subtree were constructed by the parser thread anyway and are just
+ *     dropped here.
+ */
+bool XMLPipelinedEventReader::skipElement()
+{
+    if (m_bStartElementDelivered != true)
+    {
+        throw new std::logic_error("Attempted XMLPipelinedEventReader::skipElement() without XMLPipelinedEventReader::nextEvent() having returned a StartElement.");
+    }
+
+    m_bStartElementDelivered = false;
+
+    unsigned int nDepth = 1;
+
+    while (nDepth > 0 &&
+           hasNext() == true)
+    {
+        XMLEvent& aEvent = m_aRing[m_nTail.load(std::memory_order_relaxed) & (RING_SIZE - 1)][m_nEvent];
+
+        if (aEvent.isStartElement() == true)
+        {
+            ++nDepth;
+        }
+        else if (aEvent.isEndElement() == true)
+        {
+            --nDepth;
+        }
+
+        ++m_nEvent;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Unknown on the caller's thread. The base XMLEventReader on the
+ *     parser thread gets its read position for errors.
+ */
+Location XMLPipelinedEventReader::getLocation()
+{
+    if (g_pParsingReader == this)
+    {
+        return XMLEventReader::getLocation();
+    }
+
+    return Location();
+}
+
+/**
+ * @brief Runs on the parser thread, the base XMLEventReader is only used
+ *     from here.
+ */
+void XMLPipelinedEventReader::Produce()
+{
+    g_pParsingReader = this;
+
+    try
+    {
+        while (XMLEventReader::hasNext() == true)
+        {
+            m_aRing[m_nHead.load(std::memory_order_relaxed) & (RING_SIZE - 1)].push_back(std::move(FrontEvent()));
+            PopEvent();
+            m_bHasNextCalled = false;
+
+            // A partial batch is published as well if the next read might
+            // block, so the consumer doesn't wait for slow input.
+            if (m_aRing[m_nHead.load(std::memory_order_relaxed) & (RING_SIZE - 1)].size() >= BATCH_SIZE ||
+                (m_aScanner.hasBufferedInput() != true &&
+                 m_aStream.rdbuf()->in_avail() <= 0))
+            {
+                if (Publish() != true)
+                {
+                    return;
+                }
+            }
+        }
+    }
+    catch (...)
+    {
+        m_pException = std::current_exception();
+    }
+
+    if (m_aRing[m_nHead.load(std::memory_order_relaxed) & (RING_SIZE - 1)].empty() != true)
+    {
+        if (Publish() != true)
+        {
+            return;
+        }
+    }
+
+    m_bDone.store(true, std::memory_order_release);
+    Wake();
+}
+
+/**
+ * @brief Hands the batch being filled to the consumer and waits for the
+ *     next one to be free.
+ * @retval false if the reader is being destroyed.
+ */
+bool XMLPipelinedEventReader::Publish()
+{
+    std::size_t nHead = m_nHead.load(std::memory_order_relaxed) + 1;
+    m_nHead.store(nHead, std::memory_order_release);
+    Wake();
+
+    unsigned int nSpin = 0;
+
+    while (nHead - m_nTail.load(std::memory_order_acquire) >= RING_SIZE)
+    {
+        if (m_bStopping == true)
+        {
+            return false;
+        }
+
+        if (nSpin < SPIN_COUNT)
+        {
+            ++nSpin;
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> aLock(m_aMutex);
+        m_bProducerWaiting = true;
+
+        while (m_bStopping != true &&
+               nHead - m_nTail.load() >= RING_SIZE)
+        {
+            m_aCondition.wait(aLock);
+        }
+
+        m_bProducerWaiting = false;
+    }
+
+    return m_bStopping != true;
+}
+
+/**
+ * @retval false if the parser thread is done and all batches were consumed.
+ */
+bool XMLPipelinedEventReader::WaitForBatch()
+{
+    std::size_t nTail = m_nTail.load(std::memory_order_relaxed);
+    unsigned int nSpin = 0;
+
+    while (m_nHead.load(std::memory_order_acquire) == nTail)
+    {
+        if (m_bDone.load(std::memory_order_acquire) == true)
+        {
+            // The last batch might have been published just before.
+            return m_nHead.load(std::memory_order_acquire) != nTail;
+        }
+
+        if (nSpin < SPIN_COUNT)
+        {
+            ++nSpin;
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> aLock(m_aMutex);
+        m_bConsumerWaiting = true;
+
+        while (m_nHead.load() == nTail &&
+               m_bDone.load() != true)
+        {
+            m_aCondition.wait(aLock);
+        }
+
+        m_bConsumerWaiting = false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Wakes the other side if it's blocked. A side sets its waiting
+ *     flag before checking the counters under the mutex, so either it
+ *     sees the update or it gets notified. The flags are separate, as a
+ *     side waking up must not clear the flag of the other side still
+ *     blocked.
+ */
+void XMLPipelinedEventReader::Wake()
+{
+    // The counter update must not be ordered behind the check.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (m_bProducerWaiting == true ||
+        m_bConsumerWaiting == true)
+    {
+        std::lock_guard<std::mutex> aLock(m_aMutex);
+        m_aCondition.notify_all();
+    }
+}
+
+}
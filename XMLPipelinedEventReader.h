@@ -0,0 +1,104 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLPipelinedEventReader.h
+ * @brief Parses on a thread of its own while the caller consumes events.
+ * @details The parser thread collects events into batches and publishes
+ *     them into a bounded ring, which hasNext() and nextEvent() drain on
+ *     the caller's thread. The ring has a single producer and a single
+ *     consumer and is synchronized by the two batch counters alone; a
+ *     side only blocks when the ring is full (back-pressure on the
+ *     parser) or empty. The batch vectors stay in the ring and keep their
+ *     capacity, so no storage gets allocated for batches once the ring
+ *     went round once. An exception of the parser thread is thrown by
+ *     hasNext() after the events in front of it were delivered.
+ *     Options need to be set before reading starts. getLocation() isn't
+ *     available, as the read position belongs to the parser thread, but
+ *     events carry their Location as usual.
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#ifndef _CPPSTAX_XMLPIPELINEDEVENTREADER_H
+#define _CPPSTAX_XMLPIPELINEDEVENTREADER_H
+
+#include "XMLEventReader.h"
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <cstddef>
+
+namespace cppstax
+{
+
+class XMLPipelinedEventReader : public XMLEventReader
+{
+public:
+    XMLPipelinedEventReader(std::istream& aStream);
+    XMLPipelinedEventReader(std::unique_ptr<std::streambuf> pBuffer);
+    virtual ~XMLPipelinedEventReader();
+
+    virtual bool hasNext();
+    virtual std::unique_ptr<XMLEvent> nextEvent();
+    virtual std::size_t nextEvents(std::vector<XMLEvent>& aEvents, std::size_t nMax);
+    virtual bool skipElement();
+
+public:
+    virtual Location getLocation();
+
+protected:
+    typedef std::vector<XMLEvent> Batch;
+
+protected:
+    virtual void Reset(std::streambuf* pBuffer);
+    void Produce();
+    bool Publish();
+    bool WaitForBatch();
+    void Wake();
+
+protected:
+    std::vector<Batch> m_aRing;
+    /** Batches published by the parser thread. */
+    std::atomic<std::size_t> m_nHead;
+    char m_aHeadPadding[64];
+    /** Batches released by the consumer. */
+    std::atomic<std::size_t> m_nTail;
+    char m_aTailPadding[64];
+    std::atomic<bool> m_bDone;
+    std::atomic<bool> m_bStopping;
+    /** Set by either side while it's blocked on m_aCondition, each side
+      * clearing only its own. */
+    std::atomic<bool> m_bProducerWaiting;
+    std::atomic<bool> m_bConsumerWaiting;
+    std::exception_ptr m_pException;
+    std::mutex m_aMutex;
+    std::condition_variable m_aCondition;
+    std::thread m_aThread;
+    bool m_bThreadStarted;
+    /** Position in the front batch, which the consumer holds if set. */
+    std::size_t m_nEvent;
+    bool m_bBatchHeld;
+    bool m_bStartElementDelivered;
+
+};
+
+}
+
+#endif
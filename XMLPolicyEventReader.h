@@ -0,0 +1,152 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLPolicyEventReader.h
+ * @brief XMLEventReader with the features of its XMLScanner selected by
+ *     a policy at compile time, see XMLParserPolicy.h.
+ * @details The events are built by the same EventBuilder as those of
+ *     XMLEventReader. The policy decides about location tracking,
+ *     setLocationTracking() only accepts the same setting. The ignore
+ *     options of XMLEventReader apply in addition to the policy, multiple
+ *     documents mode, source ranges and the entity replacement dictionary
+ *     work as usual.
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#ifndef _CPPSTAX_XMLPOLICYEVENTREADER_H
+#define _CPPSTAX_XMLPOLICYEVENTREADER_H
+
+#include "XMLEventReader.h"
+#include "XMLScanner.h"
+#include "XMLParserPolicy.h"
+#include <stdexcept>
+
+namespace cppstax
+{
+
+template<class Policy>
+class XMLPolicyEventReader : public XMLEventReader
+{
+public:
+    XMLPolicyEventReader(std::istream& aStream);
+    XMLPolicyEventReader(std::unique_ptr<std::streambuf> pBuffer);
+    virtual ~XMLPolicyEventReader();
+
+    virtual bool skipElement();
+    virtual void restoreDefaults();
+
+public:
+    virtual void setLocationTracking(bool bLocationTracking);
+    virtual Location getLocation();
+
+protected:
+    virtual bool ReadEvents();
+    virtual void Reset(std::streambuf* pBuffer);
+    virtual bool IsScannedInput(const XMLSpan& aSpan) const;
+
+protected:
+    XMLScanner<Policy, EventBuilder> m_aPolicyScanner;
+
+};
+
+template<class Policy>
+XMLPolicyEventReader<Policy>::XMLPolicyEventReader(std::istream& aStream):
+  XMLEventReader(aStream),
+  m_aPolicyScanner(m_aBuilder)
+{
+    m_aPolicyScanner.setEntityReplacementDictionary(&m_aEntityReplacementDictionary);
+    m_bLocationTracking = Policy::LOCATION_TRACKING;
+}
+
+template<class Policy>
+XMLPolicyEventReader<Policy>::XMLPolicyEventReader(std::unique_ptr<std::streambuf> pBuffer):
+  XMLEventReader(std::move(pBuffer)),
+  m_aPolicyScanner(m_aBuilder)
+{
+    m_aPolicyScanner.setEntityReplacementDictionary(&m_aEntityReplacementDictionary);
+    m_bLocationTracking = Policy::LOCATION_TRACKING;
+}
+
+template<class Policy>
+XMLPolicyEventReader<Policy>::~XMLPolicyEventReader()
+{
+
+}
+
+template<class Policy>
+bool XMLPolicyEventReader<Policy>::ReadEvents()
+{
+    return ScanEvents(m_aPolicyScanner);
+}
+
+template<class Policy>
+void XMLPolicyEventReader<Policy>::Reset(std::streambuf* pBuffer)
+{
+    XMLEventReader::Reset(pBuffer);
+    m_aPolicyScanner.setInput(nullptr, 0);
+}
+
+template<class Policy>
+bool XMLPolicyEventReader<Policy>::IsScannedInput(const XMLSpan& aSpan) const
+{
+    return m_aPolicyScanner.isInput(aSpan);
+}
+
+template<class Policy>
+bool XMLPolicyEventReader<Policy>::skipElement()
+{
+    return SkipScannedElement(m_aPolicyScanner);
+}
+
+/**
+ * @brief Location tracking stays as the policy has it.
+ */
+template<class Policy>
+void XMLPolicyEventReader<Policy>::restoreDefaults()
+{
+    XMLEventReader::restoreDefaults();
+    m_bLocationTracking = Policy::LOCATION_TRACKING;
+}
+
+/**
+ * @brief Location tracking is fixed by Policy::LOCATION_TRACKING, only
+ *     the same setting is accepted.
+ */
+template<class Policy>
+void XMLPolicyEventReader<Policy>::setLocationTracking(bool bLocationTracking)
+{
+    if (bLocationTracking != Policy::LOCATION_TRACKING)
+    {
+        throw new std::logic_error("Location tracking of XMLPolicyEventReader is fixed by its policy.");
+    }
+}
+
+template<class Policy>
+Location XMLPolicyEventReader<Policy>::getLocation()
+{
+    if (Policy::LOCATION_TRACKING != true)
+    {
+        return Location();
+    }
+
+    return m_aPolicyScanner.getLocation();
+}
+
+}
+
+#endif
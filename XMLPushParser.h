@@ -0,0 +1,149 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLPushParser.h
+ * @brief Parses a document by calling into a handler directly, without
+ *     constructing any events.
+ * @details parse() instantiates a XMLScanner for the type of the handler,
+ *     which usually derives from XMLContentHandler, so the callbacks can
+ *     get inlined into the scanning loop. The Policy selects the features,
+ *     see XMLParserPolicy.h. The scanner is the same XMLEventReader
+ *     builds its events with.
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#ifndef _CPPSTAX_XMLPUSHPARSER_H
+#define _CPPSTAX_XMLPUSHPARSER_H
+
+#include "XMLScanner.h"
+#include "XMLParserPolicy.h"
+#include "XMLContentHandler.h"
+#include "XMLStreamError.h"
+#include <istream>
+#include <streambuf>
+#include <string>
+#include <map>
+#include <stdexcept>
+#include <cstddef>
+
+namespace cppstax
+{
+
+template<class Policy = XMLDefaultPolicy>
+class XMLPushParser
+{
+public:
+    XMLPushParser();
+
+public:
+    int addToEntityReplacementDictionary(const std::string& strName, const std::string& strReplacementText);
+    template<class Handler>
+    bool parse(const char* pData, std::size_t nLength, Handler& aHandler);
+    template<class Handler>
+    bool parse(std::istream& aStream, Handler& aHandler);
+    const XMLStreamError& getError() const;
+
+protected:
+    std::map<std::string, std::string> m_aEntityReplacementDictionary;
+    XMLStreamError m_aError;
+
+};
+
+template<class Policy>
+XMLPushParser<Policy>::XMLPushParser()
+{
+
+}
+
+/**
+ * @brief Same as XMLEventReader::addToEntityReplacementDictionary(), only
+ *     used for Policy::ENTITY_RESOLUTION.
+ */
+template<class Policy>
+int XMLPushParser<Policy>::addToEntityReplacementDictionary(const std::string& strName, const std::string& strReplacementText)
+{
+    if (strName == "amp" ||
+        strName == "lt" ||
+        strName == "gt" ||
+        strName == "apos" ||
+        strName == "quot")
+    {
+        throw new std::invalid_argument("Redefinition of built-in entity.");
+    }
+
+    m_aEntityReplacementDictionary[strName] = strReplacementText;
+    return 0;
+}
+
+/**
+ * @brief Reports the nLength bytes at pData to aHandler.
+ * @retval true if all of the input was parsed, false with getError()
+ *     telling the error otherwise. Callbacks up to the error were made.
+ */
+template<class Policy>
+template<class Handler>
+bool XMLPushParser<Policy>::parse(const char* pData, std::size_t nLength, Handler& aHandler)
+{
+    XMLScanner<Policy, Handler> aScanner(aHandler);
+
+    aScanner.setEntityReplacementDictionary(&m_aEntityReplacementDictionary);
+    aScanner.setInput(pData, nLength);
+
+    bool bResult = aScanner.scan();
+    m_aError = aScanner.getError();
+
+    return bResult;
+}
+
+/**
+ * @brief Same as parse() for input in memory, aStream gets read a block
+ *     at a time while scanning.
+ */
+template<class Policy>
+template<class Handler>
+bool XMLPushParser<Policy>::parse(std::istream& aStream, Handler& aHandler)
+{
+    std::streambuf* pSource = aStream.rdbuf();
+
+    if (aStream.good() != true ||
+        pSource == nullptr)
+    {
+        m_aError = XMLStreamError(XMLStreamError::ERROR_STREAM_BAD, Location());
+        return false;
+    }
+
+    XMLScanner<Policy, Handler> aScanner(aHandler);
+
+    aScanner.setEntityReplacementDictionary(&m_aEntityReplacementDictionary);
+    aScanner.setSource(pSource);
+
+    bool bResult = aScanner.scan();
+    m_aError = aScanner.getError();
+
+    return bResult;
+}
+
+template<class Policy>
+const XMLStreamError& XMLPushParser<Policy>::getError() const
+{
+    return m_aError;
+}
+
+}
+
+#endif
@@ -0,0 +1,482 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLReplayEventReader.cpp
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#include "XMLReplayEventReader.h"
+#include "XMLEventRecorder.h"
+#include <stdexcept>
+#include <cstring>
+
+namespace cppstax
+{
+
+namespace
+{
+
+/** Strings are read in pieces of this size, so a corrupted length can't
+  * allocate more than the recording holds. */
+const std::size_t READ_BLOCK_SIZE = 65536;
+
+}
+
+XMLReplayEventReader::XMLReplayEventReader(std::istream& aStream):
+  XMLEventReader(aStream),
+  m_bHeaderRead(false)
+{
+
+}
+
+XMLReplayEventReader::XMLReplayEventReader(std::unique_ptr<std::streambuf> pBuffer):
+  XMLEventReader(std::move(pBuffer)),
+  m_bHeaderRead(false)
+{
+
+}
+
+XMLReplayEventReader::~XMLReplayEventReader()
+{
+
+}
+
+/**
+ * @brief Same as XMLEventReader::skipElement(), the records of the subtree
+ *     are decoded without constructing events for them.
+ */
+bool XMLReplayEventReader::skipElement()
+{
+    if (m_bStartElementReturned != true)
+    {
+        throw new std::logic_error("Attempted XMLEventReader::skipElement() without XMLEventReader::nextEvent() having returned a StartElement.");
+    }
+
+    m_bStartElementReturned = false;
+    m_bHasNextCalled = false;
+
+    unsigned int nDepth = 1;
+
+    while (m_nEventCount > 0)
+    {
+        if (FrontEvent().isStartElement() == true)
+        {
+            ++nDepth;
+        }
+        else if (FrontEvent().isEndElement() == true)
+        {
+            --nDepth;
+        }
+
+        PopEvent();
+
+        if (nDepth <= 0)
+        {
+            return true;
+        }
+    }
+
+    if (m_aError.getCode() != XMLStreamError::ERROR_NONE)
+    {
+        return false;
+    }
+
+    std::streambuf* pSource = m_aStream.rdbuf();
+    std::size_t nNumber = 0;
+
+    while (nDepth > 0)
+    {
+        std::streambuf::int_type nType = pSource->sbumpc();
+
+        if (nType == std::streambuf::traits_type::eof())
+        {
+            return Fail(XMLStreamError::ERROR_SKIPPED_ELEMENT_INCOMPLETE);
+        }
+
+        switch (nType)
+        {
+        case XMLEventRecorder::RECORD_NAME:
+            if (ReadName() != true)
+            {
+                return false;
+            }
+
+            break;
+        case XMLEventRecorder::RECORD_START_ELEMENT:
+            if (ReadNameID(nNumber) != true ||
+                ReadNumber(nNumber) != true)
+            {
+                return false;
+            }
+
+            for (std::size_t nAttributeCount = nNumber; nAttributeCount > 0; nAttributeCount--)
+            {
+                if (ReadNameID(nNumber) != true ||
+                    ReadString(m_strSkipped) != true)
+                {
+                    return false;
+                }
+            }
+
+            ++nDepth;
+            break;
+        case XMLEventRecorder::RECORD_END_ELEMENT:
+            if (ReadNameID(nNumber) != true)
+            {
+                return false;
+            }
+
+            --nDepth;
+            break;
+        case XMLEventRecorder::RECORD_CHARACTERS:
+        case XMLEventRecorder::RECORD_COMMENT:
+            if (ReadString(m_strSkipped) != true)
+            {
+                return false;
+            }
+
+            break;
+        case XMLEventRecorder::RECORD_PROCESSING_INSTRUCTION:
+            if (ReadString(m_strSkipped) != true ||
+                ReadString(m_strSkipped) != true)
+            {
+                return false;
+            }
+
+            break;
+        case XMLEventRecorder::RECORD_START_DOCUMENT:
+        case XMLEventRecorder::RECORD_END_DOCUMENT:
+            break;
+        default:
+            return Fail(XMLStreamError::ERROR_RECORDING_MALFORMED);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Decodes records until there's at least one event in the queue.
+ */
+bool XMLReplayEventReader::ReadEvents()
+{
+    m_bStarted = true;
+
+    if (m_aError.getCode() != XMLStreamError::ERROR_NONE)
+    {
+        return false;
+    }
+
+    if (m_bHeaderRead != true)
+    {
+        if (ReadHeader() != true)
+        {
+            return false;
+        }
+    }
+
+    std::streambuf* pSource = m_aStream.rdbuf();
+
+    do
+    {
+        std::streambuf::int_type nType = pSource->sbumpc();
+
+        if (nType == std::streambuf::traits_type::eof())
+        {
+            return false;
+        }
+
+        switch (nType)
+        {
+        case XMLEventRecorder::RECORD_NAME:
+            if (ReadName() != true)
+            {
+                return false;
+            }
+
+            break;
+        case XMLEventRecorder::RECORD_START_ELEMENT:
+            if (ReadStartElement() != true)
+            {
+                return false;
+            }
+
+            break;
+        case XMLEventRecorder::RECORD_END_ELEMENT:
+            {
+                std::size_t nNameID = 0;
+
+                if (ReadNameID(nNameID) != true)
+                {
+                    return false;
+                }
+
+                std::unique_ptr<QName> pName(new QName(m_aNames[nNameID]));
+                std::unique_ptr<EndElement> pEndElement(new EndElement(std::move(pName)));
+                PushSlot(XMLEvent(nullptr,
+                                  std::move(pEndElement),
+                                  nullptr,
+                                  nullptr,
+                                  nullptr));
+            }
+
+            break;
+        case XMLEventRecorder::RECORD_CHARACTERS:
+            {
+                std::unique_ptr<std::string> pData(new std::string);
+
+                if (ReadString(*pData) != true)
+                {
+                    return false;
+                }
+
+                if (m_bIgnoreWhitespace == true &&
+                    IsWhitespace(*pData) == true)
+                {
+                    break;
+                }
+
+                std::unique_ptr<Characters> pCharacters(new Characters(std::move(pData)));
+                PushSlot(XMLEvent(nullptr,
+                                  nullptr,
+                                  std::move(pCharacters),
+                                  nullptr,
+                                  nullptr));
+            }
+
+            break;
+        case XMLEventRecorder::RECORD_COMMENT:
+            {
+                std::unique_ptr<std::string> pText(new std::string);
+
+                if (ReadString(*pText) != true)
+                {
+                    return false;
+                }
+
+                if (m_bIgnoreComments == true)
+                {
+                    break;
+                }
+
+                std::unique_ptr<Comment> pComment(new Comment(std::move(pText)));
+                PushSlot(XMLEvent(nullptr,
+                                  nullptr,
+                                  nullptr,
+                                  std::move(pComment),
+                                  nullptr));
+            }
+
+            break;
+        case XMLEventRecorder::RECORD_PROCESSING_INSTRUCTION:
+            {
+                std::unique_ptr<std::string> pTarget(new std::string);
+                std::unique_ptr<std::string> pData(new std::string);
+
+                if (ReadString(*pTarget) != true ||
+                    ReadString(*pData) != true)
+                {
+                    return false;
+                }
+
+                if (m_bIgnoreProcessingInstructions == true)
+                {
+                    break;
+                }
+
+                std::unique_ptr<ProcessingInstruction> pProcessingInstruction(new ProcessingInstruction(std::move(pTarget), std::move(pData)));
+                PushSlot(XMLEvent(nullptr,
+                                  nullptr,
+                                  nullptr,
+                                  nullptr,
+                                  std::move(pProcessingInstruction)));
+            }
+
+            break;
+        case XMLEventRecorder::RECORD_START_DOCUMENT:
+            PushSlot(XMLEvent(std::unique_ptr<StartDocument>(new StartDocument)));
+            break;
+        case XMLEventRecorder::RECORD_END_DOCUMENT:
+            PushSlot(XMLEvent(std::unique_ptr<EndDocument>(new EndDocument)));
+            break;
+        default:
+            return Fail(XMLStreamError::ERROR_RECORDING_MALFORMED);
+        }
+
+    } while (m_nEventCount <= 0);
+
+    return true;
+}
+
+/**
+ * @brief The names are defined anew by the next recording.
+ */
+void XMLReplayEventReader::Reset(std::streambuf* pBuffer)
+{
+    XMLEventReader::Reset(pBuffer);
+
+    m_bHeaderRead = false;
+    m_aNames.clear();
+}
+
+bool XMLReplayEventReader::ReadHeader()
+{
+    char aHeader[sizeof(XMLEventRecorder::HEADER)];
+
+    if (m_aStream.rdbuf()->sgetn(aHeader, sizeof(aHeader)) != static_cast<std::streamsize>(sizeof(aHeader)) ||
+        std::memcmp(aHeader, XMLEventRecorder::HEADER, sizeof(aHeader)) != 0)
+    {
+        return Fail(XMLStreamError::ERROR_RECORDING_MALFORMED);
+    }
+
+    m_bHeaderRead = true;
+
+    return true;
+}
+
+bool XMLReplayEventReader::ReadName()
+{
+    std::string strNamespaceURI;
+    std::string strLocalPart;
+    std::string strPrefix;
+
+    if (ReadString(strNamespaceURI) != true ||
+        ReadString(strLocalPart) != true ||
+        ReadString(strPrefix) != true)
+    {
+        return false;
+    }
+
+    m_aNames.push_back(QName(strNamespaceURI, strLocalPart, strPrefix));
+
+    return true;
+}
+
+bool XMLReplayEventReader::ReadStartElement()
+{
+    std::size_t nNameID = 0;
+    std::size_t nAttributeCount = 0;
+
+    if (ReadNameID(nNameID) != true ||
+        ReadNumber(nAttributeCount) != true)
+    {
+        return false;
+    }
+
+    std::unique_ptr<std::list<std::unique_ptr<Attribute>>> pAttributes(new std::list<std::unique_ptr<Attribute>>);
+
+    for (; nAttributeCount > 0; nAttributeCount--)
+    {
+        std::size_t nAttributeNameID = 0;
+        std::unique_ptr<std::string> pValue(new std::string);
+
+        if (ReadNameID(nAttributeNameID) != true ||
+            ReadString(*pValue) != true)
+        {
+            return false;
+        }
+
+        std::unique_ptr<QName> pAttributeName(new QName(m_aNames[nAttributeNameID]));
+        pAttributes->push_back(std::unique_ptr<Attribute>(new Attribute(std::move(pAttributeName), std::move(pValue))));
+    }
+
+    std::unique_ptr<QName> pName(new QName(m_aNames[nNameID]));
+    std::unique_ptr<StartElement> pStartElement(new StartElement(std::move(pName), std::move(pAttributes)));
+    PushSlot(XMLEvent(std::move(pStartElement),
+                      nullptr,
+                      nullptr,
+                      nullptr,
+                      nullptr));
+
+    return true;
+}
+
+/**
+ * @brief Reads a name ID, which needs to be defined already.
+ */
+bool XMLReplayEventReader::ReadNameID(std::size_t& nNameID)
+{
+    if (ReadNumber(nNameID) != true)
+    {
+        return false;
+    }
+
+    if (nNameID >= m_aNames.size())
+    {
+        return Fail(XMLStreamError::ERROR_RECORDING_MALFORMED);
+    }
+
+    return true;
+}
+
+bool XMLReplayEventReader::ReadNumber(std::size_t& nNumber)
+{
+    std::streambuf* pSource = m_aStream.rdbuf();
+
+    nNumber = 0;
+
+    for (unsigned int nShift = 0; nShift < sizeof(std::size_t) * 8; nShift += 7)
+    {
+        std::streambuf::int_type nByte = pSource->sbumpc();
+
+        if (nByte == std::streambuf::traits_type::eof())
+        {
+            return Fail(XMLStreamError::ERROR_RECORDING_MALFORMED);
+        }
+
+        nNumber |= static_cast<std::size_t>(nByte & 0x7F) << nShift;
+
+        if ((nByte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+
+    return Fail(XMLStreamError::ERROR_RECORDING_MALFORMED);
+}
+
+bool XMLReplayEventReader::ReadString(std::string& strText)
+{
+    std::size_t nLength = 0;
+
+    if (ReadNumber(nLength) != true)
+    {
+        return false;
+    }
+
+    strText.clear();
+
+    while (nLength > 0)
+    {
+        std::size_t nBlock = nLength < READ_BLOCK_SIZE ? nLength : READ_BLOCK_SIZE;
+        std::size_t nOffset = strText.length();
+
+        strText.resize(nOffset + nBlock);
+
+        if (m_aStream.rdbuf()->sgetn(&strText[nOffset], nBlock) != static_cast<std::streamsize>(nBlock))
+        {
+            return Fail(XMLStreamError::ERROR_RECORDING_MALFORMED);
+        }
+
+        nLength -= nBlock;
+    }
+
+    return true;
+}
+
+}
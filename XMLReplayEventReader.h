@@ -0,0 +1,74 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLReplayEventReader.h
+ * @brief Reads the events recorded by XMLEventRecorder back.
+ * @details No markup needs to be tokenized, the records only get
+ *     decoded into the events, so a recording can be read again several
+ *     times faster than the XML it was made of, and consumers can be
+ *     measured without the cost of the parser. The ignore options apply
+ *     to the replayed events as well. StartDocument and EndDocument are
+ *     replayed as recorded, independent of the multiple documents mode,
+ *     so a document comes out empty if all of its events are ignored.
+ *     Events don't carry a Location.
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#ifndef _CPPSTAX_XMLREPLAYEVENTREADER_H
+#define _CPPSTAX_XMLREPLAYEVENTREADER_H
+
+#include "XMLEventReader.h"
+#include <vector>
+#include <cstddef>
+
+namespace cppstax
+{
+
+class XMLReplayEventReader : public XMLEventReader
+{
+public:
+    XMLReplayEventReader(std::istream& aStream);
+    XMLReplayEventReader(std::unique_ptr<std::streambuf> pBuffer);
+    virtual ~XMLReplayEventReader();
+
+    virtual bool skipElement();
+
+protected:
+    virtual bool ReadEvents();
+    virtual void Reset(std::streambuf* pBuffer);
+
+protected:
+    bool ReadHeader();
+    bool ReadName();
+    bool ReadStartElement();
+    bool ReadNameID(std::size_t& nNameID);
+    bool ReadNumber(std::size_t& nNumber);
+    bool ReadString(std::string& strText);
+
+protected:
+    bool m_bHeaderRead;
+    /** Names by ID, as defined by the RECORD_NAME records so far. */
+    std::vector<QName> m_aNames;
+    /** Reused for strings which are skipped. */
+    std::string m_strSkipped;
+
+};
+
+}
+
+#endif
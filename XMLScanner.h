@@ -0,0 +1,1805 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLScanner.h
+ * @brief The parser of all the readers, with its features selected at
+ *     compile time by a policy, see XMLParserPolicy.h.
+ * @details XMLEventReader builds its events from what a scanner of
+ *     XMLDefaultPolicy reports, XMLStructuralEventReader from one of
+ *     XMLStructuralPolicy, XMLPolicyEventReader from a scanner of another
+ *     policy, and XMLPushParser, XMLDecoder and XMLValidator hand
+ *     it handlers of their own. The input is either in memory
+ *     (setInput()) or read a block at a time from a stream buffer
+ *     (setSource()). Each construct is reported to the
+ *     Handler, which needs to have these methods, even
+ *     if the policy never lets them get called:
+ *     onStartElement(const XMLSpan& aPrefix, const XMLSpan& aLocalPart),
+ *     onAttribute(const XMLSpan& aPrefix, const XMLSpan& aLocalPart, const XMLSpan& aValue),
+ *     onEndElement(const XMLSpan& aPrefix, const XMLSpan& aLocalPart),
+ *     onText(const XMLSpan& aText),
+ *     onComment(const XMLSpan& aText),
+ *     onProcessingInstruction(const XMLSpan& aTarget, const XMLSpan& aData),
+ *     onXMLDeclaration().
+ *     XMLContentHandler has all of them doing nothing, to derive from.
+ *     The attributes of a start tag follow its onStartElement(), an empty
+ *     element tag gets its onEndElement() right after them. Spans refer to
+ *     the input, or to a buffer of the scanner where entity references
+ *     were replaced, and are only valid during the call. Errors always
+ *     have their location, XMLEventReader drops it without location
+ *     tracking.
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#ifndef _CPPSTAX_XMLSCANNER_H
+#define _CPPSTAX_XMLSCANNER_H
+
+#include "XMLStreamError.h"
+#include "Location.h"
+#include "LocationStreamBuffer.h"
+#include "XMLValueParser.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <streambuf>
+#include <locale>
+#include <stdexcept>
+#include <cstring>
+#include <cstddef>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace cppstax
+{
+
+struct XMLSpan
+{
+    const char* m_pData;
+    std::size_t m_nLength;
+};
+
+template<class Policy, class Handler>
+class XMLScanner
+{
+public:
+    XMLScanner(Handler& aHandler);
+
+public:
+    void setInput(const char* pData, std::size_t nLength);
+    void setSource(std::streambuf* pSource);
+    void setEntityReplacementDictionary(const std::map<std::string, std::string>* pDictionary);
+    bool scanConstruct();
+    bool scan();
+    bool skipElement(unsigned int nDepth);
+    std::size_t getPosition() const;
+    bool hasBufferedInput() const;
+    bool isInput(const XMLSpan& aSpan) const;
+    Location getLocation();
+    Location getLocation(std::size_t nPosition);
+    const XMLStreamError& getError() const;
+
+protected:
+    bool ScanTag();
+    bool ScanTagStart();
+    bool ScanTagEnd();
+    bool ScanText();
+    bool ScanProcessingInstruction();
+    bool ScanMarkupDeclaration();
+    bool ScanComment();
+    bool ScanAttribute(char cFirstByte);
+    bool ScanAttributeValue(XMLSpan& aValue);
+    bool ScanEntity(std::string& strText);
+    bool ScanWhitespace(char& cByte);
+    bool FindCommentEnd(std::size_t& nPosition);
+
+    bool ReadByte(char& cByte);
+    bool IsSpace(char cByte) const;
+    bool IsNameCharacter(char cByte) const;
+    bool IsStructural(char cByte) const;
+    XMLSpan Span(std::size_t nBegin, std::size_t nEnd) const;
+    std::size_t FindByte(std::size_t nPosition, char cByte);
+    std::size_t FindEither(std::size_t nPosition, char cFirst, char cSecond);
+    std::size_t NextStructural(std::size_t nPosition);
+    void IndexStructurals(std::size_t nEnd);
+    bool Fill();
+    void Compact();
+    void OpenElement(std::size_t nNameStart, std::size_t nNameLength);
+    void CloseElements(std::size_t nCount);
+
+    bool Fail(XMLStreamError::Code eCode);
+    bool Fail(XMLStreamError::Code eCode, char cByte);
+    bool Fail(XMLStreamError::Code eCode, const std::string& strName);
+    Location LocationAt(std::size_t nPosition);
+
+protected:
+    enum CharacterClass
+    {
+        CLASS_SPACE = 0x01,
+        CLASS_ALPHA = 0x02,
+        CLASS_ALNUM = 0x04
+    };
+
+protected:
+    static const std::size_t BLOCK_SIZE = 65536;
+    /** Bytes stage 1 of Policy::STRUCTURAL_INDEX indexes at a time. */
+    static const std::size_t INDEX_BLOCK_SIZE = 16384;
+
+protected:
+    Handler& m_aHandler;
+    /** Per byte value, the CharacterClass flags of the locale
+      * XMLEventReader uses. */
+    unsigned char m_aClasses[256];
+    const std::map<std::string, std::string>* m_pEntityReplacementDictionary;
+
+    const char* m_pData;
+    std::size_t m_nEnd;
+    std::size_t m_nPosition;
+    /** For setSource(), nullptr for input in memory. m_pData is then
+      * m_aBuffer, the input from offset m_nBase on. */
+    std::streambuf* m_pSource;
+    std::vector<char> m_aBuffer;
+    std::size_t m_nBase;
+    bool m_bEndOfInput;
+    /** Names of the open elements one after another, and their lengths,
+      * only kept for Policy::CHECK_END_TAGS. */
+    std::string m_strOpenElements;
+    std::vector<std::size_t> m_aOpenElements;
+    /** Text or attribute value with entity references replaced. */
+    std::string m_strText;
+    std::string m_strEntityName;
+    /** Stage 1 of Policy::STRUCTURAL_INDEX, ascending positions of '<',
+      * '>', '&', '"' and '\'' in m_pData up to m_nIndexed, from the start
+      * of the current construct on. */
+    std::vector<std::size_t> m_aIndex;
+    std::size_t m_nIndexPosition;
+    std::size_t m_nIndexed;
+
+    /** Offset in the input up to which lines were counted, and the
+      * offset of the start of the line. */
+    std::size_t m_nCounted;
+    long m_nLineNumber;
+    std::size_t m_nLineStart;
+    /** Where counting starts over if a location in front of m_nCounted
+      * is asked for, the start of the input or of m_aBuffer. */
+    std::size_t m_nCheckpoint;
+    long m_nCheckpointLineNumber;
+    std::size_t m_nCheckpointLineStart;
+    XMLStreamError m_aError;
+
+};
+
+template<class Policy, class Handler>
+XMLScanner<Policy, Handler>::XMLScanner(Handler& aHandler):
+  m_aHandler(aHandler),
+  m_pEntityReplacementDictionary(nullptr),
+  m_pData(nullptr),
+  m_nEnd(0),
+  m_nPosition(0),
+  m_pSource(nullptr),
+  m_nBase(0),
+  m_bEndOfInput(true),
+  m_nIndexPosition(0),
+  m_nIndexed(0),
+  m_nCounted(0),
+  m_nLineNumber(1),
+  m_nLineStart(0),
+  m_nCheckpoint(0),
+  m_nCheckpointLineNumber(1),
+  m_nCheckpointLineStart(0)
+{
+    std::locale aLocale;
+
+    for (int i = 0; i < 256; i++)
+    {
+        char cByte = static_cast<char>(i);
+
+        m_aClasses[i] = 0;
+
+        if (std::isspace(cByte, aLocale) != 0)
+        {
+            m_aClasses[i] |= CLASS_SPACE;
+        }
+
+        if (std::isalpha(cByte, aLocale) == true)
+        {
+            m_aClasses[i] |= CLASS_ALPHA;
+        }
+
+        if (std::isalnum(cByte, aLocale) == true)
+        {
+            m_aClasses[i] |= CLASS_ALNUM;
+        }
+    }
+}
+
+/**
+ * @brief Starts over with the nLength bytes at pData, which need to stay
+ *     unchanged while being scanned.
+ */
+template<class Policy, class Handler>
+void XMLScanner<Policy, Handler>::setInput(const char* pData, std::size_t nLength)
+{
+    if (pData == nullptr &&
+        nLength > 0)
+    {
+        throw new std::invalid_argument("nullptr passed.");
+    }
+
+    m_pData = pData;
+    m_nEnd = nLength;
+    m_nPosition = 0;
+    m_pSource = nullptr;
+    m_nBase = 0;
+    m_bEndOfInput = true;
+    m_strOpenElements.clear();
+    m_aOpenElements.clear();
+    m_aIndex.clear();
+    m_nIndexPosition = 0;
+    m_nIndexed = 0;
+    m_nCounted = 0;
+    m_nLineNumber = 1;
+    m_nLineStart = 0;
+    m_nCheckpoint = 0;
+    m_nCheckpointLineNumber = 1;
+    m_nCheckpointLineStart = 0;
+    m_aError = XMLStreamError();
+}
+
+/**
+ * @brief Starts over with reading from pSource, a block at a time as the
+ *     constructs need it. Between constructs, the input already scanned
+ *     gets dropped from the buffer, which keeps its capacity for the
+ *     next source.
+ */
+template<class Policy, class Handler>
+void XMLScanner<Policy, Handler>::setSource(std::streambuf* pSource)
+{
+    if (pSource == nullptr)
+    {
+        throw new std::invalid_argument("nullptr passed.");
+    }
+
+    setInput(nullptr, 0);
+
+    m_pSource = pSource;
+    m_pData = m_aBuffer.data();
+    m_bEndOfInput = false;
+}
+
+/**
+ * @brief Entities other than the built-in ones, with their replacement
+ *     text, as kept by XMLEventReader::addToEntityReplacementDictionary().
+ *     Only used for Policy::ENTITY_RESOLUTION.
+ */
+template<class Policy, class Handler>
+void XMLScanner<Policy, Handler>::setEntityReplacementDictionary(const std::map<std::string, std::string>* pDictionary)
+{
+    m_pEntityReplacementDictionary = pDictionary;
+}
+
+/**
+ * @brief Scans the next tag, text, comment or processing instruction and
+ *     reports it to the Handler.
+ * @retval false at the end of the input or after an error, which
+ *     getError() tells.
+ */
+template<class Policy, class Handler>
+bool XMLScanner<Policy, Handler>::scanConstruct()
+{
+    char cByte = '\0';
+
+    Compact();
+
+    if (ReadByte(cByte) != true)
+    {
+        if (Policy::CHECK_END_TAGS == true &&
+            m_aOpenElements.empty() != true)
+        {
+            return Fail(XMLStreamError::ERROR_ELEMENT_UNCLOSED, m_strOpenElements.substr(m_strOpenElements.length() - m_aOpenElements.back()));
+        }
+
+        return false;
+    }
+
+    if (cByte == '<')
+    {
+        return ScanTag();
+    }
+    else
+    {
+        return ScanText();
+    }
+}
+
+/**
+ * @brief Scans the rest of the input.
+ * @retval false after an error, which getError() tells.
+ */
+template<class Policy, class Handler>
+bool XMLScanner<Policy, Handler>::scan()
+{
+    while (scanConstruct() == true)
+    {
+
+    }
+
+    return m_aError.getCode() == XMLStreamError::ERROR_NONE;
+}
+
+/**
+ * @brief Same as XMLEventReader::skipElement(): nothing is reported and
+ *     well-formedness isn't checked up to the end of the element.
+ * @param nDepth Number of the innermost open elements to skip to the end
+ *     of, usually 1 right after the onStartElement() of a start tag.
+ */
+template<class Policy, class Handler>
+bool XMLScanner<Policy, Handler>::skipElement(unsigned int nDepth)
+{
+    if (Policy::CHECK_END_TAGS == true)
+    {
+        if (nDepth > m_aOpenElements.size())
+        {
+            throw new std::logic_error("Attempted to skip more elements than are open.");
+        }
+
+        CloseElements(nDepth);
+    }
+
+    char cByte = '\0';
+
+    while (nDepth > 0)
+    {
+        Compact();
+
+        m_nPosition = FindByte(m_nPosition, '<');
+
+        if (ReadByte(cByte) != true ||
+            ReadByte(cByte) != true)
+        {
+            return Fail(XMLStreamError::ERROR_SKIPPED_ELEMENT_INCOMPLETE);
+        }
+
+        if (cByte == '/')
+        {
+            m_nPosition = FindByte(m_nPosition, '>');
+
+            if (m_nPosition >= m_nEnd)
+            {
+                return Fail(XMLStreamError::ERROR_SKIPPED_ELEMENT_INCOMPLETE);
+            }
+
+            ++m_nPosition;
+            --nDepth;
+        }
+        else if (cByte == '?')
+        {
+            do
+            {
+                m_nPosition = FindByte(m_nPosition, '?');
+
+                if (ReadByte(cByte) != true ||
+                    ReadByte(cByte) != true)
+                {
+                    return Fail(XMLStreamError::ERROR_SKIPPED_ELEMENT_INCOMPLETE);
+                }
+
+                while (cByte == '?')
+                {
+                    if (ReadByte(cByte) != true)
+                    {
+                        return Fail(XMLStreamError::ERROR_SKIPPED_ELEMENT_INCOMPLETE);
+                    }
+                }
+
+            } while (cByte != '>');
+        }
+        else if (cByte == '!')
+        {
+            if (ReadByte(cByte) != true)
+            {
+                return Fail(XMLStreamError::ERROR_SKIPPED_ELEMENT_INCOMPLETE);
+            }
+
+            if (cByte == '-')
+            {
+                if (ReadByte(cByte) != true)
+                {
+                    return Fail(XMLStreamError::ERROR_SKIPPED_ELEMENT_INCOMPLETE);
+                }
+
+                if (cByte != '-')
+                {
+                    return Fail(XMLStreamError::ERROR_COMMENT_MALFORMED);
+                }
+
+                std::size_t nEnd = 0;
+
+                if (FindCommentEnd(nEnd) != true)
+                {
+                    return false;
+                }
+
+                m_nPosition = nEnd + 3;
+            }
+            else if (cByte == '[')
+            {
+                // CDATA section, "]]>" can't occur in it.
+                while (true)
+                {
+                    m_nPosition = FindByte(m_nPosition, '>');
+
+                    if (m_nPosition >= m_nEnd)
+                    {
+                        return Fail(XMLStreamError::ERROR_SKIPPED_ELEMENT_INCOMPLETE);
+                    }
+
+                    ++m_nPosition;
+
+                    if (m_pData[m_nPosition - 2] == ']' &&
+                        m_pData[m_nPosition - 3] == ']')
+                    {
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                m_nPosition = FindByte(m_nPosition, '>');
+
+                if (m_nPosition >= m_nEnd)
+                {
+                    return Fail(XMLStreamError::ERROR_SKIPPED_ELEMENT_INCOMPLETE);
+                }
+
+                ++m_nPosition;
+            }
+        }
+        else
+        {
+            // Start tag, '>' and '/' might appear in attribute values.
+            char cQuote = '\0';
+
+            while (true)
+            {
+                if (ReadByte(cByte) != true)
+                {
+                    return Fail(XMLStreamError::ERROR_SKIPPED_ELEMENT_INCOMPLETE);
+                }
+
+                if (cQuote != '\0')
+                {
+                    if (cByte == cQuote)
+                    {
+                        cQuote = '\0';
+                    }
+                }
+                else if (cByte == '"' ||
+                         cByte == '\'')
+                {
+                    cQuote = cByte;
+                }
+                else if (cByte == '>')
+                {
+                    break;
+                }
+            }
+
+            if (m_pData[m_nPosition - 2] != '/')
+            {
+                ++nDepth;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @retval Offset in the input of the next construct.
+ */
+template<class Policy, class Handler>
+std::size_t XMLScanner<Policy, Handler>::getPosition() const
+{
+    return m_nBase + m_nPosition;
+}
+
+/**
+ * @retval true if there's input in memory or read from the source which
+ *     wasn't scanned yet, so scanning on doesn't wait for the source.
+ */
+template<class Policy, class Handler>
+bool XMLScanner<Policy, Handler>::hasBufferedInput() const
+{
+    return m_nPosition < m_nEnd;
+}
+
+/**
+ * @retval false if aSpan refers to a buffer of the scanner where entity
+ *     references were replaced.
+ */
+template<class Policy, class Handler>
+bool XMLScanner<Policy, Handler>::isInput(const XMLSpan& aSpan) const
+{
+    return aSpan.m_pData >= m_pData &&
+           aSpan.m_pData < m_pData + m_nEnd;
+}
+
+/**
+ * @retval Location of getPosition(). Lines are counted from the last
+ *     position asked for, so asking in order of the input is cheap.
+ */
+template<class Policy, class Handler>
+Location XMLScanner<Policy, Handler>::getLocation()
+{
+    return LocationAt(m_nPosition);
+}
+
+/**
+ * @retval Location of the offset nPosition in the input, for example of a
+ *     construct getPosition() returned before it was scanned. With
+ *     setSource(), only offsets from the start of the last construct on
+ *     are still known.
+ */
+template<class Policy, class Handler>
+Location XMLScanner<Policy, Handler>::getLocation(std::size_t nPosition)
+{
+    if (nPosition < m_nBase)
+    {
+        return Location();
+    }
+
+    return LocationAt(nPosition - m_nBase);
+}
+
+template<class Policy, class Handler>
+const XMLStreamError& XMLScanner<Policy, Handler>::getError() const
+{
+    return m_aError;
+}
+
+template<class Policy, class Handler>
+bool XMLScanner<Policy, Handler>::ScanTag()
+{
+    char cByte = '\0';
+
+    if (ReadByte(cByte) != true)
+    {
+        return Fail(XMLStreamError::ERROR_TAG_INCOMPLETE);
+    }
+
+    if (cByte == '?')
+    {
+        return ScanProcessingInstruction();
+    }
+    else if (cByte == '/')
+    {
+        return ScanTagEnd();
+    }
+    else if (cByte == '!')
+    {
+        return ScanMarkupDeclaration();
+    }
+    else if ((m_aClasses[static_cast<unsigned char>(cByte)] & CLASS_ALPHA) != 0 ||
+             cByte == '_')
+    {
+        return ScanTagStart();
+    }
+    else
+    {
+        return Fail(XMLStreamError::ERROR_TAG_UNKNOWN_BYTE, cByte);
+    }
+}
+
+/**
+ * @brief The first byte of the name was already read.
+ */
+template<class Policy, class Handler>
+bool XMLScanner<Policy, Handler>::ScanTagStart()
+{
+    std::size_t nNameStart = m_nPosition - 1;
+    // Position of the ':', or of the byte before the name if there's none.
+    std::size_t nColon = nNameStart - 1;
+    char cByte = '\0';
+
+    do
+    {
+        if (ReadByte(cByte) != true)
+        {
+            return Fail(XMLStreamError::ERROR_TAG_START_INCOMPLETE);
+        }
+
+        if (cByte == ':')
+        {
+            if (nColon >= nNameStart)
+            {
+                return Fail(XMLStreamError::ERROR_START_TAG_NAME_PREFIXES);
+            }
+
+            nColon = m_nPosition - 1;
+        }
+        else if (cByte == '>' ||
+                 cByte == '/' ||
+                 IsSpace(cByte) == true)
+        {
+            break;
+        }
+        else if (IsNameCharacter(cByte) != true)
+        {
+            return Fail(XMLStreamError::ERROR_START_TAG_NAME_CHARACTER, cByte);
+        }
+
+    } while (true);
+
+    std::size_t nNameEnd = m_nPosition - 1;
+
+    if (cByte != '>' &&
+        cByte != '/' &&
+        nNameEnd - nColon <= 1)
+    {
+        return Fail(XMLStreamError::ERROR_START_TAG_NAME_WHITESPACE);
+    }
+
+    m_aHandler.onStartElement(nColon >= nNameStart ? Span(nNameStart, nColon) : Span(nNameStart, nNameStart),
+                              Span(nColon + 1, nNameEnd));
+
+    while (cByte != '>' &&
+           cByte != '/')
+    {
+        if (IsSpace(cByte) != true)
+        {
+            if (ScanAttribute(cByte) != true)
+            {
+                return false;
+            }
+        }
+
+        if (ReadByte(cByte) != true)
+        {
+            return Fail(XMLStreamError::ERROR_TAG_START_INCOMPLETE);
+        }
+    }
+
+    if (cByte == '/')
+    {
+        if (ReadByte(cByte) != true)
+        {
+            return Fail(XMLStreamError::ERROR_TAG_START_INCOMPLETE);
+        }
+
+        if (cByte != '>')
+        {
+            return Fail(XMLStreamError::ERROR_START_TAG_EMPTY_END);
+        }
+
+        // The attributes might have been read into a reallocated buffer.
+        m_aHandler.onEndElement(nColon >= nNameStart ? Span(nNameStart, nColon) : Span(nNameStart, nNameStart),
+                                Span(nColon + 1, nNameEnd));
+    }
+    else if (Policy::CHECK_END_TAGS == true)
+    {
+        OpenElement(nNameStart, nNameEnd - nNameStart);
+    }
+
+    return true;
+}
+
+/**
+ * @brief For Policy::CHECK_END_TAGS, errors about the name not matching
+ *     are located at the '<' of the end tag.
+ */
+template<class Policy, class Handler>
+bool XMLScanner<Policy, Handler>::ScanTagEnd()
+{
+    std::size_t nNameStart = m_nPosition;
+    std::size_t nNameEnd = nNameStart;
+    std::size_t nColon = nNameStart - 1;
+    char cByte = '\0';
+
+    do
+    {
+        if (ReadByte(cByte) != true)
+        {
+            return Fail(m_nPosition > nNameStart ? XMLStreamError::ERROR_END_TAG_INCOMPLETE : XMLStreamError::ERROR_TAG_END_INCOMPLETE);
+        }
+
+        if (cByte == ':')
+        {
+            if (nColon >= nNameStart)
+            {
+                return Fail(XMLStreamError::ERROR_END_TAG_NAME_PREFIXES);
+            }
+
+            nColon = m_nPosition - 1;
+        }
+        else if (cByte == '>')
+        {
+            nNameEnd = m_nPosition - 1;
+            break;
+        }
+        else if (IsSpace(cByte) == true &&
+                 m_nPosition - 1 > nNameStart)
+        {
+            // Whitespace between the name and the '>'.
+            nNameEnd = m_nPosition - 1;
+
+            if (ScanWhitespace(cByte) != true)
+            {
+                return false;
+            }
+
+            if (cByte == '\0')
+            {
+                return Fail(XMLStreamError::ERROR_END_TAG_INCOMPLETE);
+            }
+
+            if (cByte != '>')
+            {
+                return Fail(XMLStreamError::ERROR_END_TAG_NAME_CHARACTER, cByte);
+            }
+
+            break;
+        }
+        else if (IsNameCharacter(cByte) != true)
+        {
+            return Fail(XMLStreamError::ERROR_END_TAG_NAME_CHARACTER, cByte);
+        }
+
+    } while (true);
+
+    if (Policy::CHECK_END_TAGS == true)
+    {
+        std::size_t nNameLength = nNameEnd - nNameStart;
+
+        if (m_aOpenElements.empty() == true)
+        {
+            m_nPosition = nNameStart - 2;
+            return Fail(XMLStreamError::ERROR_END_TAG_UNEXPECTED);
+        }
+
+        std::size_t nOpenLength = m_aOpenElements.back();
+        const char* pOpenName = m_strOpenElements.data() + m_strOpenElements.length() - nOpenLength;
+
+        if (nOpenLength != nNameLength ||
+            std::memcmp(pOpenName, m_pData + nNameStart, nNameLength) != 0)
+        {
+            m_nPosition = nNameStart - 2;
+            return Fail(XMLStreamError::ERROR_END_TAG_MISMATCH, std::string(pOpenName, nOpenLength));
+        }
+
+        CloseElements(1);
+    }
+
+    m_aHandler.onEndElement(nColon >= nNameStart ? Span(nNameStart, nColon) : Span(nNameStart, nNameStart),
+                            Span(nColon + 1, nNameEnd));
+
+    return true;
+}
+
+/**
+ * @brief The first byte of the text was already read. Without
+ *     Policy::ENTITY_RESOLUTION, the text is only searched for the next
+ *     '<', and reported from the input unless entity references had to be
+ *     replaced.
+ */
+template<class Policy, class Handler>
+bool XMLScanner<Policy, Handler>::ScanText()
+{
+    std::size_t nStart = m_nPosition - 1;
+
+    if (Policy::IGNORE_WHITESPACE == true &&
+        IsSpace(m_pData[nStart]) == true)
+    {
+        char cByte = '\0';
+
+        while (true)
+        {
+            if (ReadByte(cByte) != true)
+            {
+                return true;
+            }
+
+            if (IsSpace(cByte) != true)
+            {
+                break;
+            }
+        }
+
+        --m_nPosition;
+
+        if (cByte == '<')
+        {
+            return true;
+        }
+    }
+
+    if (Policy::ENTITY_RESOLUTION != true)
+    {
+        m_nPosition = FindByte(nStart, '<');
+        m_aHandler.onText(Span(nStart, m_nPosition));
+
+        return true;
+    }
+
+    std::size_t nPosition = FindEither(nStart, '<', '&');
+
+    if (nPosition >= m_nEnd ||
+        m_pData[nPosition] == '<')
+    {
+        m_nPosition = nPosition;
+        m_aHandler.onText(Span(nStart, nPosition));
+
+        return true;
+    }
+
+    m_strText.assign(m_pData + nStart, nPosition - nStart);
+
+    do
+    {
+        m_nPosition = nPosition + 1;
+
+        if (ScanEntity(m_strText) != true)
+        {
+            return false;
+        }
+
+        nPosition = FindEither(m_nPosition, '<', '&');
+        m_strText.append(m_pData + m_nPosition, nPosition - m_nPosition);
+
+    } while (nPosition < m_nEnd &&
+             m_pData[nPosition] == '&');
+
+    m_nPosition = nPosition;
+
+    XMLSpan aText = { m_strText.data(), m_strText.length() };
+    m_aHandler.onText(aText);
+
+    return true;
+}
+
+/**
+ * @brief The target may end with a single '?', the data loses a '?'
+ *     directly in front of the '>' unless it follows another '?' that
+ *     was kept, same as with XMLEventReader.
+ */
+template<class Policy, class Handler>
+bool XMLScanner<Policy, Handler>::ScanProcessingInstruction()
+{
+    std::size_t nTargetStart = 0;
+    std::size_t nTargetLength = 0;
+    bool bQuestionMark = false;
+    char cByte = '\0';
+
+    while (true)
+    {
+        if (ReadByte(cByte) != true)
+        {
+            return Fail(XMLStreamError::ERROR_PROCESSING_INSTRUCTION_TARGET_INCOMPLETE);
+        }
+
+        if (cByte == '?' &&
+            bQuestionMark != true)
+        {
+            bQuestionMark = true;
+        }
+        else if (cByte == '>')
+        {
+            if (bQuestionMark != true ||
+                nTargetLength <= 0)
+            {
+                return Fail(XMLStreamError::ERROR_PROCESSING_INSTRUCTION_ENDED);
+            }
+
+            // "<?target?>": the data scan finds the "?>" and ends up empty.
+            m_nPosition -= 2;
+            break;
+        }
+        else if (IsSpace(cByte) == true)
+        {
+            if (nTargetLength <= 0)
+            {
+                return Fail(XMLStreamError::ERROR_PROCESSING_INSTRUCTION_TARGET_MISSING);
+            }
+
+            break;
+        }
+        else
+        {
+            if (bQuestionMark == true)
+            {
+                return Fail(XMLStreamError::ERROR_PROCESSING_INSTRUCTION_TARGET_INTERRUPTED);
+            }
+
+            if (nTargetLength <= 0)
+            {
+                if ((m_aClasses[static_cast<unsigned char>(cByte)] & CLASS_ALPHA) == 0)
+                {
+                    return Fail(XMLStreamError::ERROR_PROCESSING_INSTRUCTION_TARGET_FIRST_CHARACTER, cByte);
+                }
+
+                nTargetStart = m_nPosition - 1;
+            }
+
+            ++nTargetLength;
+        }
+    }
+
+    const char* pTarget = m_pData + nTargetStart;
+    bool bDeclaration = nTargetLength == 3 &&
+                        (pTarget[0] == 'x' || pTarget[0] == 'X') &&
+                        (pTarget[1] == 'm' || pTarget[1] == 'M') &&
+                        (pTarget[2] == 'l' || pTarget[2] == 'L');
+
+    std::size_t nEnd = FindByte(m_nPosition, '>');
+
+    if (nEnd >= m_nEnd)
+    {
+        m_nPosition = m_nEnd;
+
+        if (bDeclaration == true)
+        {
+            return Fail(XMLStreamError::ERROR_XML_DECLARATION_INCOMPLETE);
+        }
+
+        return Fail(XMLStreamError::ERROR_PROCESSING_INSTRUCTION_DATA_INCOMPLETE);
+    }
+
+    std::size_t nDataStart = m_nPosition;
+    m_nPosition = nEnd + 1;
+
+    if (bDeclaration == true)
+    {
+        m_aHandler.onXMLDeclaration();
+    }
+    else if (Policy::REPORT_PROCESSING_INSTRUCTIONS == true)
+    {
+        std::size_t nQuestionMarks = 0;
+
+        while (nEnd - nQuestionMarks > nDataStart &&
+               m_pData[nEnd - nQuestionMarks - 1] == '?')
+        {
+            ++nQuestionMarks;
+        }
+
+        if ((nQuestionMarks & 1) != 0)
+        {
+            --nEnd;
+        }
+
+        m_aHandler.onProcessingInstruction(Span(nTargetStart, nTargetStart + nTargetLength),
+                                           Span(nDataStart, nEnd));
+    }
+
+    return true;
+}
+
+template<class Policy, class Handler>
+bool XMLScanner<Policy, Handler>::ScanMarkupDeclaration()
+{
+    char cByte = '\0';
+
+    if (ReadByte(cByte) != true)
+    {
+        return Fail(XMLStreamError::ERROR_MARKUP_DECLARATION_INCOMPLETE);
+    }
+
+    if (cByte == '-')
+    {
+        return ScanComment();
+    }
+    else
+    {
+        return Fail(XMLStreamError::ERROR_MARKUP_DECLARATION_UNSUPPORTED);
+    }
+}
+
+template<class Policy, class Handler>
+bool XMLScanner<Policy, Handler>::ScanComment()
+{
+    char cByte = '\0';
+
+    if (ReadByte(cByte) != true)
+    {
+        return Fail(XMLStreamError::ERROR_COMMENT_INCOMPLETE);
+    }
+
+    if (cByte != '-')
+    {
+        return Fail(XMLStreamError::ERROR_COMMENT_MALFORMED);
+    }
+
+    std::size_t nEnd = 0;
+
+    if (FindCommentEnd(nEnd) != true)
+    {
+        return false;
+    }
+
+    std::size_t nStart = m_nPosition;
+    m_nPosition = nEnd + 3;
+
+    if (Policy::REPORT_COMMENTS == true)
+    {
+        m_aHandler.onComment(Span(nStart, nEnd));
+    }
+
+    return true;
+}
+
+/**
+ * @brief Name and value of one attribute, the first byte of the name was
+ *     already read.
+ */
+template<class Policy, class Handler>
+bool XMLScanner<Policy, Handler>::ScanAttribute(char cFirstByte)
+{
+    std::size_t nNameStart = m_nPosition - 1;
+    std::size_t nColon = nNameStart - 1;
+    char cByte(cFirstByte);
+
+    if (cByte == ':')
+    {
+        nColon = nNameStart;
+    }
+    else if ((m_aClasses[static_cast<unsigned char>(cByte)] & CLASS_ALNUM) == 0 &&
+             cByte != '_')
+    {
+        return Fail(XMLStreamError::ERROR_ATTRIBUTE_NAME_FIRST_CHARACTER, cByte);
+    }
+
+    do
+    {
+        if (ReadByte(cByte) != true)
+        {
+            return Fail(XMLStreamError::ERROR_ATTRIBUTE_NAME_INCOMPLETE);
+        }
+
+        if (cByte == ':')
+        {
+            if (nColon >= nNameStart)
+            {
+                return Fail(XMLStreamError::ERROR_ATTRIBUTE_NAME_PREFIXES);
+            }
+
+            nColon = m_nPosition - 1;
+        }
+        else if (cByte == '=' ||
+                 IsSpace(cByte) == true)
+        {
+            break;
+        }
+        else if (IsNameCharacter(cByte) != true)
+        {
+            return Fail(XMLStreamError::ERROR_ATTRIBUTE_NAME_CHARACTER, cByte);
+        }
+
+    } while (true);
+
+    std::size_t nNameEnd = m_nPosition - 1;
+
+    if (cByte != '=')
+    {
+        if (ScanWhitespace(cByte) != true)
+        {
+            return false;
+        }
+
+        if (cByte == '\0')
+        {
+            return Fail(XMLStreamError::ERROR_ATTRIBUTE_INCOMPLETE);
+        }
+        else if (cByte != '=')
+        {
+            return Fail(XMLStreamError::ERROR_ATTRIBUTE_NAME_MALFORMED);
+        }
+    }
+
+    XMLSpan aValue = { nullptr, 0 };
+
+    if (ScanAttributeValue(aValue) != true)
+    {
+        return false;
+    }
+
+    m_aHandler.onAttribute(nColon >= nNameStart ? Span(nNameStart, nColon) : Span(nNameStart, nNameStart),
+                           Span(nColon + 1, nNameEnd),
+                           aValue);
+
+    return true;
+}
+
+template<class Policy, class Handler>
+bool XMLScanner<Policy, Handler>::ScanAttributeValue(XMLSpan& aValue)
+{
+    char cDelimiter('\0');
+
+    if (ScanWhitespace(cDelimiter) != true)
+    {
+        return false;
+    }
+
+    if (cDelimiter == '\0')
+    {
+        return Fail(XMLStreamError::ERROR_ATTRIBUTE_VALUE_MISSING);
+    }
+    else if (cDelimiter != '\'' &&
+             cDelimiter != '"')
+    {
+        return Fail(XMLStreamError::ERROR_ATTRIBUTE_VALUE_DELIMITER, cDelimiter);
+    }
+
+    std::size_t nStart = m_nPosition;
+    std::size_t nPosition = 0;
+
+    if (Policy::ENTITY_RESOLUTION != true)
+    {
+        nPosition = FindByte(nStart, cDelimiter);
+    }
+    else
+    {
+        nPosition = FindEither(nStart, cDelimiter, '&');
+    }
+
+    if (nPosition >= m_nEnd)
+    {
+        m_nPosition = m_nEnd;
+        return Fail(XMLStreamError::ERROR_ATTRIBUTE_VALUE_INCOMPLETE);
+    }
+
+    if (m_pData[nPosition] == cDelimiter)
+    {
+        m_nPosition = nPosition + 1;
+        aValue = Span(nStart, nPosition);
+
+        return true;
+    }
+
+    m_strText.assign(m_pData + nStart, nPosition - nStart);
+
+    do
+    {
+        m_nPosition = nPosition + 1;
+
+        if (ScanEntity(m_strText) != true)
+        {
+            return false;
+        }
+
+        nPosition = FindEither(m_nPosition, cDelimiter, '&');
+
+        if (nPosition >= m_nEnd)
+        {
+            m_nPosition = m_nEnd;
+            return Fail(XMLStreamError::ERROR_ATTRIBUTE_VALUE_INCOMPLETE);
+        }
+
+        m_strText.append(m_pData + m_nPosition, nPosition - m_nPosition);
+
+    } while (m_pData[nPosition] == '&');
+
+    m_nPosition = nPosition + 1;
+    aValue.m_pData = m_strText.data();
+    aValue.m_nLength = m_strText.length();
+
+    return true;
+}
+
+/**
+ * @brief The '&' was already read, the replacement text gets appended
+ *     to strText. The built-in entities and character references are
+ *     resolved directly, only for others the name gets looked up.
+ */
+template<class Policy, class Handler>
+bool XMLScanner<Policy, Handler>::ScanEntity(std::string& strText)
+{
+    char cByte = '\0';
+
+    if (ReadByte(cByte) != true)
+    {
+        return Fail(XMLStreamError::ERROR_ENTITY_INCOMPLETE);
+    }
+
+    if (cByte == ';')
+    {
+        return Fail(XMLStreamError::ERROR_ENTITY_NAME_MISSING);
+    }
+
+    std::size_t nStart = m_nPosition - 1;
+    std::size_t nEnd = FindByte(m_nPosition, ';');
+
+    if (nEnd >= m_nEnd)
+    {
+        m_nPosition = m_nEnd;
+        return Fail(XMLStreamError::ERROR_ENTITY_INCOMPLETE);
+    }
+
+    m_nPosition = nEnd + 1;
+
+    const char* pName = m_pData + nStart;
+    std::size_t nLength = nEnd - nStart;
+
+    if (nLength == 3 && std::memcmp(pName, "amp", 3) == 0)
+    {
+        strText.push_back('&');
+    }
+    else if (nLength == 2 && std::memcmp(pName, "lt", 2) == 0)
+    {
+        strText.push_back('<');
+    }
+    else if (nLength == 2 && std::memcmp(pName, "gt", 2) == 0)
+    {
+        strText.push_back('>');
+    }
+    else if (nLength == 4 && std::memcmp(pName, "apos", 4) == 0)
+    {
+        strText.push_back('\'');
+    }
+    else if (nLength == 4 && std::memcmp(pName, "quot", 4) == 0)
+    {
+        strText.push_back('"');
+    }
+    else if (pName[0] == '#')
+    {
+        if (XMLValueParser::parseCharacterReference(pName, nLength, strText) != true)
+        {
+            return Fail(XMLStreamError::ERROR_ENTITY_UNKNOWN, std::string(pName, nLength));
+        }
+    }
+    else
+    {
+        m_strEntityName.assign(pName, nLength);
+
+        if (m_pEntityReplacementDictionary == nullptr)
+        {
+            return Fail(XMLStreamError::ERROR_ENTITY_UNKNOWN, m_strEntityName);
+        }
+
+        std::map<std::string, std::string>::const_iterator iter = m_pEntityReplacementDictionary->find(m_strEntityName);
+
+        if (iter == m_pEntityReplacementDictionary->end())
+        {
+            return Fail(XMLStreamError::ERROR_ENTITY_UNKNOWN, m_strEntityName);
+        }
+
+        strText.append(iter->second);
+    }
+
+    return true;
+}
+
+/**
+ * @param[out] cByte The first non-whitespace character or '\0' in
+ *     case of end-of-file.
+ * @retval Always true, same signature as XMLEventReader::ConsumeWhitespace().
+ */
+template<class Policy, class Handler>
+bool XMLScanner<Policy, Handler>::ScanWhitespace(char& cByte)
+{
+    do
+    {
+        if (ReadByte(cByte) != true)
+        {
+            cByte = '\0';
+            return true;
+        }
+
+        if (IsSpace(cByte) != true)
+        {
+            return true;
+        }
+
+    } while (true);
+}
+
+/**
+ * @brief Searches from the read position in a comment for its "-->", with
+ *     the same matching as XMLEventReader: bytes which failed to continue
+ *     a partial match don't start a new one.
+ * @param[out] nPosition Position of the first '-' of the "-->".
+ */
+template<class Policy, class Handler>
+bool XMLScanner<Policy, Handler>::FindCommentEnd(std::size_t& nPosition)
+{
+    nPosition = m_nPosition;
+
+    while (true)
+    {
+        nPosition = FindByte(nPosition, '-');
+
+        while (nPosition + 3 > m_nEnd &&
+               nPosition < m_nEnd)
+        {
+            if (Fill() != true)
+            {
+                break;
+            }
+        }
+
+        if (nPosition + 3 > m_nEnd)
+        {
+            m_nPosition = m_nEnd;
+            return Fail(XMLStreamError::ERROR_COMMENT_INCOMPLETE);
+        }
+
+        if (m_pData[nPosition + 1] != '-')
+        {
+            nPosition += 2;
+        }
+        else if (m_pData[nPosition + 2] == '>')
+        {
+            return true;
+        }
+        else
+        {
+            nPosition += 3;
+        }
+    }
+}
+
+template<class Policy, class Handler>
+inline bool XMLScanner<Policy, Handler>::ReadByte(char& cByte)
+{
+    if (m_nPosition >= m_nEnd &&
+        Fill() != true)
+    {
+        return false;
+    }
+
+    cByte = m_pData[m_nPosition];
+    ++m_nPosition;
+
+    return true;
+}
+
+template<class Policy, class Handler>
+inline bool XMLScanner<Policy, Handler>::IsSpace(char cByte) const
+{
+    return (m_aClasses[static_cast<unsigned char>(cByte)] & CLASS_SPACE) != 0;
+}
+
+/**
+ * @brief Bytes allowed in names after the first one, except ':'.
+ */
+template<class Policy, class Handler>
+inline bool XMLScanner<Policy, Handler>::IsNameCharacter(char cByte) const
+{
+    return (m_aClasses[static_cast<unsigned char>(cByte)] & CLASS_ALNUM) != 0 ||
+           cByte == '-' ||
+           cByte == '_' ||
+           cByte == '.';
+}
+
+/**
+ * @brief The bytes stage 1 of Policy::STRUCTURAL_INDEX indexes.
+ */
+template<class Policy, class Handler>
+inline bool XMLScanner<Policy, Handler>::IsStructural(char cByte) const
+{
+    return cByte == '<' ||
+           cByte == '>' ||
+           cByte == '&' ||
+           cByte == '"' ||
+           cByte == '\'';
+}
+
+template<class Policy, class Handler>
+inline XMLSpan XMLScanner<Policy, Handler>::Span(std::size_t nBegin, std::size_t nEnd) const
+{
+    XMLSpan aSpan = { m_pData + nBegin, nEnd - nBegin };
+    return aSpan;
+}
+
+/**
+ * @retval Position of the next cByte at or behind nPosition or m_nEnd if
+ *     there's none up to the end of the input.
+ */
+template<class Policy, class Handler>
+std::size_t XMLScanner<Policy, Handler>::FindByte(std::size_t nPosition, char cByte)
+{
+    if (Policy::STRUCTURAL_INDEX == true &&
+        IsStructural(cByte) == true)
+    {
+        while (true)
+        {
+            nPosition = NextStructural(nPosition);
+
+            if (nPosition >= m_nEnd ||
+                m_pData[nPosition] == cByte)
+            {
+                return nPosition;
+            }
+
+            ++nPosition;
+        }
+    }
+
+    do
+    {
+        if (nPosition < m_nEnd)
+        {
+            const char* pFound = static_cast<const char*>(std::memchr(m_pData + nPosition, cByte, m_nEnd - nPosition));
+
+            if (pFound != nullptr)
+            {
+                return pFound - m_pData;
+            }
+
+            nPosition = m_nEnd;
+        }
+
+    } while (Fill() == true);
+
+    return m_nEnd;
+}
+
+/**
+ * @retval Position of the next cFirst or cSecond at or behind nPosition or
+ *     m_nEnd if there's none. Compares 16 bytes at a time where SSE2 is
+ *     available.
+ */
+template<class Policy, class Handler>
+std::size_t XMLScanner<Policy, Handler>::FindEither(std::size_t nPosition, char cFirst, char cSecond)
+{
+    if (Policy::STRUCTURAL_INDEX == true &&
+        IsStructural(cFirst) == true &&
+        IsStructural(cSecond) == true)
+    {
+        while (true)
+        {
+            nPosition = NextStructural(nPosition);
+
+            if (nPosition >= m_nEnd ||
+                m_pData[nPosition] == cFirst ||
+                m_pData[nPosition] == cSecond)
+            {
+                return nPosition;
+            }
+
+            ++nPosition;
+        }
+    }
+
+    do
+    {
+#if defined(__SSE2__)
+        const __m128i aFirst = _mm_set1_epi8(cFirst);
+        const __m128i aSecond = _mm_set1_epi8(cSecond);
+
+        while (nPosition + 16 <= m_nEnd)
+        {
+            __m128i aBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_pData + nPosition));
+            unsigned int nMask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(aBlock, aFirst),
+                                                                _mm_cmpeq_epi8(aBlock, aSecond)));
+
+            if (nMask != 0)
+            {
+                return nPosition + __builtin_ctz(nMask);
+            }
+
+            nPosition += 16;
+        }
+#endif
+
+        for (; nPosition < m_nEnd; nPosition++)
+        {
+            if (m_pData[nPosition] == cFirst ||
+                m_pData[nPosition] == cSecond)
+            {
+                return nPosition;
+            }
+        }
+
+    } while (Fill() == true);
+
+    return m_nEnd;
+}
+
+/**
+ * @brief Stage 2 of Policy::STRUCTURAL_INDEX, walks the index instead of
+ *     the input, which it extends by stage 1 as needed.
+ * @retval Position of the next structural byte at or behind nPosition or
+ *     m_nEnd if there's none.
+ */
+template<class Policy, class Handler>
+std::size_t XMLScanner<Policy, Handler>::NextStructural(std::size_t nPosition)
+{
+    while (true)
+    {
+        while (m_nIndexPosition > 0 &&
+               m_aIndex[m_nIndexPosition - 1] >= nPosition)
+        {
+            --m_nIndexPosition;
+        }
+
+        while (m_nIndexPosition < m_aIndex.size() &&
+               m_aIndex[m_nIndexPosition] < nPosition)
+        {
+            ++m_nIndexPosition;
+        }
+
+        if (m_nIndexPosition < m_aIndex.size())
+        {
+            return m_aIndex[m_nIndexPosition];
+        }
+
+        if (m_nIndexed < m_nEnd)
+        {
+            IndexStructurals(m_nIndexed + INDEX_BLOCK_SIZE < m_nEnd ? m_nIndexed + INDEX_BLOCK_SIZE : m_nEnd);
+        }
+        else if (Fill() != true)
+        {
+            return m_nEnd;
+        }
+    }
+}
+
+/**
+ * @brief Stage 1 of Policy::STRUCTURAL_INDEX, appends the positions of
+ *     the structural bytes from m_nIndexed up to nEnd to the index, 16
+ *     bytes at a time where SSE2 is available. Whether an entry is
+ *     significant (a quote only delimits in a tag) is up to the construct
+ *     which is scanned, stage 1 doesn't know about markup.
+ */
+template<class Policy, class Handler>
+void XMLScanner<Policy, Handler>::IndexStructurals(std::size_t nEnd)
+{
+    std::size_t nPosition = m_nIndexed;
+
+#if defined(__SSE2__)
+    const __m128i aLessThan = _mm_set1_epi8('<');
+    const __m128i aGreaterThan = _mm_set1_epi8('>');
+    const __m128i aAmpersand = _mm_set1_epi8('&');
+    const __m128i aQuote = _mm_set1_epi8('"');
+    const __m128i aApostrophe = _mm_set1_epi8('\'');
+
+    while (nPosition + 16 <= nEnd)
+    {
+        __m128i aBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_pData + nPosition));
+        __m128i aMatches = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(aBlock, aLessThan),
+                                                     _mm_cmpeq_epi8(aBlock, aGreaterThan)),
+                                        _mm_or_si128(_mm_cmpeq_epi8(aBlock, aAmpersand),
+                                                     _mm_or_si128(_mm_cmpeq_epi8(aBlock, aQuote),
+                                                                  _mm_cmpeq_epi8(aBlock, aApostrophe))));
+        unsigned int nMask = _mm_movemask_epi8(aMatches);
+
+        while (nMask != 0)
+        {
+            m_aIndex.push_back(nPosition + __builtin_ctz(nMask));
+            nMask &= nMask - 1;
+        }
+
+        nPosition += 16;
+    }
+#endif
+
+    for (; nPosition < nEnd; nPosition++)
+    {
+        if (IsStructural(m_pData[nPosition]) == true)
+        {
+            m_aIndex.push_back(nPosition);
+        }
+    }
+
+    m_nIndexed = nEnd;
+}
+
+/**
+ * @brief Appends up to a block of the source to the buffer, only as much
+ *     as is available without waiting once there's a byte, so input
+ *     which arrives piece by piece (like messages of several documents)
+ *     gets reported as it arrives. Positions stay valid, pointers into
+ *     the buffer don't.
+ * @retval false at the end of the source or for input in memory.
+ */
+template<class Policy, class Handler>
+bool XMLScanner<Policy, Handler>::Fill()
+{
+    if (m_bEndOfInput == true)
+    {
+        return false;
+    }
+
+    if (m_aBuffer.size() < m_nEnd + BLOCK_SIZE)
+    {
+        m_aBuffer.resize(m_nEnd + BLOCK_SIZE);
+    }
+
+    m_pData = m_aBuffer.data();
+
+    std::size_t nSpace = BLOCK_SIZE;
+    std::streamsize nAvailable = m_pSource->in_avail();
+
+    if (nAvailable <= 0)
+    {
+        // Waits for the next byte.
+        std::streambuf::int_type nByte = m_pSource->sbumpc();
+
+        if (std::streambuf::traits_type::eq_int_type(nByte, std::streambuf::traits_type::eof()) == true)
+        {
+            m_bEndOfInput = true;
+            return false;
+        }
+
+        m_aBuffer[m_nEnd] = std::streambuf::traits_type::to_char_type(nByte);
+        ++m_nEnd;
+        --nSpace;
+
+        nAvailable = m_pSource->in_avail();
+    }
+
+    if (nAvailable > 0)
+    {
+        if (static_cast<std::size_t>(nAvailable) > nSpace)
+        {
+            nAvailable = nSpace;
+        }
+
+        std::streamsize nRead = m_pSource->sgetn(m_aBuffer.data() + m_nEnd, nAvailable);
+
+        if (nRead > 0)
+        {
+            m_nEnd += nRead;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Between constructs, drops the input in front of the read
+ *     position from the buffer once it's a block large. Lines are
+ *     counted up to there first. Index entries in front of the read
+ *     position are dropped once there are some, even for input in memory.
+ */
+template<class Policy, class Handler>
+void XMLScanner<Policy, Handler>::Compact()
+{
+    if (Policy::STRUCTURAL_INDEX == true)
+    {
+        while (m_nIndexPosition < m_aIndex.size() &&
+               m_aIndex[m_nIndexPosition] < m_nPosition)
+        {
+            ++m_nIndexPosition;
+        }
+
+        if (m_nIndexPosition >= INDEX_BLOCK_SIZE / 16 ||
+            m_nIndexPosition >= m_aIndex.size())
+        {
+            m_aIndex.erase(m_aIndex.begin(), m_aIndex.begin() + m_nIndexPosition);
+            m_nIndexPosition = 0;
+        }
+    }
+
+    if (m_pSource == nullptr ||
+        m_nPosition < BLOCK_SIZE)
+    {
+        return;
+    }
+
+    LocationAt(m_nPosition);
+
+    m_nCheckpoint = m_nCounted;
+    m_nCheckpointLineNumber = m_nLineNumber;
+    m_nCheckpointLineStart = m_nLineStart;
+
+    std::memmove(m_aBuffer.data(), m_aBuffer.data() + m_nPosition, m_nEnd - m_nPosition);
+    m_nEnd -= m_nPosition;
+    m_nBase += m_nPosition;
+
+    if (Policy::STRUCTURAL_INDEX == true)
+    {
+        m_aIndex.erase(m_aIndex.begin(), m_aIndex.begin() + m_nIndexPosition);
+        m_nIndexPosition = 0;
+
+        for (std::size_t i = 0; i < m_aIndex.size(); i++)
+        {
+            m_aIndex[i] -= m_nPosition;
+        }
+
+        m_nIndexed = m_nIndexed > m_nPosition ? m_nIndexed - m_nPosition : 0;
+    }
+
+    m_nPosition = 0;
+}
+
+template<class Policy, class Handler>
+void XMLScanner<Policy, Handler>::OpenElement(std::size_t nNameStart, std::size_t nNameLength)
+{
+    m_strOpenElements.append(m_pData + nNameStart, nNameLength);
+    m_aOpenElements.push_back(nNameLength);
+}
+
+/**
+ * @brief Drops the nCount innermost open elements.
+ */
+template<class Policy, class Handler>
+void XMLScanner<Policy, Handler>::CloseElements(std::size_t nCount)
+{
+    std::size_t nLength = 0;
+
+    for (; nCount > 0; nCount--)
+    {
+        nLength += m_aOpenElements.back();
+        m_aOpenElements.pop_back();
+    }
+
+    m_strOpenElements.resize(m_strOpenElements.length() - nLength);
+}
+
+template<class Policy, class Handler>
+bool XMLScanner<Policy, Handler>::Fail(XMLStreamError::Code eCode)
+{
+    m_aError = XMLStreamError(eCode, LocationAt(m_nPosition));
+    return false;
+}
+
+template<class Policy, class Handler>
+bool XMLScanner<Policy, Handler>::Fail(XMLStreamError::Code eCode, char cByte)
+{
+    m_aError = XMLStreamError(eCode, LocationAt(m_nPosition), cByte);
+    return false;
+}
+
+template<class Policy, class Handler>
+bool XMLScanner<Policy, Handler>::Fail(XMLStreamError::Code eCode, const std::string& strName)
+{
+    m_aError = XMLStreamError(eCode, LocationAt(m_nPosition), strName);
+    return false;
+}
+
+/**
+ * @param nPosition In the buffer, the Location has the offset in the input.
+ */
+template<class Policy, class Handler>
+Location XMLScanner<Policy, Handler>::LocationAt(std::size_t nPosition)
+{
+    std::size_t nOffset = m_nBase + nPosition;
+
+    if (nOffset < m_nCounted)
+    {
+        // Behind the read position after it was moved back.
+        m_nCounted = m_nCheckpoint;
+        m_nLineNumber = m_nCheckpointLineNumber;
+        m_nLineStart = m_nCheckpointLineStart;
+    }
+
+    if (nOffset > m_nCounted)
+    {
+        std::size_t nNewlines = LocationStreamBuffer::countNewlines(m_pData + (m_nCounted - m_nBase), m_pData + nPosition);
+
+        if (nNewlines > 0)
+        {
+            std::size_t nLineStart = nPosition;
+
+            while (m_pData[nLineStart - 1] != '\n')
+            {
+                --nLineStart;
+            }
+
+            m_nLineNumber += nNewlines;
+            m_nLineStart = m_nBase + nLineStart;
+        }
+
+        m_nCounted = nOffset;
+    }
+
+    return Location(nOffset, m_nLineNumber, nOffset - m_nLineStart + 1);
+}
+
+}
+
+#endif
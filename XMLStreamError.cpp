@@ -0,0 +1,246 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLStreamError.cpp
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#include "XMLStreamError.h"
+#include <sstream>
+#include <iomanip>
+
+namespace cppstax
+{
+
+XMLStreamError::XMLStreamError():
+  m_eCode(ERROR_NONE),
+  m_cByte('\0')
+{
+
+}
+
+XMLStreamError::XMLStreamError(Code eCode, const Location& aLocation):
+  m_eCode(eCode),
+  m_aLocation(aLocation),
+  m_cByte('\0')
+{
+
+}
+
+XMLStreamError::XMLStreamError(Code eCode, const Location& aLocation, char cByte):
+  m_eCode(eCode),
+  m_aLocation(aLocation),
+  m_cByte(cByte)
+{
+
+}
+
+XMLStreamError::XMLStreamError(Code eCode, const Location& aLocation, const std::string& strName):
+  m_eCode(eCode),
+  m_aLocation(aLocation),
+  m_cByte('\0'),
+  m_strName(strName)
+{
+
+}
+
+XMLStreamError::Code XMLStreamError::getCode() const
+{
+    return m_eCode;
+}
+
+/**
+ * @brief Unknown if location tracking isn't enabled for the XMLEventReader.
+ */
+const Location& XMLStreamError::getLocation() const
+{
+    return m_aLocation;
+}
+
+void XMLStreamError::setLocation(const Location& aLocation)
+{
+    m_aLocation = aLocation;
+}
+
+/**
+ * @brief The message a XMLStreamException would have, without the location.
+ */
+std::string XMLStreamError::getMessage() const
+{
+    std::stringstream aMessage;
+    int nByte(m_cByte);
+
+    switch (m_eCode)
+    {
+    case ERROR_NONE:
+        break;
+    case ERROR_STREAM_BAD:
+        aMessage << "Stream is bad.";
+        break;
+    case ERROR_TAG_INCOMPLETE:
+        aMessage << "Tag incomplete.";
+        break;
+    case ERROR_TAG_UNKNOWN_BYTE:
+        aMessage << "Unknown byte '" << m_cByte << "' (0x"
+                 << std::hex << std::uppercase << nByte << std::nouppercase << std::dec
+                 << ") within element.";
+        break;
+    case ERROR_TAG_START_INCOMPLETE:
+        aMessage << "Tag start incomplete.";
+        break;
+    case ERROR_START_TAG_NAME_WHITESPACE:
+        aMessage << "Start tag name begins with whitespace.";
+        break;
+    case ERROR_START_TAG_NAME_CHARACTER:
+        aMessage << "Character '" << m_cByte << "' (0x"
+                 << std::hex << std::uppercase << nByte << std::nouppercase << std::dec
+                 << ") not supported in a start tag name.";
+        break;
+    case ERROR_START_TAG_NAME_PREFIXES:
+        aMessage << "There can't be two prefixes in element name.";
+        break;
+    case ERROR_START_TAG_EMPTY_END:
+        aMessage << "Empty start + end tag end without closing '>'.";
+        break;
+    case ERROR_TAG_END_INCOMPLETE:
+        aMessage << "Tag end incomplete.";
+        break;
+    case ERROR_END_TAG_INCOMPLETE:
+        aMessage << "End tag incomplete.";
+        break;
+    case ERROR_END_TAG_NAME_CHARACTER:
+        aMessage << "Character '" << m_cByte << "' (0x"
+                 << std::hex << std::uppercase << nByte << std::nouppercase << std::dec
+                 << ") not supported in an end tag name.";
+        break;
+    case ERROR_END_TAG_NAME_PREFIXES:
+        aMessage << "There can't be two prefixes in the element name.";
+        break;
+    case ERROR_ATTRIBUTE_INCOMPLETE:
+        aMessage << "Attribute incomplete.";
+        break;
+    case ERROR_ATTRIBUTE_NAME_INCOMPLETE:
+        aMessage << "Attribute name incomplete.";
+        break;
+    case ERROR_ATTRIBUTE_NAME_FIRST_CHARACTER:
+        aMessage << "Character '" << m_cByte << "' (0x"
+                 << std::hex << std::uppercase << nByte << std::nouppercase << std::dec
+                 << ") not supported as first character of an attribute name.";
+        break;
+    case ERROR_ATTRIBUTE_NAME_CHARACTER:
+        aMessage << "Character '" << m_cByte << "' (0x"
+                 << std::hex << std::uppercase << nByte << std::nouppercase << std::dec
+                 << ") not supported in an attribute name.";
+        break;
+    case ERROR_ATTRIBUTE_NAME_PREFIXES:
+        aMessage << "There can't be two prefixes in attribute name.";
+        break;
+    case ERROR_ATTRIBUTE_NAME_MALFORMED:
+        aMessage << "Attribute name is malformed.";
+        break;
+    case ERROR_ATTRIBUTE_VALUE_MISSING:
+        aMessage << "Attribute is missing its value.";
+        break;
+    case ERROR_ATTRIBUTE_VALUE_DELIMITER:
+        aMessage << "Attribute value doesn't start with a delimiter like ''' or '\"', instead, '" << m_cByte << "' (0x"
+                 << std::hex << std::uppercase << nByte << std::nouppercase << std::dec
+                 << ") was found.";
+        break;
+    case ERROR_ATTRIBUTE_VALUE_INCOMPLETE:
+        aMessage << "Attribute value incomplete.";
+        break;
+    case ERROR_ENTITY_INCOMPLETE:
+        aMessage << "Entity incomplete.";
+        break;
+    case ERROR_ENTITY_NAME_MISSING:
+        aMessage << "Entity has no name.";
+        break;
+    case ERROR_ENTITY_UNKNOWN:
+        aMessage << "Unable to resolve entity '&" << m_strName << ";'.";
+        break;
+    case ERROR_PROCESSING_INSTRUCTION_TARGET_MISSING:
+        aMessage << "Processing instruction without target name.";
+        break;
+    case ERROR_PROCESSING_INSTRUCTION_TARGET_INCOMPLETE:
+        aMessage << "Processing instruction target name incomplete.";
+        break;
+    case ERROR_PROCESSING_INSTRUCTION_TARGET_FIRST_CHARACTER:
+        aMessage << "Character '" << m_cByte << "' (0x"
+                 << std::hex << std::uppercase << nByte << std::nouppercase << std::dec
+                 << ") not supported as first character of an processing instruction target name.";
+        break;
+    case ERROR_PROCESSING_INSTRUCTION_TARGET_INTERRUPTED:
+        aMessage << "Processing instruction target name interrupted by '?'.";
+        break;
+    case ERROR_PROCESSING_INSTRUCTION_ENDED:
+        aMessage << "Processing instruction ended before processing instruction target name could be read.";
+        break;
+    case ERROR_PROCESSING_INSTRUCTION_DATA_INCOMPLETE:
+        aMessage << "Processing instruction data incomplete.";
+        break;
+    case ERROR_XML_DECLARATION_INCOMPLETE:
+        aMessage << "XML declaration incomplete.";
+        break;
+    case ERROR_MARKUP_DECLARATION_INCOMPLETE:
+        aMessage << "Markup declaration incomplete.";
+        break;
+    case ERROR_MARKUP_DECLARATION_UNSUPPORTED:
+        aMessage << "Markup declaration type not implemented yet.";
+        break;
+    case ERROR_COMMENT_INCOMPLETE:
+        aMessage << "Comment incomplete.";
+        break;
+    case ERROR_COMMENT_MALFORMED:
+        aMessage << "Comment malformed.";
+        break;
+    case ERROR_SKIPPED_ELEMENT_INCOMPLETE:
+        aMessage << "Skipped element incomplete.";
+        break;
+    case ERROR_END_TAG_UNEXPECTED:
+        aMessage << "End tag without a start tag.";
+        break;
+    case ERROR_END_TAG_MISMATCH:
+        aMessage << "End tag doesn't match the start tag '<" << m_strName << ">'.";
+        break;
+    case ERROR_ELEMENT_UNCLOSED:
+        aMessage << "Element '" << m_strName << "' not closed at the end of the input.";
+        break;
+    case ERROR_RECORDING_MALFORMED:
+        aMessage << "Recorded events malformed or truncated.";
+        break;
+    case ERROR_BINDING_VALUE_INVALID:
+        aMessage << "Value for '" << m_strName << "' can't be converted to the type of the field.";
+        break;
+    case ERROR_ROOT_ELEMENT_MISSING:
+        aMessage << "No root element in the input.";
+        break;
+    case ERROR_ROOT_ELEMENT_MULTIPLE:
+        aMessage << "Element after the end of the root element.";
+        break;
+    case ERROR_TEXT_OUTSIDE_ROOT_ELEMENT:
+        aMessage << "Text other than whitespace outside of the root element.";
+        break;
+    case ERROR_ATTRIBUTE_DUPLICATE:
+        aMessage << "Attribute '" << m_strName << "' specified more than once.";
+        break;
+    }
+
+    return aMessage.str();
+}
+
+}
@@ -0,0 +1,118 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLStreamError.h
+ * @brief Error in the input as reported by a XMLEventReader that doesn't
+ *     throw, see XMLEventReader::setThrowOnError().
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#ifndef _CPPSTAX_XMLSTREAMERROR_H
+#define _CPPSTAX_XMLSTREAMERROR_H
+
+#include "Location.h"
+#include <string>
+
+namespace cppstax
+{
+
+/**
+ * @brief Just a code and the location, the message is only formatted when
+ *     asked for.
+ */
+class XMLStreamError
+{
+public:
+    enum Code
+    {
+        ERROR_NONE = 0,
+        ERROR_STREAM_BAD,
+        ERROR_TAG_INCOMPLETE,
+        ERROR_TAG_UNKNOWN_BYTE,
+        ERROR_TAG_START_INCOMPLETE,
+        ERROR_START_TAG_NAME_WHITESPACE,
+        ERROR_START_TAG_NAME_CHARACTER,
+        ERROR_START_TAG_NAME_PREFIXES,
+        ERROR_START_TAG_EMPTY_END,
+        ERROR_TAG_END_INCOMPLETE,
+        ERROR_END_TAG_INCOMPLETE,
+        ERROR_END_TAG_NAME_CHARACTER,
+        ERROR_END_TAG_NAME_PREFIXES,
+        ERROR_ATTRIBUTE_INCOMPLETE,
+        ERROR_ATTRIBUTE_NAME_INCOMPLETE,
+        ERROR_ATTRIBUTE_NAME_FIRST_CHARACTER,
+        ERROR_ATTRIBUTE_NAME_CHARACTER,
+        ERROR_ATTRIBUTE_NAME_PREFIXES,
+        ERROR_ATTRIBUTE_NAME_MALFORMED,
+        ERROR_ATTRIBUTE_VALUE_MISSING,
+        ERROR_ATTRIBUTE_VALUE_DELIMITER,
+        ERROR_ATTRIBUTE_VALUE_INCOMPLETE,
+        ERROR_ENTITY_INCOMPLETE,
+        ERROR_ENTITY_NAME_MISSING,
+        ERROR_ENTITY_UNKNOWN,
+        ERROR_PROCESSING_INSTRUCTION_TARGET_MISSING,
+        ERROR_PROCESSING_INSTRUCTION_TARGET_INCOMPLETE,
+        ERROR_PROCESSING_INSTRUCTION_TARGET_FIRST_CHARACTER,
+        ERROR_PROCESSING_INSTRUCTION_TARGET_INTERRUPTED,
+        ERROR_PROCESSING_INSTRUCTION_ENDED,
+        ERROR_PROCESSING_INSTRUCTION_DATA_INCOMPLETE,
+        ERROR_XML_DECLARATION_INCOMPLETE,
+        ERROR_MARKUP_DECLARATION_INCOMPLETE,
+        ERROR_MARKUP_DECLARATION_UNSUPPORTED,
+        ERROR_COMMENT_INCOMPLETE,
+        ERROR_COMMENT_MALFORMED,
+        ERROR_SKIPPED_ELEMENT_INCOMPLETE,
+        ERROR_END_TAG_UNEXPECTED,
+        ERROR_END_TAG_MISMATCH,
+        ERROR_ELEMENT_UNCLOSED,
+        ERROR_RECORDING_MALFORMED,
+        ERROR_BINDING_VALUE_INVALID,
+        ERROR_ROOT_ELEMENT_MISSING,
+        ERROR_ROOT_ELEMENT_MULTIPLE,
+        ERROR_TEXT_OUTSIDE_ROOT_ELEMENT,
+        ERROR_ATTRIBUTE_DUPLICATE
+    };
+
+public:
+    XMLStreamError();
+    XMLStreamError(Code eCode, const Location& aLocation);
+    XMLStreamError(Code eCode, const Location& aLocation, char cByte);
+    XMLStreamError(Code eCode, const Location& aLocation, const std::string& strName);
+
+public:
+    Code getCode() const;
+    const Location& getLocation() const;
+    void setLocation(const Location& aLocation);
+    std::string getMessage() const;
+
+protected:
+    Code m_eCode;
+    Location m_aLocation;
+    /** The offending byte for codes about an unexpected character. */
+    char m_cByte;
+    /** The entity name for ERROR_ENTITY_UNKNOWN, the element name for
+      * ERROR_END_TAG_MISMATCH and ERROR_ELEMENT_UNCLOSED, the path of the
+      * field for ERROR_BINDING_VALUE_INVALID, the attribute name for
+      * ERROR_ATTRIBUTE_DUPLICATE. */
+    std::string m_strName;
+
+};
+
+}
+
+#endif
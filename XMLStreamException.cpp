@@ -0,0 +1,65 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLStreamException.cpp
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#include "XMLStreamException.h"
+#include <sstream>
+
+namespace cppstax
+{
+
+XMLStreamException::XMLStreamException(const std::string& strMessage, const Location& aLocation):
+  std::runtime_error(FormatMessage(strMessage, aLocation)),
+  m_strMessage(strMessage),
+  m_aLocation(aLocation)
+{
+
+}
+
+const Location& XMLStreamException::getLocation() const
+{
+    return m_aLocation;
+}
+
+/**
+ * @brief The message without the location.
+ */
+const std::string& XMLStreamException::getMessage() const
+{
+    return m_strMessage;
+}
+
+std::string XMLStreamException::FormatMessage(const std::string& strMessage, const Location& aLocation)
+{
+    if (aLocation.isKnown() != true)
+    {
+        return strMessage;
+    }
+
+    std::stringstream aMessage;
+    aMessage << strMessage << " (line " << aLocation.getLineNumber()
+             << ", column " << aLocation.getColumnNumber()
+             << ", offset " << aLocation.getCharacterOffset() << ")";
+
+    return aMessage.str();
+}
+
+}
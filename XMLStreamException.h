@@ -0,0 +1,57 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLStreamException.h
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#ifndef _CPPSTAX_XMLSTREAMEXCEPTION_H
+#define _CPPSTAX_XMLSTREAMEXCEPTION_H
+
+#include "Location.h"
+#include <stdexcept>
+#include <string>
+
+namespace cppstax
+{
+
+/**
+ * @brief Error in the input. If the location is known, it's appended
+ *     to the message.
+ */
+class XMLStreamException : public std::runtime_error
+{
+public:
+    XMLStreamException(const std::string& strMessage, const Location& aLocation);
+
+public:
+    const Location& getLocation() const;
+    const std::string& getMessage() const;
+
+protected:
+    static std::string FormatMessage(const std::string& strMessage, const Location& aLocation);
+
+protected:
+    std::string m_strMessage;
+    Location m_aLocation;
+
+};
+
+}
+
+#endif
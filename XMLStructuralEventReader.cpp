@@ -0,0 +1,81 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLStructuralEventReader.cpp
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#include "XMLStructuralEventReader.h"
+
+namespace cppstax
+{
+
+XMLStructuralEventReader::XMLStructuralEventReader(std::istream& aStream):
+  XMLEventReader(aStream),
+  m_aStructuralScanner(m_aBuilder)
+{
+    m_aStructuralScanner.setEntityReplacementDictionary(&m_aEntityReplacementDictionary);
+}
+
+XMLStructuralEventReader::XMLStructuralEventReader(std::unique_ptr<std::streambuf> pBuffer):
+  XMLEventReader(std::move(pBuffer)),
+  m_aStructuralScanner(m_aBuilder)
+{
+    m_aStructuralScanner.setEntityReplacementDictionary(&m_aEntityReplacementDictionary);
+}
+
+XMLStructuralEventReader::~XMLStructuralEventReader()
+{
+
+}
+
+bool XMLStructuralEventReader::ReadEvents()
+{
+    return ScanEvents(m_aStructuralScanner);
+}
+
+/**
+ * @brief The scanner keeps its buffer and its index with their capacity.
+ */
+void XMLStructuralEventReader::Reset(std::streambuf* pBuffer)
+{
+    XMLEventReader::Reset(pBuffer);
+    m_aStructuralScanner.setInput(nullptr, 0);
+}
+
+bool XMLStructuralEventReader::IsScannedInput(const XMLSpan& aSpan) const
+{
+    return m_aStructuralScanner.isInput(aSpan);
+}
+
+bool XMLStructuralEventReader::skipElement()
+{
+    return SkipScannedElement(m_aStructuralScanner);
+}
+
+Location XMLStructuralEventReader::getLocation()
+{
+    if (m_bLocationTracking != true)
+    {
+        return Location();
+    }
+
+    return m_aStructuralScanner.getLocation();
+}
+
+}
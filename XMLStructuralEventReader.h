@@ -0,0 +1,68 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLStructuralEventReader.h
+ * @brief Alternative engine which reads the input in two stages.
+ * @details Stage 1 records the positions of the structural characters
+ *     '<', '>', '&', '"' and '\'' in an index a few kilobytes ahead, 16
+ *     bytes at a time where SSE2 is available. Stage 2 is the XMLScanner
+ *     of XMLEventReader, which with XMLStructuralPolicy finds the ends of
+ *     text, attribute values and tags by walking that index instead of
+ *     searching the input. Which index entries are significant (a quote
+ *     only delimits inside of a tag, nothing counts inside of a comment)
+ *     depends on the markup context, so the masking is done by stage 2
+ *     rather than in stage 1. The events and the settings are those of
+ *     XMLEventReader.
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#ifndef _CPPSTAX_XMLSTRUCTURALEVENTREADER_H
+#define _CPPSTAX_XMLSTRUCTURALEVENTREADER_H
+
+#include "XMLEventReader.h"
+#include "XMLScanner.h"
+#include "XMLParserPolicy.h"
+
+namespace cppstax
+{
+
+class XMLStructuralEventReader : public XMLEventReader
+{
+public:
+    XMLStructuralEventReader(std::istream& aStream);
+    XMLStructuralEventReader(std::unique_ptr<std::streambuf> pBuffer);
+    virtual ~XMLStructuralEventReader();
+
+    virtual bool skipElement();
+
+public:
+    virtual Location getLocation();
+
+protected:
+    virtual bool ReadEvents();
+    virtual void Reset(std::streambuf* pBuffer);
+    virtual bool IsScannedInput(const XMLSpan& aSpan) const;
+
+protected:
+    XMLScanner<XMLStructuralPolicy, EventBuilder> m_aStructuralScanner;
+
+};
+
+}
+
+#endif
@@ -0,0 +1,406 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLTree.cpp
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#include "XMLTree.h"
+#include <stdexcept>
+#include <cstring>
+
+namespace cppstax
+{
+
+namespace
+{
+
+const std::size_t EVENT_BATCH_SIZE = 64;
+
+}
+
+const unsigned int XMLTree::NONE;
+
+XMLTree::XMLTree():
+  m_nFirstRoot(NONE),
+  m_nLastRoot(NONE)
+{
+
+}
+
+/**
+ * @brief Materializes the element whose StartElement was just returned by
+ *     aReader, up to and including its EndElement, as the next root.
+ * @retval Index of the element node.
+ */
+unsigned int XMLTree::appendElement(XMLEventReader& aReader, const StartElement& aStartElement)
+{
+    m_aOpenNodes.clear();
+    m_aLastChildren.clear();
+
+    unsigned int nNode = AppendStartElement(aStartElement);
+
+    // Events are read one by one, as reading ahead would consume events
+    // behind the element.
+    while (m_aOpenNodes.empty() != true &&
+           aReader.hasNext() == true)
+    {
+        AppendEvent(*aReader.nextEvent());
+    }
+
+    m_aOpenNodes.clear();
+    m_aLastChildren.clear();
+
+    return nNode;
+}
+
+/**
+ * @brief Materializes the rest of the input, nodes on the top level
+ *     become roots.
+ * @retval Index of the first node appended, NONE if there was none.
+ */
+unsigned int XMLTree::appendAll(XMLEventReader& aReader)
+{
+    std::size_t nFirst = m_aNodes.size();
+
+    m_aOpenNodes.clear();
+    m_aLastChildren.clear();
+
+    while (aReader.nextEvents(m_aEvents, EVENT_BATCH_SIZE) > 0)
+    {
+        for (std::vector<XMLEvent>::iterator iter = m_aEvents.begin();
+             iter != m_aEvents.end();
+             iter++)
+        {
+            AppendEvent(*iter);
+        }
+    }
+
+    m_aOpenNodes.clear();
+    m_aLastChildren.clear();
+
+    if (nFirst >= m_aNodes.size())
+    {
+        return NONE;
+    }
+
+    return static_cast<unsigned int>(nFirst);
+}
+
+/**
+ * @brief Removes all nodes, the storage and the interned names are kept
+ *     for the next ones.
+ */
+void XMLTree::clear()
+{
+    m_aNodes.clear();
+    m_aAttributes.clear();
+    m_aArena.clear();
+    m_nFirstRoot = NONE;
+    m_nLastRoot = NONE;
+}
+
+std::size_t XMLTree::getNodeCount() const
+{
+    return m_aNodes.size();
+}
+
+const XMLTree::Node& XMLTree::getNode(unsigned int nNode) const
+{
+    return m_aNodes.at(nNode);
+}
+
+unsigned int XMLTree::getFirstRoot() const
+{
+    return m_nFirstRoot;
+}
+
+const QName& XMLTree::getName(unsigned int nNameID) const
+{
+    return m_aNames.at(nNameID);
+}
+
+/**
+ * @param[in] nAttribute Index from Node::m_nData on, Node::m_nLength
+ *     attributes long.
+ */
+const XMLTree::NodeAttribute& XMLTree::getAttribute(unsigned int nAttribute) const
+{
+    return m_aAttributes.at(nAttribute);
+}
+
+/**
+ * @retval Index of the first attribute of the element nNode with
+ *     strLocalPart as local part of its name, NONE if there's none.
+ */
+unsigned int XMLTree::findAttribute(unsigned int nNode, const std::string& strLocalPart) const
+{
+    const Node& aNode = m_aNodes.at(nNode);
+
+    if (aNode.m_eType != NODE_ELEMENT)
+    {
+        return NONE;
+    }
+
+    for (unsigned int nAttribute = aNode.m_nData, nEnd = aNode.m_nData + aNode.m_nLength;
+         nAttribute < nEnd;
+         nAttribute++)
+    {
+        if (m_aNames[m_aAttributes[nAttribute].m_nNameID].getLocalPart() == strLocalPart)
+        {
+            return nAttribute;
+        }
+    }
+
+    return NONE;
+}
+
+/**
+ * @brief Text at nOffset in the arena, valid until nodes are appended.
+ */
+const char* XMLTree::getData(unsigned int nOffset) const
+{
+    if (nOffset > m_aArena.size())
+    {
+        throw new std::invalid_argument("Offset behind the arena.");
+    }
+
+    return m_aArena.data() + nOffset;
+}
+
+/**
+ * @brief Appends the text of nNode or of all text nodes below it to
+ *     strText.
+ */
+void XMLTree::getTextContent(unsigned int nNode, std::string& strText) const
+{
+    const Node& aNode = m_aNodes.at(nNode);
+
+    if (aNode.m_eType == NODE_TEXT)
+    {
+        strText.append(m_aArena.data() + aNode.m_nData, aNode.m_nLength);
+        return;
+    }
+
+    if (aNode.m_eType != NODE_ELEMENT)
+    {
+        return;
+    }
+
+    unsigned int nCurrent = aNode.m_nFirstChild;
+
+    while (nCurrent != NONE)
+    {
+        const Node& aCurrent = m_aNodes[nCurrent];
+
+        if (aCurrent.m_eType == NODE_TEXT)
+        {
+            strText.append(m_aArena.data() + aCurrent.m_nData, aCurrent.m_nLength);
+        }
+
+        if (aCurrent.m_nFirstChild != NONE)
+        {
+            nCurrent = aCurrent.m_nFirstChild;
+            continue;
+        }
+
+        // Up to the next ancestor with a following sibling.
+        while (nCurrent != nNode &&
+               m_aNodes[nCurrent].m_nNextSibling == NONE)
+        {
+            nCurrent = m_aNodes[nCurrent].m_nParent;
+        }
+
+        if (nCurrent == nNode)
+        {
+            break;
+        }
+
+        nCurrent = m_aNodes[nCurrent].m_nNextSibling;
+    }
+}
+
+/**
+ * @brief Bytes allocated for nodes, attributes and the arena.
+ */
+std::size_t XMLTree::getMemoryUsage() const
+{
+    return m_aNodes.capacity() * sizeof(Node) +
+           m_aAttributes.capacity() * sizeof(NodeAttribute) +
+           m_aArena.capacity();
+}
+
+void XMLTree::AppendEvent(XMLEvent& aEvent)
+{
+    if (aEvent.isStartElement() == true)
+    {
+        AppendStartElement(aEvent.asStartElement());
+    }
+    else if (aEvent.isEndElement() == true)
+    {
+        if (m_aOpenNodes.empty() != true)
+        {
+            m_aOpenNodes.pop_back();
+            m_aLastChildren.pop_back();
+        }
+    }
+    else if (aEvent.isCharacters() == true)
+    {
+        const std::string& strData = aEvent.asCharacters().getData();
+        AppendNode(NODE_TEXT, NONE, AppendData(strData), static_cast<unsigned int>(strData.length()));
+    }
+    else if (aEvent.isComment() == true)
+    {
+        const std::string& strText = aEvent.asComment().getText();
+        AppendNode(NODE_COMMENT, NONE, AppendData(strText), static_cast<unsigned int>(strText.length()));
+    }
+    else if (aEvent.isProcessingInstruction() == true)
+    {
+        ProcessingInstruction& aProcessingInstruction = aEvent.asProcessingInstruction();
+        const std::string& strData = aProcessingInstruction.getData();
+        unsigned int nNameID = GetNameID(QName("", aProcessingInstruction.getTarget(), ""));
+
+        AppendNode(NODE_PROCESSING_INSTRUCTION, nNameID, AppendData(strData), static_cast<unsigned int>(strData.length()));
+    }
+}
+
+unsigned int XMLTree::AppendStartElement(const StartElement& aStartElement)
+{
+    const std::shared_ptr<std::list<std::shared_ptr<Attribute>>> pAttributes = aStartElement.getAttributes();
+    unsigned int nFirstAttribute = static_cast<unsigned int>(m_aAttributes.size());
+
+    for (std::list<std::shared_ptr<Attribute>>::const_iterator iter = pAttributes->begin();
+         iter != pAttributes->end();
+         iter++)
+    {
+        NodeAttribute aAttribute;
+        aAttribute.m_nNameID = GetNameID((*iter)->getName());
+        aAttribute.m_nValue = AppendData((*iter)->getValue());
+        aAttribute.m_nValueLength = static_cast<unsigned int>((*iter)->getValue().length());
+
+        m_aAttributes.push_back(aAttribute);
+    }
+
+    unsigned int nNode = AppendNode(NODE_ELEMENT,
+                                    GetNameID(aStartElement.getName()),
+                                    nFirstAttribute,
+                                    static_cast<unsigned int>(m_aAttributes.size() - nFirstAttribute));
+
+    m_aOpenNodes.push_back(nNode);
+    m_aLastChildren.push_back(NONE);
+
+    return nNode;
+}
+
+/**
+ * @brief Appends a node as last child of the innermost open element, or
+ *     as last root.
+ */
+unsigned int XMLTree::AppendNode(NodeType eType, unsigned int nNameID, unsigned int nData, unsigned int nLength)
+{
+    if (m_aNodes.size() >= NONE)
+    {
+        throw new std::runtime_error("XMLTree node count exceeds its index range.");
+    }
+
+    unsigned int nNode = static_cast<unsigned int>(m_aNodes.size());
+
+    Node aNode;
+    aNode.m_eType = eType;
+    aNode.m_nParent = NONE;
+    aNode.m_nFirstChild = NONE;
+    aNode.m_nNextSibling = NONE;
+    aNode.m_nNameID = nNameID;
+    aNode.m_nData = nData;
+    aNode.m_nLength = nLength;
+
+    if (m_aOpenNodes.empty() == true)
+    {
+        if (m_nLastRoot == NONE)
+        {
+            m_nFirstRoot = nNode;
+        }
+        else
+        {
+            m_aNodes[m_nLastRoot].m_nNextSibling = nNode;
+        }
+
+        m_nLastRoot = nNode;
+    }
+    else
+    {
+        aNode.m_nParent = m_aOpenNodes.back();
+
+        if (m_aLastChildren.back() == NONE)
+        {
+            m_aNodes[aNode.m_nParent].m_nFirstChild = nNode;
+        }
+        else
+        {
+            m_aNodes[m_aLastChildren.back()].m_nNextSibling = nNode;
+        }
+
+        m_aLastChildren.back() = nNode;
+    }
+
+    m_aNodes.push_back(aNode);
+
+    return nNode;
+}
+
+/**
+ * @retval Offset of strData in the arena.
+ */
+unsigned int XMLTree::AppendData(const std::string& strData)
+{
+    std::size_t nOffset = m_aArena.size();
+
+    if (strData.length() >= NONE - nOffset)
+    {
+        throw new std::runtime_error("XMLTree arena exceeds its offset range.");
+    }
+
+    m_aArena.insert(m_aArena.end(), strData.begin(), strData.end());
+
+    return static_cast<unsigned int>(nOffset);
+}
+
+unsigned int XMLTree::GetNameID(const QName& aName)
+{
+    m_strNameKey.assign(aName.getNamespaceURI());
+    m_strNameKey.push_back('\0');
+    m_strNameKey.append(aName.getLocalPart());
+    m_strNameKey.push_back('\0');
+    m_strNameKey.append(aName.getPrefix());
+
+    std::unordered_map<std::string, unsigned int>::const_iterator iter = m_aNameIDs.find(m_strNameKey);
+
+    if (iter != m_aNameIDs.end())
+    {
+        return iter->second;
+    }
+
+    unsigned int nNameID = static_cast<unsigned int>(m_aNames.size());
+
+    m_aNames.push_back(aName);
+    m_aNameIDs.insert(std::pair<std::string, unsigned int>(m_strNameKey, nNameID));
+
+    return nNameID;
+}
+
+}
@@ -0,0 +1,129 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLTree.h
+ * @brief Compact tree of elements read from a XMLEventReader, for random
+ *     access within a record.
+ * @details Nodes are kept in one array and refer to their parent, first
+ *     child and next sibling by index, names are interned and all text
+ *     and attribute values are stored in one arena, so a node takes 28
+ *     bytes and an attribute 12 bytes plus their text. Only the subtrees
+ *     passed to XMLTree::appendElement() get materialized, the others can
+ *     be skipped with XMLEventReader::skipElement(). Indexes stay valid
+ *     until XMLTree::clear(), which keeps the storage for the next record.
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#ifndef _CPPSTAX_XMLTREE_H
+#define _CPPSTAX_XMLTREE_H
+
+#include "XMLEventReader.h"
+#include "StartElement.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstddef>
+
+namespace cppstax
+{
+
+class XMLTree
+{
+public:
+    /** @brief Index which doesn't refer to a node or attribute. */
+    static const unsigned int NONE = static_cast<unsigned int>(-1);
+
+    enum NodeType
+    {
+        NODE_ELEMENT,
+        NODE_TEXT,
+        NODE_COMMENT,
+        NODE_PROCESSING_INSTRUCTION
+    };
+
+    struct Node
+    {
+        NodeType m_eType;
+        /** NONE for the roots, which are siblings of each other. */
+        unsigned int m_nParent;
+        unsigned int m_nFirstChild;
+        unsigned int m_nNextSibling;
+        /** Of an element, or of the target of a processing instruction. */
+        unsigned int m_nNameID;
+        /** Index of the first attribute of an element, arena offset of the
+          * text otherwise. */
+        unsigned int m_nData;
+        /** Attribute count of an element, length of the text otherwise. */
+        unsigned int m_nLength;
+    };
+
+    struct NodeAttribute
+    {
+        unsigned int m_nNameID;
+        /** Arena offset of the value. */
+        unsigned int m_nValue;
+        unsigned int m_nValueLength;
+    };
+
+public:
+    XMLTree();
+
+public:
+    unsigned int appendElement(XMLEventReader& aReader, const StartElement& aStartElement);
+    unsigned int appendAll(XMLEventReader& aReader);
+    void clear();
+
+public:
+    std::size_t getNodeCount() const;
+    const Node& getNode(unsigned int nNode) const;
+    unsigned int getFirstRoot() const;
+    const QName& getName(unsigned int nNameID) const;
+    const NodeAttribute& getAttribute(unsigned int nAttribute) const;
+    unsigned int findAttribute(unsigned int nNode, const std::string& strLocalPart) const;
+    const char* getData(unsigned int nOffset) const;
+    void getTextContent(unsigned int nNode, std::string& strText) const;
+    std::size_t getMemoryUsage() const;
+
+protected:
+    void AppendEvent(XMLEvent& aEvent);
+    unsigned int AppendStartElement(const StartElement& aStartElement);
+    unsigned int AppendNode(NodeType eType, unsigned int nNameID, unsigned int nData, unsigned int nLength);
+    unsigned int AppendData(const std::string& strData);
+    unsigned int GetNameID(const QName& aName);
+
+protected:
+    std::vector<Node> m_aNodes;
+    std::vector<NodeAttribute> m_aAttributes;
+    std::vector<char> m_aArena;
+    std::vector<QName> m_aNames;
+    /** Name IDs by namespace URI, local part and prefix, separated
+      * by '\0'. */
+    std::unordered_map<std::string, unsigned int> m_aNameIDs;
+    std::string m_strNameKey;
+    unsigned int m_nFirstRoot;
+    unsigned int m_nLastRoot;
+    /** Elements not ended yet while appending, and their last child. */
+    std::vector<unsigned int> m_aOpenNodes;
+    std::vector<unsigned int> m_aLastChildren;
+    std::vector<XMLEvent> m_aEvents;
+
+};
+
+}
+
+#endif
@@ -0,0 +1,275 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLValidator.cpp
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#include "XMLValidator.h"
+#include <streambuf>
+#include <stdexcept>
+
+namespace cppstax
+{
+
+XMLValidator::XMLValidator():
+  m_aScanner(m_aHandler)
+{
+    m_aScanner.setEntityReplacementDictionary(&m_aEntityReplacementDictionary);
+}
+
+/**
+ * @brief Entities other than the built-in ones which are accepted, see
+ *     XMLEventReader::addToEntityReplacementDictionary().
+ */
+int XMLValidator::addEntityName(const std::string& strName)
+{
+    if (strName == "amp" ||
+        strName == "lt" ||
+        strName == "gt" ||
+        strName == "apos" ||
+        strName == "quot")
+    {
+        throw new std::invalid_argument("Redefinition of built-in entity.");
+    }
+
+    m_aEntityReplacementDictionary[strName] = std::string();
+    return 0;
+}
+
+/**
+ * @brief Accepts a root element after the end of another one, for input
+ *     of several documents written into the same stream, see
+ *     XMLEventReader::setMultipleDocuments(). There still needs to be at
+ *     least one.
+ */
+void XMLValidator::setMultipleDocuments(bool bMultipleDocuments)
+{
+    m_aHandler.m_bMultipleDocuments = bMultipleDocuments;
+}
+
+/**
+ * @retval true if the nLength bytes at pData are well-formed, false with
+ *     getError() telling the first error otherwise.
+ */
+bool XMLValidator::validate(const char* pData, std::size_t nLength)
+{
+    m_aScanner.setInput(pData, nLength);
+
+    return Validate();
+}
+
+/**
+ * @brief Same as validate() for input in memory, aStream gets read a
+ *     block at a time while scanning.
+ */
+bool XMLValidator::validate(std::istream& aStream)
+{
+    std::streambuf* pSource = aStream.rdbuf();
+
+    if (aStream.good() != true ||
+        pSource == nullptr)
+    {
+        m_aHandler.reset();
+        m_aError = XMLStreamError(XMLStreamError::ERROR_STREAM_BAD, Location());
+        return false;
+    }
+
+    m_aScanner.setSource(pSource);
+
+    return Validate();
+}
+
+const XMLStreamError& XMLValidator::getError() const
+{
+    return m_aError;
+}
+
+/**
+ * @retval Counts of the last validate(), up to its error if it failed.
+ */
+const XMLValidator::Stats& XMLValidator::getStats() const
+{
+    return m_aHandler.m_aStats;
+}
+
+bool XMLValidator::Validate()
+{
+    m_aHandler.reset();
+    m_aError = XMLStreamError();
+
+    while (true)
+    {
+        std::size_t nBegin = m_aScanner.getPosition();
+
+        if (m_aScanner.scanConstruct() != true)
+        {
+            m_aHandler.m_aStats.m_nBytes = m_aScanner.getPosition();
+            m_aError = m_aScanner.getError();
+
+            if (m_aError.getCode() != XMLStreamError::ERROR_NONE)
+            {
+                return false;
+            }
+
+            if (m_aHandler.m_bRootElement != true)
+            {
+                m_aError = XMLStreamError(XMLStreamError::ERROR_ROOT_ELEMENT_MISSING, m_aScanner.getLocation());
+                return false;
+            }
+
+            return true;
+        }
+
+        if (m_aHandler.m_eViolation != XMLStreamError::ERROR_NONE)
+        {
+            m_aHandler.m_aStats.m_nBytes = nBegin;
+            m_aError = XMLStreamError(m_aHandler.m_eViolation, m_aScanner.getLocation(nBegin), m_aHandler.m_strViolation);
+            return false;
+        }
+    }
+}
+
+XMLValidator::CountingHandler::CountingHandler():
+  m_bMultipleDocuments(false)
+{
+    reset();
+}
+
+void XMLValidator::CountingHandler::reset()
+{
+    m_aStats.m_nElements = 0;
+    m_aStats.m_nAttributes = 0;
+    m_aStats.m_nMaxDepth = 0;
+    m_aStats.m_nBytes = 0;
+    m_nDepth = 0;
+    m_bRootElement = false;
+    m_eViolation = XMLStreamError::ERROR_NONE;
+    m_strViolation.clear();
+    m_strAttributeNames.clear();
+    m_aAttributeNames.clear();
+}
+
+void XMLValidator::CountingHandler::onStartElement(const XMLSpan&, const XMLSpan&)
+{
+    if (m_nDepth <= 0)
+    {
+        if (m_bRootElement == true &&
+            m_bMultipleDocuments != true)
+        {
+            Violate(XMLStreamError::ERROR_ROOT_ELEMENT_MULTIPLE);
+        }
+
+        m_bRootElement = true;
+    }
+
+    ++m_aStats.m_nElements;
+    ++m_nDepth;
+
+    if (m_nDepth > m_aStats.m_nMaxDepth)
+    {
+        m_aStats.m_nMaxDepth = m_nDepth;
+    }
+
+    m_strAttributeNames.clear();
+    m_aAttributeNames.clear();
+}
+
+/**
+ * @brief The name is appended as written, prefix included, and compared
+ *     with those of the attributes before it in the same start tag.
+ */
+void XMLValidator::CountingHandler::onAttribute(const XMLSpan& aPrefix, const XMLSpan& aLocalPart, const XMLSpan&)
+{
+    ++m_aStats.m_nAttributes;
+
+    std::size_t nStart = m_strAttributeNames.length();
+
+    if (aPrefix.m_nLength > 0)
+    {
+        m_strAttributeNames.append(aPrefix.m_pData, aPrefix.m_nLength);
+        m_strAttributeNames.push_back(':');
+    }
+
+    m_strAttributeNames.append(aLocalPart.m_pData, aLocalPart.m_nLength);
+
+    std::size_t nLength = m_strAttributeNames.length() - nStart;
+    std::size_t nOther = 0;
+
+    for (std::size_t i = 0; i < m_aAttributeNames.size(); i++)
+    {
+        if (m_aAttributeNames[i] == nLength &&
+            m_strAttributeNames.compare(nOther, nLength, m_strAttributeNames, nStart, nLength) == 0)
+        {
+            if (m_eViolation == XMLStreamError::ERROR_NONE)
+            {
+                m_strViolation = m_strAttributeNames.substr(nStart);
+            }
+
+            Violate(XMLStreamError::ERROR_ATTRIBUTE_DUPLICATE);
+            break;
+        }
+
+        nOther += m_aAttributeNames[i];
+    }
+
+    m_aAttributeNames.push_back(nLength);
+}
+
+void XMLValidator::CountingHandler::onEndElement(const XMLSpan&, const XMLSpan&)
+{
+    --m_nDepth;
+}
+
+/**
+ * @brief Outside of the root element, only whitespace is allowed.
+ */
+void XMLValidator::CountingHandler::onText(const XMLSpan& aText)
+{
+    if (m_nDepth > 0)
+    {
+        return;
+    }
+
+    for (std::size_t i = 0; i < aText.m_nLength; i++)
+    {
+        char cByte = aText.m_pData[i];
+
+        if (cByte != ' ' &&
+            cByte != '\t' &&
+            cByte != '\r' &&
+            cByte != '\n')
+        {
+            Violate(XMLStreamError::ERROR_TEXT_OUTSIDE_ROOT_ELEMENT);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Only the first violation is kept.
+ */
+void XMLValidator::CountingHandler::Violate(XMLStreamError::Code eCode)
+{
+    if (m_eViolation == XMLStreamError::ERROR_NONE)
+    {
+        m_eViolation = eCode;
+    }
+}
+
+}
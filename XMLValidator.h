@@ -0,0 +1,124 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLValidator.h
+ * @brief Checks a document for well-formedness without constructing
+ *     events.
+ * @details A XMLScanner with the XMLValidatingPolicy and a handler which
+ *     only counts, so the grammar is the one of XMLEventReader (tags,
+ *     attributes, entity references, comments and processing
+ *     instructions), and in addition every end tag needs to match the
+ *     innermost open start tag and all elements need to be closed at the
+ *     end of the input. The input needs to have exactly one root element,
+ *     with nothing but whitespace, comments and processing instructions
+ *     around it, and no start tag may have the same attribute twice. Like
+ *     with XMLEventReader, CDATA sections and the document type
+ *     declaration are rejected as not supported. No strings or QNames are
+ *     created for what gets scanned. Errors are the same as those of
+ *     XMLEventReader, with the location always known.
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#ifndef _CPPSTAX_XMLVALIDATOR_H
+#define _CPPSTAX_XMLVALIDATOR_H
+
+#include "XMLScanner.h"
+#include "XMLParserPolicy.h"
+#include "XMLContentHandler.h"
+#include "XMLStreamError.h"
+#include <istream>
+#include <string>
+#include <map>
+#include <vector>
+#include <cstddef>
+
+namespace cppstax
+{
+
+class XMLValidator
+{
+public:
+    /** Of the input up to where the last validate() stopped. */
+    struct Stats
+    {
+        unsigned long long m_nElements;
+        unsigned long long m_nAttributes;
+        std::size_t m_nMaxDepth;
+        unsigned long long m_nBytes;
+    };
+
+public:
+    XMLValidator();
+
+public:
+    int addEntityName(const std::string& strName);
+    void setMultipleDocuments(bool bMultipleDocuments);
+    bool validate(const char* pData, std::size_t nLength);
+    bool validate(std::istream& aStream);
+    const XMLStreamError& getError() const;
+    const Stats& getStats() const;
+
+protected:
+    /**
+     * @brief Counts what gets reported and records the first violation
+     *     of the checks the scanner doesn't do itself.
+     */
+    class CountingHandler : public XMLContentHandler
+    {
+    public:
+        CountingHandler();
+
+    public:
+        void reset();
+        void onStartElement(const XMLSpan& aPrefix, const XMLSpan& aLocalPart);
+        void onAttribute(const XMLSpan& aPrefix, const XMLSpan& aLocalPart, const XMLSpan& aValue);
+        void onEndElement(const XMLSpan& aPrefix, const XMLSpan& aLocalPart);
+        void onText(const XMLSpan& aText);
+
+    public:
+        Stats m_aStats;
+        bool m_bMultipleDocuments;
+        std::size_t m_nDepth;
+        bool m_bRootElement;
+        XMLStreamError::Code m_eViolation;
+        std::string m_strViolation;
+        /** Attribute names of the current start tag one after another,
+          * and their lengths. */
+        std::string m_strAttributeNames;
+        std::vector<std::size_t> m_aAttributeNames;
+
+    protected:
+        void Violate(XMLStreamError::Code eCode);
+
+    };
+
+protected:
+    bool Validate();
+
+protected:
+    /** The names of addEntityName(), with empty replacement text. */
+    std::map<std::string, std::string> m_aEntityReplacementDictionary;
+    CountingHandler m_aHandler;
+    XMLScanner<XMLValidatingPolicy, CountingHandler> m_aScanner;
+    XMLStreamError m_aError;
+
+};
+
+}
+
+#endif
@@ -0,0 +1,692 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLValueParser.cpp
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#include "XMLValueParser.h"
+#include <limits>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+
+namespace cppstax
+{
+
+namespace
+{
+
+/** Powers of ten which are exact as double. */
+const double POWERS_OF_TEN[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/** Mantissas up to this are exact as double. */
+const unsigned long long EXACT_MANTISSA = 1ULL << 53;
+
+/**
+ * Significant digits which can decide the rounding of a double, the
+ * ones behind are dropped by the slow path of parseDouble().
+ */
+const std::size_t SIGNIFICANT_DIGITS_MAX = 767;
+
+}
+
+bool XMLValueParser::parseInt64(const char* pData, std::size_t nLength, long long& nValue)
+{
+    const char* pBegin = pData;
+    const char* pEnd = pData + nLength;
+    bool bNegative = false;
+
+    Trim(pBegin, pEnd);
+
+    if (pBegin < pEnd &&
+        (*pBegin == '-' || *pBegin == '+'))
+    {
+        bNegative = *pBegin == '-';
+        ++pBegin;
+    }
+
+    unsigned long long nMagnitude = 0;
+
+    if (ParseDigits(pBegin, pEnd, nMagnitude) != true)
+    {
+        return false;
+    }
+
+    if (bNegative == true)
+    {
+        if (nMagnitude > static_cast<unsigned long long>(std::numeric_limits<long long>::max()) + 1)
+        {
+            return false;
+        }
+
+        nValue = static_cast<long long>(0 - nMagnitude);
+    }
+    else
+    {
+        if (nMagnitude > static_cast<unsigned long long>(std::numeric_limits<long long>::max()))
+        {
+            return false;
+        }
+
+        nValue = static_cast<long long>(nMagnitude);
+    }
+
+    return true;
+}
+
+bool XMLValueParser::parseUInt64(const char* pData, std::size_t nLength, unsigned long long& nValue)
+{
+    const char* pBegin = pData;
+    const char* pEnd = pData + nLength;
+
+    Trim(pBegin, pEnd);
+
+    if (pBegin < pEnd &&
+        *pBegin == '+')
+    {
+        ++pBegin;
+    }
+
+    return ParseDigits(pBegin, pEnd, nValue);
+}
+
+/**
+ * @brief Up to 19 significant digits with a decimal exponent of at most
+ *     22 get converted exactly with a single multiplication or division.
+ *     Other values get rewritten into a buffer on the stack as integer
+ *     digits with an exponent for std::strtod(), which without decimal
+ *     point doesn't depend on the locale.
+ */
+bool XMLValueParser::parseDouble(const char* pData, std::size_t nLength, double& fValue)
+{
+    const char* pBegin = pData;
+    const char* pEnd = pData + nLength;
+
+    Trim(pBegin, pEnd);
+
+    if (Equals(pBegin, pEnd, "INF") == true ||
+        Equals(pBegin, pEnd, "+INF") == true)
+    {
+        fValue = std::numeric_limits<double>::infinity();
+        return true;
+    }
+    else if (Equals(pBegin, pEnd, "-INF") == true)
+    {
+        fValue = -std::numeric_limits<double>::infinity();
+        return true;
+    }
+    else if (Equals(pBegin, pEnd, "NaN") == true)
+    {
+        fValue = std::numeric_limits<double>::quiet_NaN();
+        return true;
+    }
+
+    const char* pPosition = pBegin;
+    bool bNegative = false;
+
+    if (pPosition < pEnd &&
+        (*pPosition == '-' || *pPosition == '+'))
+    {
+        bNegative = *pPosition == '-';
+        ++pPosition;
+    }
+
+    unsigned long long nMantissa = 0;
+    int nSignificant = 0;
+    int nExponent = 0;
+    int nExplicit = 0;
+    bool bDigits = false;
+    bool bExact = true;
+
+    for (; pPosition < pEnd && *pPosition >= '0' && *pPosition <= '9'; pPosition++)
+    {
+        bDigits = true;
+
+        if (nMantissa == 0 &&
+            *pPosition == '0')
+        {
+            continue;
+        }
+
+        if (nSignificant < 19)
+        {
+            nMantissa = nMantissa * 10 + (*pPosition - '0');
+            ++nSignificant;
+        }
+        else
+        {
+            bExact = false;
+        }
+    }
+
+    if (pPosition < pEnd &&
+        *pPosition == '.')
+    {
+        ++pPosition;
+
+        for (; pPosition < pEnd && *pPosition >= '0' && *pPosition <= '9'; pPosition++)
+        {
+            bDigits = true;
+
+            if (nMantissa == 0 &&
+                *pPosition == '0')
+            {
+                --nExponent;
+                continue;
+            }
+
+            if (nSignificant < 19)
+            {
+                nMantissa = nMantissa * 10 + (*pPosition - '0');
+                ++nSignificant;
+                --nExponent;
+            }
+            else
+            {
+                bExact = false;
+            }
+        }
+    }
+
+    if (bDigits != true)
+    {
+        return false;
+    }
+
+    if (pPosition < pEnd &&
+        (*pPosition == 'e' || *pPosition == 'E'))
+    {
+        ++pPosition;
+
+        bool bExponentNegative = false;
+
+        if (pPosition < pEnd &&
+            (*pPosition == '-' || *pPosition == '+'))
+        {
+            bExponentNegative = *pPosition == '-';
+            ++pPosition;
+        }
+
+        if (pPosition >= pEnd)
+        {
+            return false;
+        }
+
+        for (; pPosition < pEnd && *pPosition >= '0' && *pPosition <= '9'; pPosition++)
+        {
+            if (nExplicit < 100000)
+            {
+                nExplicit = nExplicit * 10 + (*pPosition - '0');
+            }
+        }
+
+        if (bExponentNegative == true)
+        {
+            nExplicit = -nExplicit;
+        }
+
+        nExponent += nExplicit;
+    }
+
+    if (pPosition != pEnd)
+    {
+        return false;
+    }
+
+    if (nMantissa == 0)
+    {
+        fValue = bNegative == true ? -0.0 : 0.0;
+        return true;
+    }
+
+    if (bExact == true &&
+        nMantissa <= EXACT_MANTISSA &&
+        nExponent >= -22 &&
+        nExponent <= 22)
+    {
+        fValue = static_cast<double>(nMantissa);
+
+        if (nExponent < 0)
+        {
+            fValue /= POWERS_OF_TEN[-nExponent];
+        }
+        else
+        {
+            fValue *= POWERS_OF_TEN[nExponent];
+        }
+
+        if (bNegative == true)
+        {
+            fValue = -fValue;
+        }
+
+        return true;
+    }
+
+    // Sign, digits, 'e' and an exponent of up to 20 characters.
+    char aBuffer[SIGNIFICANT_DIGITS_MAX + 24];
+    std::size_t nBuffer = 0;
+    std::size_t nDigits = 0;
+    long long nShift = nExplicit;
+    bool bFraction = false;
+
+    if (bNegative == true)
+    {
+        aBuffer[nBuffer++] = '-';
+    }
+
+    for (pPosition = pBegin; pPosition < pEnd && *pPosition != 'e' && *pPosition != 'E'; pPosition++)
+    {
+        if (*pPosition == '.')
+        {
+            bFraction = true;
+        }
+        else if (*pPosition < '0' || *pPosition > '9')
+        {
+            // Sign.
+            continue;
+        }
+        else if (nDigits == 0 &&
+                 *pPosition == '0')
+        {
+            if (bFraction == true)
+            {
+                --nShift;
+            }
+        }
+        else if (nDigits < SIGNIFICANT_DIGITS_MAX)
+        {
+            aBuffer[nBuffer++] = *pPosition;
+            ++nDigits;
+
+            if (bFraction == true)
+            {
+                --nShift;
+            }
+        }
+        else if (bFraction != true)
+        {
+            ++nShift;
+        }
+    }
+
+    aBuffer[nBuffer++] = 'e';
+
+    if (nShift < 0)
+    {
+        aBuffer[nBuffer++] = '-';
+        nShift = -nShift;
+    }
+
+    char aExponent[20];
+    std::size_t nExponentLength = 0;
+
+    do
+    {
+        aExponent[nExponentLength++] = static_cast<char>('0' + nShift % 10);
+        nShift /= 10;
+
+    } while (nShift > 0);
+
+    while (nExponentLength > 0)
+    {
+        aBuffer[nBuffer++] = aExponent[--nExponentLength];
+    }
+
+    aBuffer[nBuffer] = '\0';
+
+    double fResult = std::strtod(aBuffer, nullptr);
+
+    if (std::isinf(fResult) == true)
+    {
+        // Out of the range of double.
+        return false;
+    }
+
+    fValue = fResult;
+    return true;
+}
+
+bool XMLValueParser::parseBool(const char* pData, std::size_t nLength, bool& bValue)
+{
+    const char* pBegin = pData;
+    const char* pEnd = pData + nLength;
+
+    Trim(pBegin, pEnd);
+
+    if (Equals(pBegin, pEnd, "true") == true ||
+        Equals(pBegin, pEnd, "1") == true)
+    {
+        bValue = true;
+        return true;
+    }
+    else if (Equals(pBegin, pEnd, "false") == true ||
+             Equals(pBegin, pEnd, "0") == true)
+    {
+        bValue = false;
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Decodes base64 into a buffer of the caller. Whitespace may occur
+ *     anywhere, as in XML Schema base64Binary.
+ * @param nSize Number of bytes pBuffer can take.
+ * @param nDecoded Number of bytes decoded. If pBuffer was too small,
+ *     the number of bytes needed, with only nSize of them written.
+ * @retval false if the value isn't valid base64 or pBuffer was too small,
+ *     nDecoded being greater than nSize in the latter case.
+ */
+bool XMLValueParser::parseBase64(const char* pData, std::size_t nLength, unsigned char* pBuffer, std::size_t nSize, std::size_t& nDecoded)
+{
+    const char* pEnd = pData + nLength;
+    std::size_t nOutput = 0;
+    unsigned long nGroup = 0;
+    int nDigits = 0;
+    int nPadding = 0;
+
+    nDecoded = 0;
+
+    for (const char* pPosition = pData; pPosition < pEnd; pPosition++)
+    {
+        if (IsWhitespace(*pPosition) == true)
+        {
+            continue;
+        }
+
+        if (*pPosition == '=')
+        {
+            // Only 2 or 3 digits of a group can be followed by padding.
+            if (nDigits + nPadding < 2 ||
+                nDigits + nPadding >= 4)
+            {
+                return false;
+            }
+
+            ++nPadding;
+            continue;
+        }
+
+        int nDigit = Base64Digit(*pPosition);
+
+        if (nDigit < 0 ||
+            nPadding > 0)
+        {
+            return false;
+        }
+
+        nGroup = (nGroup << 6) | nDigit;
+        ++nDigits;
+
+        if (nDigits == 4)
+        {
+            const unsigned char aBytes[3] = {
+                static_cast<unsigned char>(nGroup >> 16),
+                static_cast<unsigned char>(nGroup >> 8),
+                static_cast<unsigned char>(nGroup)
+            };
+
+            for (int i = 0; i < 3; i++, nOutput++)
+            {
+                if (nOutput < nSize)
+                {
+                    pBuffer[nOutput] = aBytes[i];
+                }
+            }
+
+            nGroup = 0;
+            nDigits = 0;
+        }
+    }
+
+    if (nDigits > 0)
+    {
+        if (nDigits + nPadding != 4)
+        {
+            return false;
+        }
+
+        nGroup <<= 6 * nPadding;
+
+        const unsigned char aBytes[2] = {
+            static_cast<unsigned char>(nGroup >> 16),
+            static_cast<unsigned char>(nGroup >> 8)
+        };
+
+        for (int i = 0; i < nDigits - 1; i++, nOutput++)
+        {
+            if (nOutput < nSize)
+            {
+                pBuffer[nOutput] = aBytes[i];
+            }
+        }
+    }
+
+    nDecoded = nOutput;
+
+    return nOutput <= nSize;
+}
+
+/**
+ * @brief Appends the character of a character reference as UTF-8.
+ * @param pName What's between '&' and ';', like "#9" or "#x9".
+ * @retval false if it isn't a reference to a character XML allows.
+ */
+bool XMLValueParser::parseCharacterReference(const char* pName, std::size_t nLength, std::string& strText)
+{
+    const char* pPosition = pName + 1;
+    const char* pEnd = pName + nLength;
+    unsigned long nCodePoint = 0;
+
+    if (nLength < 2 ||
+        pName[0] != '#')
+    {
+        return false;
+    }
+
+    if (*pPosition == 'x')
+    {
+        ++pPosition;
+
+        if (pPosition >= pEnd)
+        {
+            return false;
+        }
+
+        for (; pPosition < pEnd; pPosition++)
+        {
+            int nDigit = -1;
+
+            if (*pPosition >= '0' && *pPosition <= '9')
+            {
+                nDigit = *pPosition - '0';
+            }
+            else if (*pPosition >= 'a' && *pPosition <= 'f')
+            {
+                nDigit = *pPosition - 'a' + 10;
+            }
+            else if (*pPosition >= 'A' && *pPosition <= 'F')
+            {
+                nDigit = *pPosition - 'A' + 10;
+            }
+
+            if (nDigit < 0 ||
+                nCodePoint > 0x10FFFF)
+            {
+                return false;
+            }
+
+            nCodePoint = nCodePoint * 16 + nDigit;
+        }
+    }
+    else
+    {
+        for (; pPosition < pEnd; pPosition++)
+        {
+            if (*pPosition < '0' ||
+                *pPosition > '9' ||
+                nCodePoint > 0x10FFFF)
+            {
+                return false;
+            }
+
+            nCodePoint = nCodePoint * 10 + (*pPosition - '0');
+        }
+    }
+
+    if (nCodePoint == 0 ||
+        nCodePoint > 0x10FFFF ||
+        (nCodePoint >= 0xD800 && nCodePoint <= 0xDFFF))
+    {
+        return false;
+    }
+
+    if (nCodePoint < 0x80)
+    {
+        strText.push_back(static_cast<char>(nCodePoint));
+    }
+    else if (nCodePoint < 0x800)
+    {
+        strText.push_back(static_cast<char>(0xC0 | (nCodePoint >> 6)));
+        strText.push_back(static_cast<char>(0x80 | (nCodePoint & 0x3F)));
+    }
+    else if (nCodePoint < 0x10000)
+    {
+        strText.push_back(static_cast<char>(0xE0 | (nCodePoint >> 12)));
+        strText.push_back(static_cast<char>(0x80 | ((nCodePoint >> 6) & 0x3F)));
+        strText.push_back(static_cast<char>(0x80 | (nCodePoint & 0x3F)));
+    }
+    else
+    {
+        strText.push_back(static_cast<char>(0xF0 | (nCodePoint >> 18)));
+        strText.push_back(static_cast<char>(0x80 | ((nCodePoint >> 12) & 0x3F)));
+        strText.push_back(static_cast<char>(0x80 | ((nCodePoint >> 6) & 0x3F)));
+        strText.push_back(static_cast<char>(0x80 | (nCodePoint & 0x3F)));
+    }
+
+    return true;
+}
+
+/**
+ * @brief Removes the whitespace XML knows (space, tab, carriage return,
+ *     line feed) from both ends.
+ */
+void XMLValueParser::Trim(const char*& pBegin, const char*& pEnd)
+{
+    while (pBegin < pEnd &&
+           IsWhitespace(*pBegin) == true)
+    {
+        ++pBegin;
+    }
+
+    while (pEnd > pBegin &&
+           IsWhitespace(pEnd[-1]) == true)
+    {
+        --pEnd;
+    }
+}
+
+/**
+ * @retval false if there isn't at least one digit, anything else or the
+ *     value doesn't fit.
+ */
+bool XMLValueParser::ParseDigits(const char* pBegin, const char* pEnd, unsigned long long& nValue)
+{
+    if (pBegin >= pEnd)
+    {
+        return false;
+    }
+
+    unsigned long long nResult = 0;
+
+    for (; pBegin < pEnd; pBegin++)
+    {
+        if (*pBegin < '0' ||
+            *pBegin > '9')
+        {
+            return false;
+        }
+
+        unsigned int nDigit = *pBegin - '0';
+
+        if (nResult > (std::numeric_limits<unsigned long long>::max() - nDigit) / 10)
+        {
+            return false;
+        }
+
+        nResult = nResult * 10 + nDigit;
+    }
+
+    nValue = nResult;
+
+    return true;
+}
+
+bool XMLValueParser::Equals(const char* pBegin, const char* pEnd, const char* pLiteral)
+{
+    std::size_t nLength = std::strlen(pLiteral);
+
+    return static_cast<std::size_t>(pEnd - pBegin) == nLength &&
+           std::memcmp(pBegin, pLiteral, nLength) == 0;
+}
+
+bool XMLValueParser::IsWhitespace(char cByte)
+{
+    return cByte == ' ' ||
+           cByte == '\t' ||
+           cByte == '\r' ||
+           cByte == '\n';
+}
+
+/**
+ * @retval Value of a digit of the base64 alphabet, -1 for other bytes.
+ */
+int XMLValueParser::Base64Digit(char cByte)
+{
+    if (cByte >= 'A' && cByte <= 'Z')
+    {
+        return cByte - 'A';
+    }
+    else if (cByte >= 'a' && cByte <= 'z')
+    {
+        return cByte - 'a' + 26;
+    }
+    else if (cByte >= '0' && cByte <= '9')
+    {
+        return cByte - '0' + 52;
+    }
+    else if (cByte == '+')
+    {
+        return 62;
+    }
+    else if (cByte == '/')
+    {
+        return 63;
+    }
+
+    return -1;
+}
+
+}
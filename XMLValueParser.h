@@ -0,0 +1,60 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/XMLValueParser.h
+ * @brief Converts text and attribute values to numbers and booleans
+ *     directly from the bytes, without allocation and independent of the
+ *     locale.
+ * @details Accepted are the lexical forms of the XML Schema types long,
+ *     unsignedLong, double, boolean and base64Binary, with whitespace
+ *     around them, and character references for the readers.
+ *     Values out of the range of the type aren't accepted.
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#ifndef _CPPSTAX_XMLVALUEPARSER_H
+#define _CPPSTAX_XMLVALUEPARSER_H
+
+#include <string>
+#include <cstddef>
+
+namespace cppstax
+{
+
+class XMLValueParser
+{
+public:
+    static bool parseInt64(const char* pData, std::size_t nLength, long long& nValue);
+    static bool parseUInt64(const char* pData, std::size_t nLength, unsigned long long& nValue);
+    static bool parseDouble(const char* pData, std::size_t nLength, double& fValue);
+    static bool parseBool(const char* pData, std::size_t nLength, bool& bValue);
+    static bool parseBase64(const char* pData, std::size_t nLength, unsigned char* pBuffer, std::size_t nSize, std::size_t& nDecoded);
+    static bool parseCharacterReference(const char* pName, std::size_t nLength, std::string& strText);
+
+protected:
+    static void Trim(const char*& pBegin, const char*& pEnd);
+    static bool ParseDigits(const char* pBegin, const char* pEnd, unsigned long long& nValue);
+    static bool Equals(const char* pBegin, const char* pEnd, const char* pLiteral);
+    static bool IsWhitespace(char cByte);
+    static int Base64Digit(char cByte);
+
+};
+
+}
+
+#endif
@@ -0,0 +1,623 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/benchmark/bench.cpp
+ * @brief Measures XMLEventReader on a generated corpus of several document
+ *     shapes, and the construct routines of its XMLScanner on their own.
+ * @details Usage: bench [megabytes per shape], or bench --generate
+ *     <directory> [megabytes per shape] to write the corpus to files
+ *     instead. The corpus depends only on the size, so numbers of
+ *     different builds compare. Each measurement is the best of several
+ *     runs. Built with ALLOCATION_STATS=1, the allocations of each
+ *     shape get reported per AllocationStats category as well (timings
+ *     include the accounting then).
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#include "../XMLEventReader.h"
+#include "../XMLEvent.h"
+#include "../MemoryStreamBuffer.h"
+#include "../AllocationStats.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <list>
+#include <stdexcept>
+#include <memory>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+
+namespace
+{
+
+const int RUNS = 3;
+const std::size_t DEFAULT_MEGABYTES = 4;
+/** Constructs of each kind a construct routine gets measured on. */
+const std::size_t PROBE_CONSTRUCTS = 100000;
+
+/**
+ * @brief Linear congruential generator, so the corpus doesn't depend on
+ *     the implementation of the standard library.
+ */
+class Random
+{
+public:
+    Random(std::uint32_t nSeed):
+      m_nState(nSeed)
+    {
+
+    }
+
+public:
+    std::uint32_t next(std::uint32_t nBound)
+    {
+        m_nState = m_nState * 1664525u + 1013904223u;
+        return (m_nState >> 8) % nBound;
+    }
+
+    std::string word()
+    {
+        static const char* const WORDS[] = {
+            "lorem", "ipsum", "dolor", "sit", "amet", "consectetur",
+            "adipiscing", "elit", "sed", "do", "eiusmod", "tempor",
+            "incididunt", "ut", "labore", "et", "dolore", "magna", "aliqua"
+        };
+
+        return WORDS[next(sizeof(WORDS) / sizeof(WORDS[0]))];
+    }
+
+protected:
+    std::uint32_t m_nState;
+
+};
+
+/**
+ * @brief Declares the entities of the corpus beyond the built-in ones.
+ */
+void AddEntities(cppstax::XMLEventReader& aReader)
+{
+    aReader.addToEntityReplacementDictionary("copy", "\xC2\xA9");
+    aReader.addToEntityReplacementDictionary("nbsp", "\xC2\xA0");
+}
+
+struct Shape
+{
+    const char* m_pName;
+    std::string (*m_pGenerate)(std::size_t nSize);
+    bool m_bMultipleDocuments;
+};
+
+std::string GenerateTextHeavy(std::size_t nSize)
+{
+    Random aRandom(1);
+    std::ostringstream aOutput;
+
+    aOutput << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<book>\n";
+
+    while (static_cast<std::size_t>(aOutput.tellp()) < nSize)
+    {
+        aOutput << "  <p>";
+
+        for (std::uint32_t i = 0, nWords = 100 + aRandom.next(400); i < nWords; i++)
+        {
+            aOutput << aRandom.word() << (aRandom.next(12) == 0 ? ".\n" : " ");
+        }
+
+        aOutput << "</p>\n";
+    }
+
+    aOutput << "</book>\n";
+    return aOutput.str();
+}
+
+std::string GenerateAttributeWide(std::size_t nSize)
+{
+    Random aRandom(2);
+    std::ostringstream aOutput;
+
+    aOutput << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<table>\n";
+
+    for (std::size_t nRow = 0; static_cast<std::size_t>(aOutput.tellp()) < nSize; nRow++)
+    {
+        aOutput << "  <row id=\"" << nRow << "\"";
+
+        for (std::uint32_t i = 0, nColumns = 10 + aRandom.next(30); i < nColumns; i++)
+        {
+            const char cDelimiter = aRandom.next(2) == 0 ? '"' : '\'';
+
+            aOutput << (i % 5 == 0 ? "\n      " : " ")
+                    << "c" << i << "=" << cDelimiter
+                    << aRandom.word() << aRandom.next(100000)
+                    << cDelimiter;
+        }
+
+        aOutput << "/>\n";
+    }
+
+    aOutput << "</table>\n";
+    return aOutput.str();
+}
+
+std::string GenerateDeeplyNested(std::size_t nSize)
+{
+    Random aRandom(3);
+    std::ostringstream aOutput;
+
+    aOutput << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<tree>";
+
+    while (static_cast<std::size_t>(aOutput.tellp()) < nSize)
+    {
+        std::uint32_t nDepth = 100 + aRandom.next(400);
+
+        for (std::uint32_t i = 0; i < nDepth; i++)
+        {
+            aOutput << "<n" << (i % 10) << " d=\"" << i << "\">";
+
+            if (aRandom.next(4) == 0)
+            {
+                aOutput << aRandom.word();
+            }
+        }
+
+        for (std::uint32_t i = nDepth; i > 0; i--)
+        {
+            aOutput << "</n" << ((i - 1) % 10) << ">";
+        }
+
+        aOutput << "\n";
+    }
+
+    aOutput << "</tree>\n";
+    return aOutput.str();
+}
+
+std::string GenerateEntityDense(std::size_t nSize)
+{
+    static const char* const REFERENCES[] = {
+        "&amp;", "&lt;", "&gt;", "&quot;", "&apos;", "&copy;", "&nbsp;"
+    };
+
+    Random aRandom(4);
+    std::ostringstream aOutput;
+
+    aOutput << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<code>\n";
+
+    while (static_cast<std::size_t>(aOutput.tellp()) < nSize)
+    {
+        aOutput << "  <line title=\"a &lt; b &amp;&amp; c &gt; d\">";
+
+        for (std::uint32_t i = 0, nTokens = 10 + aRandom.next(40); i < nTokens; i++)
+        {
+            aOutput << REFERENCES[aRandom.next(sizeof(REFERENCES) / sizeof(REFERENCES[0]))];
+
+            if (aRandom.next(2) == 0)
+            {
+                aOutput << aRandom.word();
+            }
+        }
+
+        aOutput << "</line>\n";
+    }
+
+    aOutput << "</code>\n";
+    return aOutput.str();
+}
+
+std::string GenerateCommentHeavy(std::size_t nSize)
+{
+    Random aRandom(5);
+    std::ostringstream aOutput;
+
+    aOutput << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<config>\n";
+
+    while (static_cast<std::size_t>(aOutput.tellp()) < nSize)
+    {
+        aOutput << "  <!-- " << aRandom.word() << " " << aRandom.word() << " - " << aRandom.next(1000) << " -->\n";
+
+        if (aRandom.next(2) == 0)
+        {
+            aOutput << "  <?process " << aRandom.word() << "=\"" << aRandom.next(100) << "\" ?>\n";
+        }
+
+        if (aRandom.next(3) == 0)
+        {
+            aOutput << "  <setting>" << aRandom.word() << "</setting>\n";
+        }
+    }
+
+    aOutput << "</config>\n";
+    return aOutput.str();
+}
+
+std::string GenerateTinyDocuments(std::size_t nSize)
+{
+    Random aRandom(6);
+    std::ostringstream aOutput;
+
+    for (std::size_t nMessage = 0; static_cast<std::size_t>(aOutput.tellp()) < nSize; nMessage++)
+    {
+        aOutput << "<?xml version=\"1.0\"?><message id=\"" << nMessage << "\"><to>" << aRandom.word()
+                << "</to><body>" << aRandom.word() << " " << aRandom.word() << "</body></message>\n";
+    }
+
+    return aOutput.str();
+}
+
+const Shape SHAPES[] = {
+    { "text-heavy", &GenerateTextHeavy, false },
+    { "attribute-wide", &GenerateAttributeWide, false },
+    { "deeply-nested", &GenerateDeeplyNested, false },
+    { "entity-dense", &GenerateEntityDense, false },
+    { "comment-pi-heavy", &GenerateCommentHeavy, false },
+    { "tiny-documents", &GenerateTinyDocuments, true }
+};
+
+/**
+ * @brief Calls a single construct routine of XMLScanner per construct,
+ *     with the read position where XMLScanner::scanConstruct() or
+ *     ScanTag() would call it, and builds the events of XMLEventReader.
+ */
+class RoutineProbe : public cppstax::XMLEventReader
+{
+public:
+    enum Routine
+    {
+        ROUTINE_TAG_START,
+        ROUTINE_TAG_END,
+        ROUTINE_TEXT,
+        ROUTINE_PROCESSING_INSTRUCTION,
+        ROUTINE_COMMENT,
+        ROUTINE_ATTRIBUTE
+    };
+
+public:
+    RoutineProbe(const std::string& strInput):
+      cppstax::XMLEventReader(std::unique_ptr<std::streambuf>(new cppstax::MemoryStreamBuffer(strInput.data(), strInput.length()))),
+      m_aProbeScanner(m_aBuilder)
+    {
+        AddEntities(*this);
+        m_aProbeScanner.setEntityReplacementDictionary(&m_aEntityReplacementDictionary);
+        m_aProbeScanner.setInput(strInput.data(), strInput.length());
+    }
+
+public:
+    /**
+     * @param nPrefix Number of bytes in front of each construct the
+     *     routine expects to be consumed already.
+     * @retval Number of constructs handled.
+     */
+    std::size_t run(Routine eRoutine, std::size_t nPrefix)
+    {
+        std::size_t nCount = 0;
+
+        while (true)
+        {
+            if (eRoutine == ROUTINE_ATTRIBUTE)
+            {
+                m_pPendingAttributes.reset(new std::list<std::unique_ptr<cppstax::Attribute>>);
+            }
+
+            if (m_aProbeScanner.scanRoutine(eRoutine, nPrefix) != true)
+            {
+                break;
+            }
+
+            if (m_pPendingName != nullptr)
+            {
+                PushStartElement();
+            }
+
+            while (m_nEventCount > 0)
+            {
+                PopEvent();
+            }
+
+            ++nCount;
+        }
+
+        return nCount;
+    }
+
+protected:
+    class ProbeScanner : public cppstax::XMLScanner<cppstax::XMLDefaultPolicy, EventBuilder>
+    {
+    public:
+        ProbeScanner(EventBuilder& aBuilder):
+          cppstax::XMLScanner<cppstax::XMLDefaultPolicy, EventBuilder>(aBuilder)
+        {
+
+        }
+
+    public:
+        /**
+         * @retval false at the end of the input.
+         */
+        bool scanRoutine(Routine eRoutine, std::size_t nPrefix)
+        {
+            if (m_nPosition >= m_nEnd)
+            {
+                return false;
+            }
+
+            m_nPosition += nPrefix;
+
+            bool bResult = false;
+
+            switch (eRoutine)
+            {
+            case ROUTINE_TAG_START:
+                bResult = ScanTagStart();
+                break;
+            case ROUTINE_TAG_END:
+                bResult = ScanTagEnd();
+                break;
+            case ROUTINE_TEXT:
+                bResult = ScanText();
+                break;
+            case ROUTINE_PROCESSING_INSTRUCTION:
+                bResult = ScanProcessingInstruction();
+                break;
+            case ROUTINE_COMMENT:
+                bResult = ScanComment();
+                break;
+            case ROUTINE_ATTRIBUTE:
+                bResult = ScanAttribute(m_pData[m_nPosition - 1]);
+                break;
+            }
+
+            if (bResult != true)
+            {
+                throw new std::runtime_error(getError().getMessage());
+            }
+
+            return true;
+        }
+
+    };
+
+protected:
+    ProbeScanner m_aProbeScanner;
+
+};
+
+struct Probe
+{
+    const char* m_pName;
+    RoutineProbe::Routine m_eRoutine;
+    /** Repeated PROBE_CONSTRUCTS times. */
+    const char* m_pConstruct;
+    std::size_t m_nPrefix;
+};
+
+const Probe PROBES[] = {
+    { "ScanTagStart", RoutineProbe::ROUTINE_TAG_START, "<entry id=\"42\" type='t3' lang=\"en\">", 2 },
+    { "ScanTagEnd", RoutineProbe::ROUTINE_TAG_END, "</entry>", 2 },
+    { "ScanText", RoutineProbe::ROUTINE_TEXT, "<Some text of an entry, with &lt;markup&gt; &amp; &copy; in it.", 2 },
+    { "ScanProcessingInstruction", RoutineProbe::ROUTINE_PROCESSING_INSTRUCTION, "<?format width=\"80\" height=\"25\"?>", 2 },
+    { "ScanComment", RoutineProbe::ROUTINE_COMMENT, "<!-- A comment of moderate length. -->", 3 },
+    { "ScanAttribute", RoutineProbe::ROUTINE_ATTRIBUTE, " note=\"a &amp; b\"", 2 }
+};
+
+template<class Function>
+double Best(Function aFunction)
+{
+    double fBest = 0.0;
+
+    for (int i = 0; i < RUNS; i++)
+    {
+        std::chrono::steady_clock::time_point aStart = std::chrono::steady_clock::now();
+
+        aFunction();
+
+        double fSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - aStart).count();
+
+        if (i == 0 || fSeconds < fBest)
+        {
+            fBest = fSeconds;
+        }
+    }
+
+    return fBest;
+}
+
+std::size_t ReadAll(const std::string& strInput, bool bMultipleDocuments)
+{
+    std::unique_ptr<std::streambuf> pBuffer(new cppstax::MemoryStreamBuffer(strInput.data(), strInput.length()));
+    cppstax::XMLEventReader aReader(std::move(pBuffer));
+    std::size_t nEvents = 0;
+
+    AddEntities(aReader);
+    aReader.setMultipleDocuments(bMultipleDocuments);
+
+    while (aReader.hasNext() == true)
+    {
+        aReader.nextEvent();
+        ++nEvents;
+    }
+
+    if (aReader.getError().getCode() != cppstax::XMLStreamError::ERROR_NONE)
+    {
+        throw new std::runtime_error(aReader.getError().getMessage());
+    }
+
+    return nEvents;
+}
+
+void PrintRow(const std::string& strName, double fMegabytes, std::size_t nCount, double fSeconds)
+{
+    std::cout << std::left << std::setw(30) << strName << std::right << std::fixed
+              << std::setw(9) << std::setprecision(2) << fMegabytes
+              << std::setw(12) << nCount
+              << std::setw(10) << std::setprecision(1) << fMegabytes / fSeconds
+              << std::setw(14) << std::setprecision(0) << nCount / fSeconds
+              << std::setw(10) << std::setprecision(1) << fSeconds * 1e9 / nCount << "\n";
+}
+
+void PrintHeader(const char* pFirstColumn, const char* pCountColumn)
+{
+    std::cout << std::left << std::setw(30) << pFirstColumn << std::right
+              << std::setw(9) << "MB"
+              << std::setw(12) << pCountColumn
+              << std::setw(10) << "MB/s"
+              << std::setw(14) << "per second"
+              << std::setw(10) << "ns each" << "\n";
+}
+
+/**
+ * @brief Reads strInput once more and prints per category what got
+ *     allocated for it, per event, and the peak of live bytes.
+ */
+void PrintAllocations(const std::string& strName, const std::string& strInput, bool bMultipleDocuments)
+{
+    cppstax::AllocationStats::reset();
+
+    std::size_t nEvents = ReadAll(strInput, bMultipleDocuments);
+
+    std::cout << std::left << std::setw(20) << strName << std::right << std::fixed;
+
+    for (std::size_t i = 0; i < cppstax::AllocationStats::CATEGORY_COUNT; i++)
+    {
+        cppstax::AllocationStats::Counters aCounters = cppstax::AllocationStats::getCounters(static_cast<cppstax::AllocationStats::Category>(i));
+
+        std::cout << std::setw(7) << std::setprecision(2) << static_cast<double>(aCounters.m_nAllocations) / nEvents
+                  << std::setw(8) << std::setprecision(1) << static_cast<double>(aCounters.m_nBytes) / nEvents
+                  << std::setw(8) << aCounters.m_nPeakLiveBytes / 1024 << "K";
+    }
+
+    std::cout << "\n";
+}
+
+int Generate(const std::string& strDirectory, std::size_t nSize)
+{
+    for (const Shape& aShape : SHAPES)
+    {
+        std::string strPath = strDirectory + "/" + aShape.m_pName + ".xml";
+        std::ofstream aStream(strPath, std::ios::binary);
+
+        if (aStream.is_open() != true)
+        {
+            std::cout << "Couldn't open output file '" << strPath << "'." << std::endl;
+            return -1;
+        }
+
+        aStream << aShape.m_pGenerate(nSize);
+    }
+
+    return 0;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t nMegabytes = DEFAULT_MEGABYTES;
+    int nArgument = 1;
+    std::string strDirectory;
+
+    if (argc > nArgument + 1 &&
+        std::string(argv[nArgument]) == "--generate")
+    {
+        strDirectory = argv[nArgument + 1];
+        nArgument += 2;
+    }
+
+    if (argc > nArgument)
+    {
+        nMegabytes = std::strtoul(argv[nArgument], nullptr, 10);
+
+        if (nMegabytes <= 0)
+        {
+            std::cout << "Usage: bench [--generate <directory>] [megabytes per shape]" << std::endl;
+            return -1;
+        }
+    }
+
+    if (strDirectory.empty() != true)
+    {
+        return Generate(strDirectory, nMegabytes * 1000000);
+    }
+
+    try
+    {
+        std::cout << "XMLEventReader, best of " << RUNS << " runs:\n";
+        PrintHeader("Shape", "events");
+
+        for (const Shape& aShape : SHAPES)
+        {
+            std::string strInput(aShape.m_pGenerate(nMegabytes * 1000000));
+            std::size_t nEvents = 0;
+
+            double fSeconds = Best([&]() {
+                nEvents = ReadAll(strInput, aShape.m_bMultipleDocuments);
+            });
+
+            PrintRow(aShape.m_pName, strInput.length() / 1000000.0, nEvents, fSeconds);
+        }
+
+        if (cppstax::AllocationStats::isEnabled() == true)
+        {
+            std::cout << "\nAllocations and bytes per event, peak live bytes:\n" << std::setw(20) << "";
+
+            for (std::size_t i = 0; i < cppstax::AllocationStats::CATEGORY_COUNT; i++)
+            {
+                std::cout << std::setw(24) << cppstax::AllocationStats::getCategoryName(static_cast<cppstax::AllocationStats::Category>(i));
+            }
+
+            std::cout << "\n";
+
+            for (const Shape& aShape : SHAPES)
+            {
+                PrintAllocations(aShape.m_pName, aShape.m_pGenerate(nMegabytes * 1000000), aShape.m_bMultipleDocuments);
+            }
+        }
+
+        std::cout << "\nXMLScanner routines, " << PROBE_CONSTRUCTS << " constructs each:\n";
+        PrintHeader("Routine", "calls");
+
+        for (const Probe& aProbe : PROBES)
+        {
+            std::string strInput;
+
+            for (std::size_t i = 0; i < PROBE_CONSTRUCTS; i++)
+            {
+                strInput += aProbe.m_pConstruct;
+            }
+
+
+            std::size_t nCalls = 0;
+
+            double fSeconds = Best([&]() {
+                RoutineProbe aRoutineProbe(strInput);
+                nCalls = aRoutineProbe.run(aProbe.m_eRoutine, aProbe.m_nPrefix);
+            });
+
+            PrintRow(aProbe.m_pName, strInput.length() / 1000000.0, nCalls, fSeconds);
+        }
+    }
+    catch (std::exception* pException)
+    {
+        std::cout << "Exception: " << pException->what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,228 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/benchmark/policies.cpp
+ * @brief Compares the prebuilt policies of XMLParserPolicy.h, once with
+ *     XMLPushParser reporting to a handler that only counts, once with the
+ *     events of XMLPolicyEventReader.
+ * @details Usage: policies [input file]. Without an input file, a document
+ *     with text, entity references, attributes, comments and processing
+ *     instructions gets generated. Each measurement is the best of several
+ *     runs.
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#include "../XMLPushParser.h"
+#include "../XMLParserPolicy.h"
+#include "../XMLPolicyEventReader.h"
+#include "../XMLContentHandler.h"
+#include "../MemoryStreamBuffer.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <chrono>
+
+namespace
+{
+
+const int RUNS = 5;
+
+class CountingHandler : public cppstax::XMLContentHandler
+{
+public:
+    CountingHandler():
+      m_nCount(0)
+    {
+
+    }
+
+public:
+    void onStartElement(const cppstax::XMLSpan&, const cppstax::XMLSpan&)
+    {
+        ++m_nCount;
+    }
+
+    void onAttribute(const cppstax::XMLSpan&, const cppstax::XMLSpan&, const cppstax::XMLSpan&)
+    {
+        ++m_nCount;
+    }
+
+    void onEndElement(const cppstax::XMLSpan&, const cppstax::XMLSpan&)
+    {
+        ++m_nCount;
+    }
+
+    void onText(const cppstax::XMLSpan&)
+    {
+        ++m_nCount;
+    }
+
+    void onComment(const cppstax::XMLSpan&)
+    {
+        ++m_nCount;
+    }
+
+    void onProcessingInstruction(const cppstax::XMLSpan&, const cppstax::XMLSpan&)
+    {
+        ++m_nCount;
+    }
+
+public:
+    unsigned long m_nCount;
+
+};
+
+std::string Generate()
+{
+    std::ostringstream aOutput;
+
+    aOutput << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<corpus>\n";
+
+    for (int i = 0; i < 100000; i++)
+    {
+        aOutput << "  <entry id=\"" << i << "\" type=\"t" << (i % 7) << "\" lang='en'>\n"
+                << "    <!-- Entry " << i << " -->\n"
+                << "    <title>Title &amp; subtitle " << i << "</title>\n"
+                << "    <?format width=\"" << (i % 80) << "\"?>\n"
+                << "    <text>Some text of the entry, with &lt;markup&gt; in it and a little more text.</text>\n"
+                << "    <empty flag=\"yes\"/>\n"
+                << "  </entry>\n";
+    }
+
+    aOutput << "</corpus>\n";
+
+    return aOutput.str();
+}
+
+template<class Policy>
+double Scan(const std::string& strInput, unsigned long& nCount)
+{
+    double fBest = 0.0;
+
+    for (int i = 0; i < RUNS; i++)
+    {
+        CountingHandler aHandler;
+        cppstax::XMLPushParser<Policy> aParser;
+
+        std::chrono::steady_clock::time_point aStart = std::chrono::steady_clock::now();
+
+        if (aParser.parse(strInput.data(), strInput.length(), aHandler) != true)
+        {
+            throw new std::runtime_error(aParser.getError().getMessage());
+        }
+
+        double fSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - aStart).count();
+
+        if (i == 0 || fSeconds < fBest)
+        {
+            fBest = fSeconds;
+        }
+
+        nCount = aHandler.m_nCount;
+    }
+
+    return fBest;
+}
+
+template<class Policy>
+double Read(const std::string& strInput, unsigned long& nCount)
+{
+    double fBest = 0.0;
+
+    for (int i = 0; i < RUNS; i++)
+    {
+        std::unique_ptr<std::streambuf> pBuffer(new cppstax::MemoryStreamBuffer(strInput.data(), strInput.length()));
+        cppstax::XMLPolicyEventReader<Policy> aReader(std::move(pBuffer));
+
+        nCount = 0;
+
+        std::chrono::steady_clock::time_point aStart = std::chrono::steady_clock::now();
+
+        while (aReader.hasNext() == true)
+        {
+            aReader.nextEvent();
+            ++nCount;
+        }
+
+        double fSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - aStart).count();
+
+        if (i == 0 || fSeconds < fBest)
+        {
+            fBest = fSeconds;
+        }
+    }
+
+    return fBest;
+}
+
+template<class Policy>
+void Measure(const char* pName, const std::string& strInput)
+{
+    double fMegabytes = strInput.length() / 1000000.0;
+    unsigned long nCallbacks = 0;
+    unsigned long nEvents = 0;
+    double fScan = Scan<Policy>(strInput, nCallbacks);
+    double fRead = Read<Policy>(strInput, nEvents);
+
+    std::cout << pName << ":\n"
+              << "    XMLPushParser:        " << fMegabytes / fScan << " MB/s, " << nCallbacks << " callbacks\n"
+              << "    XMLPolicyEventReader: " << fMegabytes / fRead << " MB/s, " << nEvents << " events\n";
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    std::string strInput;
+
+    if (argc >= 2)
+    {
+        std::ifstream aStream(argv[1], std::ios::binary);
+
+        if (aStream.is_open() != true)
+        {
+            std::cout << "Couldn't open input file '" << argv[1] << "'." << std::endl;
+            return -1;
+        }
+
+        std::ostringstream aBuffer;
+        aBuffer << aStream.rdbuf();
+        strInput = aBuffer.str();
+    }
+    else
+    {
+        strInput = Generate();
+    }
+
+    std::cout << "Input: " << strInput.length() / 1000000.0 << " MB\n";
+
+    try
+    {
+        Measure<cppstax::XMLMinimalPolicy>("XMLMinimalPolicy", strInput);
+        Measure<cppstax::XMLDefaultPolicy>("XMLDefaultPolicy", strInput);
+        Measure<cppstax::XMLFullPolicy>("XMLFullPolicy", strInput);
+    }
+    catch (std::exception* pException)
+    {
+        std::cout << "Exception: " << pException->what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
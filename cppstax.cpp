@@ -22,6 +22,7 @@
  */
 
 #include "XMLInputFactory.h"
+#include "XMLEventWriter.h"
 #include <memory>
 #include <iostream>
 #include <fstream>
@@ -91,6 +92,7 @@ int Run(std::istream& aStream)
 {
     cppstax::XMLInputFactory aFactory;
     XMLEventReader pReader = aFactory.createXMLEventReader(aStream);
+    cppstax::XMLEventWriter aWriter(std::cout);
 
     // Instead of looking at XMLEvents sequentially, one could
     // also implement a "parse tree" to react to XMLEvents, so
@@ -100,126 +102,10 @@ int Run(std::istream& aStream)
     while (pReader->hasNext() == true)
     {
         XMLEvent pEvent = pReader->nextEvent();
-
-        if (pEvent->isStartElement() == true)
-        {
-            cppstax::StartElement& aStartElement = pEvent->asStartElement();
-            const cppstax::QName& aName = aStartElement.getName();
-
-            std::string strTag("<");
-            std::string strPrefix(aName.getPrefix());
-
-            if (!strPrefix.empty())
-            {
-                strTag += strPrefix;
-                strTag += ":";
-            }
-
-            strTag += aName.getLocalPart();
-
-            for (std::list<std::shared_ptr<cppstax::Attribute>>::iterator iter = aStartElement.getAttributes()->begin();
-                 iter != aStartElement.getAttributes()->end();
-                 iter++)
-            {
-                const cppstax::QName& aAttributeName = (*iter)->getName();
-
-                strTag += " ";
-
-                std::string strAttributePrefix(aAttributeName.getPrefix());
-
-                if (!strAttributePrefix.empty())
-                {
-                    strTag += strAttributePrefix;
-                    strTag += ":";
-                }
-
-                strTag += aAttributeName.getLocalPart();
-                strTag += "=\"";
-
-                const std::string& strCharacters((*iter)->getValue());
-
-                for (std::string::const_iterator iter = strCharacters.begin();
-                    iter != strCharacters.end();
-                    iter++)
-                {
-                    switch (*iter)
-                    {
-                    case '\"':
-                        strTag += "&quot;";
-                        break;
-                    default:
-                        strTag += *iter;
-                        break;
-                    }
-                }
-
-                strTag += "\"";
-            }
-
-            strTag += ">";
-
-            std::cout << strTag;
-        }
-        else if (pEvent->isEndElement() == true)
-        {
-            cppstax::EndElement& aEndElement = pEvent->asEndElement();
-            cppstax::QName aName = aEndElement.getName();
-
-            std::string strTag("</");
-            std::string strPrefix(aName.getPrefix());
-
-            if (!strPrefix.empty())
-            {
-                strTag += strPrefix;
-                strTag += ":";
-            }
-
-            strTag += aName.getLocalPart();
-            strTag += ">";
-
-            std::cout << strTag;
-        }
-        else if (pEvent->isCharacters() == true)
-        {
-            cppstax::Characters& aCharacters = pEvent->asCharacters();
-            const std::string& strCharacters(aCharacters.getData());
-
-            for (std::string::const_iterator iter = strCharacters.begin();
-                 iter != strCharacters.end();
-                 iter++)
-            {
-                switch (*iter)
-                {
-                case '&':
-                    std::cout << "&amp;";
-                    break;
-                case '<':
-                    std::cout << "&lt;";
-                    break;
-                case '>':
-                    std::cout << "&gt;";
-                    break;
-                default:
-                    std::cout << *iter;
-                    break;
-                }
-            }
-        }
-        else if (pEvent->isComment() == true)
-        {
-            std::cout << "<!--" << pEvent->asComment().getText() << "-->";
-        }
-        else if (pEvent->isProcessingInstruction() == true)
-        {
-            const cppstax::ProcessingInstruction& aPI = pEvent->asProcessingInstruction();
-
-            std::cout << "<?" << aPI.getTarget() << " " << aPI.getData() << "?>";
-        }
-        else
-        {
-
-        }
+        aWriter.add(*pEvent);
     }
 
+    aWriter.flush();
+
     return 0;
 }
@@ -0,0 +1,1628 @@
+/* Copyright (C) 2026 Stephan Kreutzer
+ *
+ * This file is part of CppStAX.
+ *
+ * CppStAX is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License version 3 or any later
+ * version of the license, as published by the Free Software Foundation.
+ *
+ * CppStAX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Affero General Public License 3 for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License 3
+ * along with CppStAX. If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * @file $/test/regression.cpp
+ * @brief Checks of the components, each case next to the others of its
+ *     component, and of the engines against the events of XMLEventReader
+ *     on the input files.
+ * @details Usage: regression [input files], usually the corpus of
+ *     benchmark/bench --generate, which "make test" generates. Each
+ *     mismatch gets printed, the exit code is the number of them.
+ * @author Stephan Kreutzer
+ * @since 2026-10-19
+ */
+
+#include "../XMLEventReader.h"
+#include "../XMLEvent.h"
+#include "../XMLStructuralEventReader.h"
+#include "../XMLParallelEventReader.h"
+#include "../XMLPipelinedEventReader.h"
+#include "../XMLPolicyEventReader.h"
+#include "../XMLParserPolicy.h"
+#include "../XMLValidator.h"
+#include "../XMLEventWriter.h"
+#include "../XMLDecoder.h"
+#include "../XMLBinding.h"
+#include "../XMLPathExtractor.h"
+#include "../XMLIndex.h"
+#include "../XMLStreamException.h"
+#include "../XMLEventRecorder.h"
+#include "../XMLReplayEventReader.h"
+#include "../XMLTree.h"
+#include "../XMLPushParser.h"
+#include "../XMLContentHandler.h"
+#include "../XMLValueParser.h"
+#include "../AllocationStats.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <memory>
+#include <exception>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <limits>
+#include <list>
+#include <set>
+
+/** Bound structs for CheckDecoder(). */
+struct TestAuthor
+{
+    std::string strName;
+    int nBorn;
+};
+
+struct TestBook
+{
+    std::string strID;
+    std::string strTitle;
+    int nYear;
+    double fPrice;
+    bool bAvailable;
+    std::vector<std::string> aTags;
+    std::vector<TestAuthor> aAuthors;
+};
+
+CPPSTAX_BINDING_BEGIN(TestAuthor)
+    CPPSTAX_BIND("name", strName)
+    CPPSTAX_BIND("@born", nBorn)
+CPPSTAX_BINDING_END()
+
+CPPSTAX_BINDING_BEGIN(TestBook)
+    CPPSTAX_BIND("@id", strID)
+    CPPSTAX_BIND("title", strTitle)
+    CPPSTAX_BIND("info/year", nYear)
+    CPPSTAX_BIND("info/@price", fPrice)
+    CPPSTAX_BIND("available", bAvailable)
+    CPPSTAX_BIND("tags/tag", aTags)
+    CPPSTAX_BIND("authors/author", aAuthors)
+CPPSTAX_BINDING_END()
+
+namespace
+{
+
+int g_nFailures = 0;
+
+void Check(bool bCondition, const std::string& strDescription)
+{
+    if (bCondition != true)
+    {
+        std::cout << "Failed: " << strDescription << std::endl;
+        ++g_nFailures;
+    }
+}
+
+/**
+ * @brief Declares the entities of the corpus beyond the built-in ones,
+ *     same as benchmark/bench.cpp.
+ */
+void Configure(cppstax::XMLEventReader& aReader, bool bMultipleDocuments = false)
+{
+    aReader.setThrowOnError(false);
+    aReader.setMultipleDocuments(bMultipleDocuments);
+    aReader.addToEntityReplacementDictionary("copy", "\xC2\xA9");
+    aReader.addToEntityReplacementDictionary("nbsp", "\xC2\xA0");
+}
+
+/**
+ * @brief One line for aEvent, with the location if tracked and the source
+ *     range if present.
+ */
+void DumpEvent(cppstax::XMLEvent& aEvent, bool bLocations, std::ostream& aOutput)
+{
+    if (bLocations == true)
+    {
+        const cppstax::Location& aLocation = aEvent.getLocation();
+
+        aOutput << aLocation.getCharacterOffset() << ":" << aLocation.getLineNumber() << ":" << aLocation.getColumnNumber() << " ";
+    }
+
+    if (aEvent.isStartDocument() == true)
+    {
+        aOutput << "SD";
+    }
+    else if (aEvent.isEndDocument() == true)
+    {
+        aOutput << "ED";
+    }
+    else if (aEvent.isStartElement() == true)
+    {
+        const cppstax::QName& aName = aEvent.asStartElement().getName();
+
+        aOutput << "S " << aName.getPrefix() << ":" << aName.getLocalPart();
+
+        for (const std::shared_ptr<cppstax::Attribute>& pAttribute : *aEvent.asStartElement().getAttributes())
+        {
+            aOutput << " " << pAttribute->getName().getPrefix() << ":" << pAttribute->getName().getLocalPart() << "=[" << pAttribute->getValue() << "]";
+        }
+    }
+    else if (aEvent.isEndElement() == true)
+    {
+        const cppstax::QName& aName = aEvent.asEndElement().getName();
+
+        aOutput << "E " << aName.getPrefix() << ":" << aName.getLocalPart();
+    }
+    else if (aEvent.isCharacters() == true)
+    {
+        aOutput << "T [" << aEvent.asCharacters().getData() << "]";
+    }
+    else if (aEvent.isComment() == true)
+    {
+        aOutput << "C [" << aEvent.asComment().getText() << "]";
+    }
+    else if (aEvent.isProcessingInstruction() == true)
+    {
+        aOutput << "P [" << aEvent.asProcessingInstruction().getTarget() << "|" << aEvent.asProcessingInstruction().getData() << "]";
+    }
+
+    if (aEvent.hasSourceRange() == true)
+    {
+        aOutput << " @" << aEvent.getSourceOffset() << "+" << aEvent.getSourceLength();
+    }
+
+    aOutput << "\n";
+}
+
+/**
+ * @brief The error of aReader, if any, as the last line of a dump.
+ */
+void DumpError(cppstax::XMLEventReader& aReader, bool bLocations, std::ostream& aOutput)
+{
+    const cppstax::XMLStreamError& aError = aReader.getError();
+
+    if (aError.getCode() != cppstax::XMLStreamError::ERROR_NONE)
+    {
+        aOutput << "error: " << aError.getMessage();
+
+        if (bLocations == true)
+        {
+            aOutput << " at " << aError.getLocation().getCharacterOffset() << ":" << aError.getLocation().getLineNumber() << ":" << aError.getLocation().getColumnNumber();
+        }
+
+        aOutput << "\n";
+    }
+}
+
+/**
+ * @brief One line per event, see DumpEvent(), followed by the error.
+ */
+std::string Dump(cppstax::XMLEventReader& aReader, bool bLocations)
+{
+    std::ostringstream aOutput;
+
+    try
+    {
+        while (aReader.hasNext() == true)
+        {
+            DumpEvent(*aReader.nextEvent(), bLocations, aOutput);
+        }
+    }
+    catch (std::exception* pException)
+    {
+        aOutput << "exception: " << pException->what() << "\n";
+        delete pException;
+    }
+
+    DumpError(aReader, bLocations, aOutput);
+
+    return aOutput.str();
+}
+
+std::string DumpSequential(const std::string& strInput, bool bLocations, bool bMultipleDocuments = false)
+{
+    std::istringstream aStream(strInput);
+    cppstax::XMLEventReader aReader(aStream);
+
+    Configure(aReader, bMultipleDocuments);
+    aReader.setLocationTracking(bLocations);
+
+    return Dump(aReader, bLocations);
+}
+
+std::string DumpParallel(const std::string& strInput, std::size_t nChunkSize, bool bLocations, bool bMultipleDocuments = false)
+{
+    cppstax::XMLParallelEventReader aReader(strInput.data(), strInput.length(), 2);
+
+    aReader.setChunkSize(nChunkSize);
+    Configure(aReader, bMultipleDocuments);
+    aReader.setLocationTracking(bLocations);
+
+    return Dump(aReader, bLocations);
+}
+
+/**
+ * @brief Every event carries the byte offset, line and column of the
+ *     start of its construct, errors the position they were found at.
+ */
+void CheckLocations()
+{
+    Check(DumpSequential("<a x=\"1\">\n  <b/>te\nxt<!--c-->\n<?p d?></a>", true) ==
+          "0:1:1 S :a :x=[1]\n"
+          "9:1:10 T [\n  ]\n"
+          "12:2:3 S :b\n"
+          "12:2:3 E :b\n"
+          "16:2:7 T [te\nxt]\n"
+          "21:3:3 C [c]\n"
+          "29:3:11 T [\n]\n"
+          "30:4:1 P [p|d]\n"
+          "37:4:8 E :a\n",
+          "event locations");
+
+    const std::string strError(DumpSequential("<a>\n <b x></b></a>", true));
+
+    Check(strError.find("error: ") != std::string::npos &&
+          strError.find(" at 10:2:7\n") != std::string::npos,
+          "error location: '" + strError + "'");
+}
+
+/**
+ * @brief Source ranges are the positions of the scanner, so they neither
+ *     need location tracking nor go away when it gets disabled.
+ */
+void CheckSourceRanges()
+{
+    const std::string strInput("<a x=\"1\"><b/>text<!--c--><?p d?></a>");
+    const std::string strExpected("S :a :x=[1] @0+9\n"
+                                  "S :b @9+4\n"
+                                  "E :b @13+0\n"
+                                  "T [text] @13+4\n"
+                                  "C [c] @17+8\n"
+                                  "P [p|d] @25+7\n"
+                                  "E :a @32+4\n");
+
+    for (bool bStructural : { false, true })
+    {
+        std::istringstream aStream(strInput);
+        std::unique_ptr<cppstax::XMLEventReader> pReader(nullptr);
+
+        if (bStructural == true)
+        {
+            pReader.reset(new cppstax::XMLStructuralEventReader(aStream));
+        }
+        else
+        {
+            pReader.reset(new cppstax::XMLEventReader(aStream));
+        }
+
+        Configure(*pReader);
+        pReader->setSourceRanges(true);
+        pReader->setLocationTracking(false);
+
+        Check(Dump(*pReader, false) == strExpected, std::string(bStructural == true ? "structural " : "") + "source ranges after setLocationTracking(false)");
+    }
+}
+
+/**
+ * @brief The parallel reader reports the same events and the
+ *     same first error as the sequential reader, also if the error is an
+ *     entity reference across a chunk boundary.
+ */
+void CheckParallel()
+{
+    std::string strValid("<r>");
+    std::string strInvalid("<r>");
+
+    for (int i = 0; i < 200; i++)
+    {
+        std::string strElement = "<i n=\"" + std::to_string(i) + "\">text " + std::to_string(i) + "</i>";
+
+        strValid += strElement;
+        strInvalid += strElement;
+    }
+
+    strInvalid += "<a>x &foo</a><b>y;</b>";
+
+    for (int i = 0; i < 200; i++)
+    {
+        strValid += "<i>" + std::to_string(i) + "</i>";
+        strInvalid += "<i>" + std::to_string(i) + "</i>";
+    }
+
+    strValid += "<a>x &amp; y</a></r>";
+    strInvalid += "</r>";
+
+    for (std::size_t nChunkSize : { 8, 32, 200, 4096 })
+    {
+        for (bool bLocations : { false, true })
+        {
+            std::string strDescription = "parallel reader, chunks of " + std::to_string(nChunkSize) + (bLocations == true ? " with locations" : "");
+
+            Check(DumpParallel(strValid, nChunkSize, bLocations) == DumpSequential(strValid, bLocations), strDescription);
+            Check(DumpParallel(strInvalid, nChunkSize, bLocations) == DumpSequential(strInvalid, bLocations), strDescription + ", entity error");
+        }
+    }
+}
+
+/**
+ * @brief Whitespace in front of the '>' of a start tag doesn't
+ *     swallow the byte after it, also with the structural index engine,
+ *     which gets empty input as well.
+ */
+void CheckStructural()
+{
+    Check(DumpSequential("<a >x</a>", false) == "S :a\nT [x]\nE :a\n", "sequential reader on '<a >x</a>'");
+
+    const char* const INPUTS[] = {
+        "<a >",
+        "<a >x</a>",
+        "<a b=\"1\" >t</a>",
+        "<a\n\t>t</a >",
+        ""
+    };
+
+    for (const char* pInput : INPUTS)
+    {
+        std::istringstream aStream(pInput);
+        cppstax::XMLStructuralEventReader aReader(aStream);
+
+        Configure(aReader);
+
+        Check(Dump(aReader, false) == DumpSequential(pInput, false), std::string("structural reader on '") + pInput + "'");
+    }
+}
+
+/**
+ * @brief Writes the events of strInput with XMLEventWriter, passing
+ *     them through as their original bytes if bSourceRanges.
+ */
+std::string Write(const std::string& strInput, bool bSourceRanges)
+{
+    std::ostringstream aOutput;
+    std::istringstream aStream(strInput);
+    cppstax::XMLEventReader aReader(aStream);
+    cppstax::XMLEventWriter aWriter(aOutput);
+
+    Configure(aReader);
+    aReader.setSourceRanges(bSourceRanges);
+
+    if (bSourceRanges == true)
+    {
+        aWriter.setSource(strInput.data(), strInput.length());
+    }
+
+    while (aReader.hasNext() == true)
+    {
+        aWriter.add(*aReader.nextEvent());
+    }
+
+    aWriter.flush();
+
+    return aOutput.str();
+}
+
+/**
+ * @brief Processing instructions without data and whitespace in
+ *     attribute values survive XMLEventWriter.
+ */
+void CheckWriter()
+{
+    const std::string strInput("<a x=\"1&#9;2&#10;3&#13;4\" y='\"'><?empty?><?t d?>a&#10;b&lt;<b z=\" \t\"/></a>");
+    const std::string strOutput(Write(strInput, false));
+
+    Check(DumpSequential(strOutput, false) == DumpSequential(strInput, false), "writer round trip: '" + strOutput + "'");
+    // Whitespace other than spaces would get normalized by other
+    // parsers if not written as a character reference.
+    Check(strOutput.find("x=\"1&#9;2&#10;3&#13;4\"") != std::string::npos &&
+          strOutput.find("<?empty?>") != std::string::npos,
+          "writer writes whitespace as references, no separator without data: '" + strOutput + "'");
+}
+
+/**
+ * @brief Events with source ranges get written as their original
+ *     bytes, so an unmodified document comes out unchanged.
+ */
+void CheckPassthrough()
+{
+    const std::string strInput("<a x='1&#9;2' y = \"&amp;\"><?empty?>a&#10;b<!-- c --><b z=\" \t\"/></a>");
+    const std::string strOutput(Write(strInput, true));
+
+    Check(strOutput == strInput, "writer passes through the original bytes: '" + strOutput + "'");
+}
+
+/**
+ * @brief XMLDecoder fills the bound fields, from memory and from a
+ *     stream, skips unbound elements and fails on invalid values and on
+ *     input ending before the end of the root element.
+ */
+void CheckDecoder()
+{
+    const std::string strInput("<?xml version=\"1.0\"?><book id=\"b&amp;1\"><skip><title>no</title></skip>"
+                               "<title>T &lt;1&gt; <b>bold</b>tail</title><info price=\" 12.5 \"><year>\n 1999 </year></info>"
+                               "<available>true</available><tags><tag>a</tag><tag/><tag>c&amp;d</tag></tags>"
+                               "<authors><author born=\"1900\"><name>X</name></author><author born=\"-5\"><name>Y</name></author></authors>"
+                               "</book><after/>");
+
+    for (bool bStream : { false, true })
+    {
+        cppstax::XMLDecoder<> aDecoder;
+        TestBook aBook = TestBook();
+        std::istringstream aStream(strInput);
+        const std::string strDescription(bStream == true ? "decoder from a stream" : "decoder");
+
+        Check((bStream == true ? aDecoder.decode(aStream, aBook) : aDecoder.decode(strInput.data(), strInput.length(), aBook)) == true, strDescription + " accepts");
+        Check(aBook.strID == "b&1" &&
+              aBook.strTitle == "T <1> tail" &&
+              aBook.nYear == 1999 &&
+              aBook.fPrice == 12.5 &&
+              aBook.bAvailable == true,
+              strDescription + " fills the fields");
+        Check(aBook.aTags.size() == 3 &&
+              aBook.aTags[1].empty() == true &&
+              aBook.aTags[2] == "c&d" &&
+              aBook.aAuthors.size() == 2 &&
+              aBook.aAuthors[0].strName == "X" &&
+              aBook.aAuthors[1].nBorn == -5,
+              strDescription + " fills the vectors");
+    }
+
+    const char* const INVALID[] = {
+        "<book><info><year>19x9</year></info></book>",
+        "<book id='b1'><title>trunc",
+        "<book id='b1'>",
+        " <!-- no root --> ",
+        ""
+    };
+    const cppstax::XMLStreamError::Code CODES[] = {
+        cppstax::XMLStreamError::ERROR_BINDING_VALUE_INVALID,
+        cppstax::XMLStreamError::ERROR_ELEMENT_UNCLOSED,
+        cppstax::XMLStreamError::ERROR_ELEMENT_UNCLOSED,
+        cppstax::XMLStreamError::ERROR_ROOT_ELEMENT_MISSING,
+        cppstax::XMLStreamError::ERROR_ROOT_ELEMENT_MISSING
+    };
+
+    for (std::size_t i = 0; i < sizeof(INVALID) / sizeof(INVALID[0]); i++)
+    {
+        cppstax::XMLDecoder<> aDecoder;
+        TestBook aBook = TestBook();
+
+        Check(aDecoder.decode(INVALID[i], std::strlen(INVALID[i]), aBook) != true &&
+              aDecoder.getError().getCode() == CODES[i],
+              std::string("decoder rejects '") + INVALID[i] + "': " + aDecoder.getError().getMessage());
+    }
+}
+
+/**
+ * @brief The EndElement of an empty element tag shares the QName of its
+ *     StartElement, also when handed out by nextEvents(). Events returned
+ *     stay intact when the reader reuses their slots.
+ */
+void CheckSharedNames()
+{
+    std::istringstream aStream("<a><b x='1'/><c></c></a>");
+    cppstax::XMLEventReader aReader(aStream);
+    std::vector<cppstax::XMLEvent> aEvents;
+
+    Configure(aReader);
+
+    Check(aReader.nextEvents(aEvents, 16) == 6 &&
+          aEvents[1].isStartElement() == true &&
+          aEvents[2].isEndElement() == true &&
+          &aEvents[1].asStartElement().getName() == &aEvents[2].asEndElement().getName() &&
+          aEvents[2].asEndElement().getName().getLocalPart() == "b" &&
+          &aEvents[3].asStartElement().getName() != &aEvents[4].asEndElement().getName() &&
+          aEvents[4].asEndElement().getName().getLocalPart() == "c",
+          "empty element tag shares its QName");
+
+    // Keeps all events, so their slots in the ring of pending events
+    // get reused while the earlier ones are still held.
+    std::string strMany("<r>");
+
+    for (int i = 0; i < 300; i++)
+    {
+        strMany += "<e i='" + std::to_string(i) + "'/>t" + std::to_string(i);
+    }
+
+    strMany += "</r>";
+
+    std::istringstream aManyStream(strMany);
+    cppstax::XMLEventReader aManyReader(aManyStream);
+    std::vector<std::unique_ptr<cppstax::XMLEvent>> aHeld;
+    bool bIntact = true;
+
+    Configure(aManyReader);
+
+    while (aManyReader.hasNext() == true)
+    {
+        aHeld.push_back(aManyReader.nextEvent());
+    }
+
+    for (int i = 0; i < 300 && aHeld.size() == 902; i++)
+    {
+        cppstax::XMLEvent& aStart = *aHeld[1 + i * 3];
+        cppstax::XMLEvent& aText = *aHeld[3 + i * 3];
+
+        bIntact = bIntact &&
+                  aStart.isStartElement() == true &&
+                  aStart.asStartElement().getAttributes()->front()->getValue() == std::to_string(i) &&
+                  &aStart.asStartElement().getName() == &aHeld[2 + i * 3]->asEndElement().getName() &&
+                  aText.isCharacters() == true &&
+                  aText.asCharacters().getData() == "t" + std::to_string(i);
+    }
+
+    Check(aHeld.size() == 902 && bIntact == true, "events held while their slots get reused");
+}
+
+/**
+ * @brief XMLValidator requires exactly one root element with only
+ *     whitespace around it and unique attribute names, accepts
+ *     whitespace in front of the '>' of an end tag and counts what it
+ *     scanned.
+ */
+void CheckValidator()
+{
+    struct Case
+    {
+        const char* m_pInput;
+        cppstax::XMLStreamError::Code m_eCode;
+    };
+
+    const Case CASES[] = {
+        { "<a></a >", cppstax::XMLStreamError::ERROR_NONE },
+        { " <?p?><a>t</a>\n<!--c-->", cppstax::XMLStreamError::ERROR_NONE },
+        { "", cppstax::XMLStreamError::ERROR_ROOT_ELEMENT_MISSING },
+        { "<!--c-->", cppstax::XMLStreamError::ERROR_ROOT_ELEMENT_MISSING },
+        { "<a/><b/>", cppstax::XMLStreamError::ERROR_ROOT_ELEMENT_MULTIPLE },
+        { "hello<a/>", cppstax::XMLStreamError::ERROR_TEXT_OUTSIDE_ROOT_ELEMENT },
+        { "<a/>tail", cppstax::XMLStreamError::ERROR_TEXT_OUTSIDE_ROOT_ELEMENT },
+        { "<a b='1' b='2'/>", cppstax::XMLStreamError::ERROR_ATTRIBUTE_DUPLICATE },
+        { "<a></a b>", cppstax::XMLStreamError::ERROR_END_TAG_NAME_CHARACTER },
+        { "<![CDATA[x]]><a/>", cppstax::XMLStreamError::ERROR_MARKUP_DECLARATION_UNSUPPORTED },
+        { "<!DOCTYPE a><a/>", cppstax::XMLStreamError::ERROR_MARKUP_DECLARATION_UNSUPPORTED }
+    };
+
+    cppstax::XMLValidator aValidator;
+
+    for (const Case& aCase : CASES)
+    {
+        bool bValid = aValidator.validate(aCase.m_pInput, std::strlen(aCase.m_pInput));
+
+        Check(bValid == (aCase.m_eCode == cppstax::XMLStreamError::ERROR_NONE) &&
+              aValidator.getError().getCode() == aCase.m_eCode,
+              std::string("validator on '") + aCase.m_pInput + "': " + aValidator.getError().getMessage());
+    }
+
+    const std::string strInput("<a x='1' y='2'><b><c z='3'/></b><b/></a>");
+    std::istringstream aStream(strInput);
+
+    Check(aValidator.validate(aStream) == true &&
+          aValidator.getStats().m_nElements == 4 &&
+          aValidator.getStats().m_nAttributes == 3 &&
+          aValidator.getStats().m_nMaxDepth == 3 &&
+          aValidator.getStats().m_nBytes == strInput.length(),
+          "validator stats");
+
+    aValidator.setMultipleDocuments(true);
+
+    Check(aValidator.validate("<a/>\n<b/>", 9) == true, "validator accepts multiple documents");
+}
+
+/**
+ * @brief The ignore options drop whitespace-only text, comments and
+ *     processing instructions, while whitespace from character
+ *     references is kept as text.
+ */
+void CheckIgnoreOptions()
+{
+    const std::string strInput("<a>\n <!--c--><?p d?> <b>x</b>&#32;\n</a>");
+    const std::string strExpected("S :a\n"
+                                  "S :b\n"
+                                  "T [x]\n"
+                                  "E :b\n"
+                                  "T [ \n]\n"
+                                  "E :a\n");
+
+    for (bool bStructural : { false, true })
+    {
+        std::istringstream aStream(strInput);
+        std::unique_ptr<cppstax::XMLEventReader> pReader(nullptr);
+
+        if (bStructural == true)
+        {
+            pReader.reset(new cppstax::XMLStructuralEventReader(aStream));
+        }
+        else
+        {
+            pReader.reset(new cppstax::XMLEventReader(aStream));
+        }
+
+        Configure(*pReader);
+        pReader->setIgnoreWhitespace(true);
+        pReader->setIgnoreComments(true);
+        pReader->setIgnoreProcessingInstructions(true);
+
+        Check(Dump(*pReader, false) == strExpected, std::string(bStructural == true ? "structural " : "") + "reader with the ignore options");
+    }
+
+    std::istringstream aStream(strInput);
+    cppstax::XMLEventReader aReader(aStream);
+
+    Configure(aReader);
+    aReader.setIgnoreComments(true);
+
+    Check(Dump(aReader, false) == "S :a\nT [\n ]\nP [p|d]\nT [ ]\nS :b\nT [x]\nE :b\nT [ \n]\nE :a\n", "reader ignoring comments only");
+}
+
+/**
+ * @brief skipElement() continues right behind the end tag of the element,
+ *     without being misled by '>' and "/>" in attribute values, or by end
+ *     tags in processing instructions, CDATA sections and comments.
+ */
+void CheckSkipElement()
+{
+    const std::string strInput("<r><s a='>' b=\"/>\"><?p ></s>?><![CDATA[</s>]]><!--</s>--><t/>x<s/></s><n/></r>");
+
+    for (bool bStructural : { false, true })
+    {
+        std::istringstream aStream(strInput);
+        std::unique_ptr<cppstax::XMLEventReader> pReader(nullptr);
+
+        if (bStructural == true)
+        {
+            pReader.reset(new cppstax::XMLStructuralEventReader(aStream));
+        }
+        else
+        {
+            pReader.reset(new cppstax::XMLEventReader(aStream));
+        }
+
+        Configure(*pReader);
+
+        bool bSkipped = pReader->hasNext() == true &&
+                        pReader->nextEvent()->isStartElement() == true &&
+                        pReader->hasNext() == true &&
+                        pReader->nextEvent()->isStartElement() == true &&
+                        pReader->skipElement() == true;
+
+        Check(bSkipped == true &&
+              Dump(*pReader, false) == "S :n\nE :n\nE :r\n",
+              std::string(bStructural == true ? "structural " : "") + "reader skips an element");
+    }
+}
+
+/**
+ * @brief XMLPathExtractor reports the values of child and descendant
+ *     steps, attribute predicates, text() and @name, an element's value
+ *     at its end, and skips the subtrees no expression can match in.
+ */
+void CheckPathExtractor()
+{
+    const std::string strInput("<lib><book id='1' lang='en'><title>A <i>b</i></title><note>n1</note></book>"
+                               "<shelf><book id='2' lang='de'><title>C</title></book></shelf>"
+                               "<other><x>skipped</x></other></lib>");
+    std::vector<std::string> aValues;
+    cppstax::XMLPathExtractor aExtractor;
+
+    aExtractor.addExpression("/lib/book/title", [&aValues](const std::string& strValue) { aValues.push_back("title:" + strValue); });
+    aExtractor.addExpression("//book[@lang='de']/@id", [&aValues](const std::string& strValue) { aValues.push_back("id:" + strValue); });
+    aExtractor.addExpression("//book/*/text()", [&aValues](const std::string& strValue) { aValues.push_back("text:" + strValue); });
+    aExtractor.addExpression("/lib/shelf/book[@id]/title", [&aValues](const std::string& strValue) { aValues.push_back("shelf:" + strValue); });
+
+    std::istringstream aStream(strInput);
+    cppstax::XMLEventReader aReader(aStream);
+
+    Configure(aReader);
+    aExtractor.extract(aReader);
+
+    std::string strValues;
+
+    for (const std::string& strValue : aValues)
+    {
+        strValues += strValue + "\n";
+    }
+
+    Check(strValues == "text:A \ntitle:A b\ntext:n1\nid:2\ntext:C\nshelf:C\n", "path extractor matches:\n" + strValues);
+}
+
+/**
+ * @brief XMLIndex records the range of every element up to the maximum
+ *     depth, survives being written and read back, and opens a reader
+ *     for a single element of the document.
+ */
+void CheckIndex()
+{
+    const std::string strDocument("<r>\n <a id='1'><b>x</b></a>\n <a id='2'><b/><b>y</b></a>\n</r>");
+    std::istringstream aStream(strDocument);
+    cppstax::XMLEventReader aReader(aStream);
+    cppstax::XMLIndex aBuilt;
+
+    Configure(aReader);
+    aBuilt.build(aReader, 2);
+
+    std::stringstream aIndexFile;
+    cppstax::XMLIndex aIndex;
+
+    aBuilt.write(aIndexFile);
+    aIndex.read(aIndexFile);
+
+    std::vector<std::size_t> aEntries(aIndex.findEntries("a"));
+
+    Check(aIndex.getEntryCount() == 3 &&
+          aIndex.findEntries("b").empty() == true &&
+          aEntries.size() == 2 &&
+          aIndex.getEntry(aEntries[1]).m_nDepth == 2 &&
+          strDocument.substr(aIndex.getEntry(aEntries[1]).m_nStart,
+                             aIndex.getEntry(aEntries[1]).m_nEnd - aIndex.getEntry(aEntries[1]).m_nStart) == "<a id='2'><b/><b>y</b></a>",
+          "index entries of the elements up to depth 2");
+
+    if (aEntries.size() == 2)
+    {
+        std::istringstream aDocument(strDocument);
+        std::unique_ptr<cppstax::XMLEventReader> pReader(aIndex.openEntry(aDocument, aEntries[1]));
+
+        Configure(*pReader);
+
+        Check(Dump(*pReader, false) == "S :a :id=[2]\nS :b\nE :b\nS :b\nT [y]\nE :b\nE :a\n", "index opens the second element");
+    }
+}
+
+/**
+ * @brief nextEvents() hands out the same events as nextEvent() for any
+ *     batch size, also mixed with nextEvent() and up to an error, and
+ *     reuses the vector.
+ */
+void CheckBatches()
+{
+    const std::string strInputs[] = {
+        "<?xml version=\"1.0\"?><a x='1'>t<b/><!--c--><?p d?>&amp;<c>u</c></a>",
+        "<a><b>t</b><c>&foo;</c></a>"
+    };
+
+    for (const std::string& strInput : strInputs)
+    {
+        for (std::size_t nBatch : { 1, 2, 3, 100 })
+        {
+            std::istringstream aStream(strInput);
+            cppstax::XMLEventReader aReader(aStream);
+            std::vector<cppstax::XMLEvent> aEvents;
+            std::ostringstream aOutput;
+
+            Configure(aReader);
+            aReader.setLocationTracking(true);
+
+            if (aReader.hasNext() == true)
+            {
+                DumpEvent(*aReader.nextEvent(), true, aOutput);
+            }
+
+            while (aReader.nextEvents(aEvents, nBatch) > 0)
+            {
+                for (cppstax::XMLEvent& aEvent : aEvents)
+                {
+                    DumpEvent(aEvent, true, aOutput);
+                }
+            }
+
+            DumpError(aReader, true, aOutput);
+
+            Check(aOutput.str() == DumpSequential(strInput, true), "nextEvents() in batches of " + std::to_string(nBatch) + " on '" + strInput + "'");
+        }
+    }
+}
+
+/**
+ * @brief Errors are thrown by default. Without that, they end the input
+ *     for hasNext() and skipElement() and are kept for getError().
+ */
+void CheckErrorModes()
+{
+    const std::string strInput("<a><b x=1></b></a>");
+
+    {
+        std::istringstream aStream(strInput);
+        cppstax::XMLEventReader aReader(aStream);
+        bool bThrown = false;
+
+        try
+        {
+            while (aReader.hasNext() == true)
+            {
+                aReader.nextEvent();
+            }
+        }
+        catch (cppstax::XMLStreamException* pException)
+        {
+            bThrown = true;
+            delete pException;
+        }
+
+        Check(bThrown == true, "reader throws errors by default");
+    }
+
+    std::istringstream aStream(strInput);
+    cppstax::XMLEventReader aReader(aStream);
+
+    aReader.setThrowOnError(false);
+    aReader.setLocationTracking(true);
+
+    bool bEnded = aReader.hasNext() == true &&
+                  aReader.nextEvent()->isStartElement() == true &&
+                  aReader.hasNext() != true &&
+                  aReader.hasNext() != true;
+
+    Check(bEnded == true &&
+          aReader.getError().getCode() == cppstax::XMLStreamError::ERROR_ATTRIBUTE_VALUE_DELIMITER &&
+          aReader.getError().getLocation().getCharacterOffset() > 3,
+          "reader without throwing ends at the error: " + aReader.getError().getMessage());
+
+    std::istringstream aSkipped("<a><b>");
+    cppstax::XMLEventReader aSkipping(aSkipped);
+
+    aSkipping.setThrowOnError(false);
+
+    Check(aSkipping.hasNext() == true &&
+          aSkipping.nextEvent()->isStartElement() == true &&
+          aSkipping.skipElement() != true &&
+          aSkipping.getError().getCode() == cppstax::XMLStreamError::ERROR_SKIPPED_ELEMENT_INCOMPLETE &&
+          aSkipping.hasNext() != true,
+          "skipElement() without throwing returns false at the end of the input");
+}
+
+/**
+ * @brief A reader reset onto the next document, whether the previous one
+ *     was read completely, only partly or up to an error, reads it the
+ *     same as a new reader, keeping the entities and settings.
+ *     restoreDefaults() drops them again.
+ */
+void CheckReset()
+{
+    const std::string strInputs[] = {
+        "<?xml version=\"1.0\"?><a x='1'>&copy;<b/><!--c--></a>",
+        "<a><b>t</b><c>u</c></a>",
+        "<a><b x=1></b></a>",
+        "<a>\n <b>&nbsp;</b>\n</a>"
+    };
+
+    std::istringstream aFirst("");
+    cppstax::XMLEventReader aReader(aFirst);
+    std::istringstream aStructuralFirst("");
+    cppstax::XMLStructuralEventReader aStructural(aStructuralFirst);
+
+    Configure(aReader);
+    aReader.setLocationTracking(true);
+    Configure(aStructural);
+    aStructural.setLocationTracking(true);
+
+    for (std::size_t nRead : { 0, 2, 100 })
+    {
+        for (const std::string& strInput : strInputs)
+        {
+            std::istringstream aStream(strInput);
+
+            aReader.reset(aStream);
+            Check(Dump(aReader, true) == DumpSequential(strInput, true), "reset() after " + std::to_string(nRead) + " events onto '" + strInput + "'");
+
+            std::istringstream aStructuralStream(strInput);
+
+            aStructural.reset(aStructuralStream);
+            Check(Dump(aStructural, true) == DumpSequential(strInput, true), "structural reset() after " + std::to_string(nRead) + " events onto '" + strInput + "'");
+
+            // Leaves the next document partly read for the next reset().
+            std::istringstream aPartial(strInput);
+
+            aReader.reset(aPartial);
+
+            for (std::size_t nEvent = 0; nEvent < nRead && aReader.hasNext() == true; nEvent++)
+            {
+                aReader.nextEvent();
+            }
+
+            std::istringstream aStructuralPartial(strInput);
+
+            aStructural.reset(aStructuralPartial);
+
+            for (std::size_t nEvent = 0; nEvent < nRead && aStructural.hasNext() == true; nEvent++)
+            {
+                aStructural.nextEvent();
+            }
+        }
+    }
+
+    bool bThrown = false;
+
+    try
+    {
+        aReader.restoreDefaults();
+    }
+    catch (std::logic_error* pException)
+    {
+        bThrown = true;
+        delete pException;
+    }
+
+    Check(bThrown == true, "restoreDefaults() after reading has started");
+
+    std::istringstream aStream("<a>&copy;</a>");
+
+    aReader.reset(aStream);
+    aReader.restoreDefaults();
+    aReader.setThrowOnError(false);
+
+    Dump(aReader, false);
+
+    Check(aReader.getError().getCode() == cppstax::XMLStreamError::ERROR_ENTITY_UNKNOWN,
+          "restoreDefaults() drops the added entities");
+}
+
+/**
+ * @brief The recording of XMLEventRecorder for the events of strInput.
+ */
+std::string Record(const std::string& strInput, bool bMultipleDocuments = false)
+{
+    std::ostringstream aOutput;
+    std::istringstream aStream(strInput);
+    cppstax::XMLEventReader aReader(aStream);
+
+    {
+        cppstax::XMLEventRecorder aRecorder(aOutput);
+
+        Configure(aReader, bMultipleDocuments);
+
+        while (aReader.hasNext() == true)
+        {
+            aRecorder.add(*aReader.nextEvent());
+        }
+
+        aRecorder.flush();
+    }
+
+    return aOutput.str();
+}
+
+/**
+ * @brief XMLReplayEventReader reads back the events recorded by
+ *     XMLEventRecorder, skips their elements the same way and rejects a
+ *     truncated recording.
+ */
+void CheckReplay()
+{
+    const std::string strInputs[] = {
+        "<?xml version=\"1.0\"?><a x='1' p:y=\"2\">t<p:b/><!--c--><?p d?><?q?>&amp;<p:b x='3'>u</p:b></a>",
+        "<a/>",
+        "<a><b><c>t</c></b><b/></a>"
+    };
+
+    std::istringstream aFirst("");
+    cppstax::XMLReplayEventReader aReplay(aFirst);
+
+    aReplay.setThrowOnError(false);
+
+    for (const std::string& strInput : strInputs)
+    {
+        const std::string strRecording(Record(strInput));
+
+        std::istringstream aStream(strRecording);
+
+        aReplay.reset(aStream);
+        Check(Dump(aReplay, false) == DumpSequential(strInput, false), "replay of '" + strInput + "'");
+    }
+
+    const std::string strInput("<a><b><c>t</c><!--c--></b><d/></a>");
+    const std::string strRecording(Record(strInput));
+
+    {
+        std::istringstream aStream(strRecording);
+
+        aReplay.reset(aStream);
+
+        bool bSkipped = aReplay.hasNext() == true &&
+                        aReplay.nextEvent()->isStartElement() == true &&
+                        aReplay.hasNext() == true &&
+                        aReplay.nextEvent()->isStartElement() == true &&
+                        aReplay.skipElement() == true;
+
+        Check(bSkipped == true && Dump(aReplay, false) == "S :d\nE :d\nE :a\n", "skipElement() on the replay of '" + strInput + "'");
+    }
+
+    for (std::size_t nLength : { std::size_t(0), std::size_t(5), strRecording.length() / 2, strRecording.length() - 1 })
+    {
+        std::istringstream aStream(strRecording.substr(0, nLength));
+
+        aReplay.reset(aStream);
+        Dump(aReplay, false);
+
+        Check(aReplay.getError().getCode() != cppstax::XMLStreamError::ERROR_NONE, "replay of a recording truncated to " + std::to_string(nLength) + " bytes fails");
+    }
+}
+
+/**
+ * @brief nNode and the nodes following it as siblings, each element with
+ *     its attributes and children in parentheses. Fails the check if a
+ *     child doesn't link back to nParent.
+ */
+std::string DumpTree(const cppstax::XMLTree& aTree, unsigned int nNode, unsigned int nParent)
+{
+    std::string strOutput;
+
+    for (; nNode != cppstax::XMLTree::NONE; nNode = aTree.getNode(nNode).m_nNextSibling)
+    {
+        const cppstax::XMLTree::Node& aNode = aTree.getNode(nNode);
+
+        Check(aNode.m_nParent == nParent, "parent of tree node " + std::to_string(nNode));
+
+        switch (aNode.m_eType)
+        {
+        case cppstax::XMLTree::NODE_ELEMENT:
+            strOutput += aTree.getName(aNode.m_nNameID).getLocalPart();
+
+            for (unsigned int nAttribute = aNode.m_nData; nAttribute < aNode.m_nData + aNode.m_nLength; nAttribute++)
+            {
+                const cppstax::XMLTree::NodeAttribute& aAttribute = aTree.getAttribute(nAttribute);
+
+                strOutput += " " + aTree.getName(aAttribute.m_nNameID).getLocalPart() + "=" + std::string(aTree.getData(aAttribute.m_nValue), aAttribute.m_nValueLength);
+            }
+
+            strOutput += "(" + DumpTree(aTree, aNode.m_nFirstChild, nNode) + ")";
+            break;
+        case cppstax::XMLTree::NODE_TEXT:
+            strOutput += "[" + std::string(aTree.getData(aNode.m_nData), aNode.m_nLength) + "]";
+            break;
+        case cppstax::XMLTree::NODE_COMMENT:
+            strOutput += "!" + std::string(aTree.getData(aNode.m_nData), aNode.m_nLength);
+            break;
+        case cppstax::XMLTree::NODE_PROCESSING_INSTRUCTION:
+            strOutput += "?" + aTree.getName(aNode.m_nNameID).getLocalPart() + " " + std::string(aTree.getData(aNode.m_nData), aNode.m_nLength);
+            break;
+        }
+    }
+
+    return strOutput;
+}
+
+/**
+ * @brief XMLTree links the nodes of the elements appended, next to each
+ *     other as roots, and of the rest of the input after clear().
+ */
+void CheckTree()
+{
+    std::istringstream aStream("<r><a x='1' y=\"2\">t<b>u&amp;</b><!--c--><?p d?></a><s><z/></s><a/></r>");
+    cppstax::XMLEventReader aReader(aStream);
+    cppstax::XMLTree aTree;
+    unsigned int nFirst = cppstax::XMLTree::NONE;
+
+    Configure(aReader);
+
+    while (aReader.hasNext() == true)
+    {
+        std::unique_ptr<cppstax::XMLEvent> pEvent(aReader.nextEvent());
+
+        if (pEvent->isStartElement() == true &&
+            pEvent->asStartElement().getName().getLocalPart() == "a")
+        {
+            unsigned int nNode = aTree.appendElement(aReader, pEvent->asStartElement());
+
+            if (nFirst == cppstax::XMLTree::NONE)
+            {
+                nFirst = nNode;
+            }
+        }
+        else if (pEvent->isStartElement() == true &&
+                 pEvent->asStartElement().getName().getLocalPart() == "s")
+        {
+            aReader.skipElement();
+        }
+    }
+
+    std::string strText;
+
+    aTree.getTextContent(nFirst, strText);
+
+    Check(nFirst == aTree.getFirstRoot() &&
+          DumpTree(aTree, aTree.getFirstRoot(), cppstax::XMLTree::NONE) == "a x=1 y=2([t]b([u&])!c?p d)a()",
+          "tree of the appended elements");
+    Check(aTree.findAttribute(nFirst, "y") != cppstax::XMLTree::NONE &&
+          aTree.findAttribute(nFirst, "z") == cppstax::XMLTree::NONE &&
+          strText == "tu&",
+          "attributes and text content of a tree node");
+
+    std::istringstream aRest("<x>1<y>2</y></x><w/>");
+    cppstax::XMLEventReader aRestReader(aRest);
+
+    Configure(aRestReader);
+    aRestReader.setMultipleDocuments(true);
+    aTree.clear();
+
+    Check(aTree.appendAll(aRestReader) == aTree.getFirstRoot() &&
+          DumpTree(aTree, aTree.getFirstRoot(), cppstax::XMLTree::NONE) == "x([1]y([2]))w()",
+          "tree of the whole input after clear()");
+}
+
+/**
+ * @brief Handler of XMLPushParser writing the callbacks in the format of
+ *     DumpEvent(), text of consecutive callbacks on one line.
+ */
+class DumpHandler : public cppstax::XMLContentHandler
+{
+public:
+    void onStartElement(const cppstax::XMLSpan& aPrefix, const cppstax::XMLSpan& aLocalPart)
+    {
+        EndLine();
+        m_strOutput += "S " + std::string(aPrefix.m_pData, aPrefix.m_nLength) + ":" + std::string(aLocalPart.m_pData, aLocalPart.m_nLength);
+        m_bLineOpen = true;
+    }
+
+    void onAttribute(const cppstax::XMLSpan& aPrefix, const cppstax::XMLSpan& aLocalPart, const cppstax::XMLSpan& aValue)
+    {
+        m_strOutput += " " + std::string(aPrefix.m_pData, aPrefix.m_nLength) + ":" + std::string(aLocalPart.m_pData, aLocalPart.m_nLength) + "=[" + std::string(aValue.m_pData, aValue.m_nLength) + "]";
+    }
+
+    void onEndElement(const cppstax::XMLSpan& aPrefix, const cppstax::XMLSpan& aLocalPart)
+    {
+        EndLine();
+        m_strOutput += "E " + std::string(aPrefix.m_pData, aPrefix.m_nLength) + ":" + std::string(aLocalPart.m_pData, aLocalPart.m_nLength) + "\n";
+    }
+
+    void onText(const cppstax::XMLSpan& aText)
+    {
+        if (m_bTextOpen != true)
+        {
+            EndLine();
+            m_strOutput += "T [";
+            m_bLineOpen = true;
+            m_bTextOpen = true;
+        }
+
+        m_strOutput.append(aText.m_pData, aText.m_nLength);
+    }
+
+    void onComment(const cppstax::XMLSpan& aText)
+    {
+        EndLine();
+        m_strOutput += "C [" + std::string(aText.m_pData, aText.m_nLength) + "]\n";
+    }
+
+    void onProcessingInstruction(const cppstax::XMLSpan& aTarget, const cppstax::XMLSpan& aData)
+    {
+        EndLine();
+        m_strOutput += "P [" + std::string(aTarget.m_pData, aTarget.m_nLength) + "|" + std::string(aData.m_pData, aData.m_nLength) + "]\n";
+    }
+
+    std::string getOutput()
+    {
+        EndLine();
+        return m_strOutput;
+    }
+
+protected:
+    void EndLine()
+    {
+        if (m_bLineOpen == true)
+        {
+            m_strOutput += m_bTextOpen == true ? "]\n" : "\n";
+            m_bLineOpen = false;
+            m_bTextOpen = false;
+        }
+    }
+
+protected:
+    std::string m_strOutput;
+    bool m_bLineOpen = false;
+    bool m_bTextOpen = false;
+
+};
+
+/**
+ * @brief DumpSequential() without the document events and the error,
+ *     which the push parser doesn't report as callbacks.
+ */
+std::string DumpElements(const std::string& strInput)
+{
+    std::istringstream aDump(DumpSequential(strInput, false));
+    std::string strLine;
+    std::string strOutput;
+
+    while (std::getline(aDump, strLine))
+    {
+        if (strLine != "SD" &&
+            strLine != "ED" &&
+            strLine.compare(0, 7, "error: ") != 0)
+        {
+            strOutput += strLine + "\n";
+        }
+    }
+
+    return strOutput;
+}
+
+/**
+ * @brief XMLPushParser calls the handler for the same constructs
+ *     XMLEventReader returns events for, from memory and from a stream,
+ *     only for those the policy reports, and stops at an error.
+ */
+void CheckPushParser()
+{
+    const std::string strInput("<?xml version=\"1.0\"?><a x='1' p:y=\"&lt;\">t&amp;u<p:b/><!--c--><?p d?>&copy;<c>v</c></a>");
+    cppstax::XMLPushParser<> aParser;
+
+    aParser.addToEntityReplacementDictionary("copy", "\xC2\xA9");
+
+    {
+        DumpHandler aHandler;
+
+        Check(aParser.parse(strInput.data(), strInput.length(), aHandler) == true &&
+              aHandler.getOutput() == DumpElements(strInput),
+              "push parser from memory on '" + strInput + "'");
+    }
+
+    {
+        std::istringstream aStream(strInput);
+        DumpHandler aHandler;
+
+        Check(aParser.parse(aStream, aHandler) == true &&
+              aHandler.getOutput() == DumpElements(strInput),
+              "push parser from a stream on '" + strInput + "'");
+    }
+
+    {
+        const std::string strSkipped("<a><!--c-->t<?p d?></a>");
+        cppstax::XMLPushParser<cppstax::XMLMinimalPolicy> aMinimal;
+        DumpHandler aHandler;
+
+        Check(aMinimal.parse(strSkipped.data(), strSkipped.length(), aHandler) == true &&
+              aHandler.getOutput() == "S :a\nT [t]\nE :a\n",
+              "push parser of the minimal policy skips comments and PIs");
+    }
+
+    const std::string strMalformed("<a><b x=1></b></a>");
+    DumpHandler aHandler;
+
+    Check(aParser.parse(strMalformed.data(), strMalformed.length(), aHandler) != true &&
+          aParser.getError().getCode() == cppstax::XMLStreamError::ERROR_ATTRIBUTE_VALUE_DELIMITER &&
+          aHandler.getOutput().compare(0, 5, "S :a\n") == 0,
+          "push parser stops at the error in '" + strMalformed + "'");
+}
+
+/**
+ * @brief XMLValueParser accepts integers up to the limits of their type
+ *     and rejects them beyond, converts doubles the same as std::strtod()
+ *     and accepts base64 only with correct padding.
+ */
+void CheckValueParser()
+{
+    const struct
+    {
+        const char* m_pText;
+        bool m_bValid;
+        long long m_nValue;
+    } INT64S[] = {
+        { " 42\n", true, 42 },
+        { "+0", true, 0 },
+        { "-9223372036854775808", true, std::numeric_limits<long long>::min() },
+        { "9223372036854775807", true, std::numeric_limits<long long>::max() },
+        { "00009223372036854775807", true, std::numeric_limits<long long>::max() },
+        { "-9223372036854775809", false, 0 },
+        { "9223372036854775808", false, 0 },
+        { "99999999999999999999", false, 0 },
+        { "", false, 0 },
+        { "-", false, 0 },
+        { "1 2", false, 0 },
+        { "0x10", false, 0 }
+    };
+
+    for (const auto& aCase : INT64S)
+    {
+        long long nValue = 0;
+        bool bValid = cppstax::XMLValueParser::parseInt64(aCase.m_pText, std::strlen(aCase.m_pText), nValue);
+
+        Check(bValid == aCase.m_bValid && (bValid != true || nValue == aCase.m_nValue), std::string("parseInt64() of '") + aCase.m_pText + "'");
+    }
+
+    const struct
+    {
+        const char* m_pText;
+        bool m_bValid;
+        unsigned long long m_nValue;
+    } UINT64S[] = {
+        { "18446744073709551615", true, std::numeric_limits<unsigned long long>::max() },
+        { "+1", true, 1 },
+        { "18446744073709551616", false, 0 },
+        { "-1", false, 0 }
+    };
+
+    for (const auto& aCase : UINT64S)
+    {
+        unsigned long long nValue = 0;
+        bool bValid = cppstax::XMLValueParser::parseUInt64(aCase.m_pText, std::strlen(aCase.m_pText), nValue);
+
+        Check(bValid == aCase.m_bValid && (bValid != true || nValue == aCase.m_nValue), std::string("parseUInt64() of '") + aCase.m_pText + "'");
+    }
+
+    const std::string strLong("0." + std::string(400, '0') + "1" + std::string(800, '7') + "e400");
+    const std::string DOUBLES[] = {
+        "0.1", "-2.5", "1e22", "1e23", "123456789012345678901234567890",
+        "3.14159265358979323846264338327950288",
+        "1.7976931348623157e308", "4.9e-324", "2.2250738585072011e-308",
+        "9007199254740993", "1e-400", ".5", "5.", strLong
+    };
+
+    for (const std::string& strText : DOUBLES)
+    {
+        double fValue = 0.0;
+
+        Check(cppstax::XMLValueParser::parseDouble(strText.data(), strText.length(), fValue) == true &&
+              fValue == std::strtod(strText.c_str(), nullptr),
+              "parseDouble() of '" + strText.substr(0, 40) + "'");
+    }
+
+    for (const char* pText : { "1e400", "-1e309", "", ".", "e5", "1e", "1e+", "1.2.3", "inf" })
+    {
+        double fValue = 0.0;
+
+        Check(cppstax::XMLValueParser::parseDouble(pText, std::strlen(pText), fValue) != true, std::string("parseDouble() rejects '") + pText + "'");
+    }
+
+    const struct
+    {
+        const char* m_pText;
+        bool m_bValid;
+        const char* m_pDecoded;
+    } BASE64S[] = {
+        { "", true, "" },
+        { "Zg==", true, "f" },
+        { "Zm8=", true, "fo" },
+        { "Zm9v", true, "foo" },
+        { " Zm9v\nYmFy ", true, "foobar" },
+        { "Zm 8 =", true, "fo" },
+        { "Zg=", false, "" },
+        { "Zg", false, "" },
+        { "Z===", false, "" },
+        { "Zm9v=", false, "" },
+        { "Zg==Zg==", false, "" },
+        { "Zm9*", false, "" }
+    };
+
+    for (const auto& aCase : BASE64S)
+    {
+        unsigned char aBuffer[16];
+        std::size_t nDecoded = 0;
+        bool bValid = cppstax::XMLValueParser::parseBase64(aCase.m_pText, std::strlen(aCase.m_pText), aBuffer, sizeof(aBuffer), nDecoded);
+
+        Check(bValid == aCase.m_bValid &&
+              (bValid != true || std::string(reinterpret_cast<char*>(aBuffer), nDecoded) == aCase.m_pDecoded),
+              std::string("parseBase64() of '") + aCase.m_pText + "'");
+    }
+
+    unsigned char aSmall[2];
+    std::size_t nNeeded = 0;
+
+    Check(cppstax::XMLValueParser::parseBase64("Zm9vYg==", 8, aSmall, sizeof(aSmall), nNeeded) != true &&
+          nNeeded == 4 &&
+          std::memcmp(aSmall, "fo", 2) == 0,
+          "parseBase64() into a buffer too small tells the size needed");
+
+    std::istringstream aStream("<a n=' -7 ' f='2.5e-1' b='true'>Zm9v</a>");
+    cppstax::XMLEventReader aReader(aStream);
+    long long nNumber = 0;
+    double fNumber = 0.0;
+    bool bFlag = false;
+    unsigned char aBuffer[4];
+    std::size_t nDecoded = 0;
+
+    Configure(aReader);
+
+    std::unique_ptr<cppstax::XMLEvent> pStart(aReader.nextEvent());
+    std::unique_ptr<cppstax::XMLEvent> pText(aReader.nextEvent());
+    const std::shared_ptr<std::list<std::shared_ptr<cppstax::Attribute>>> pAttributes(pStart->asStartElement().getAttributes());
+    std::list<std::shared_ptr<cppstax::Attribute>>::const_iterator iter = pAttributes->begin();
+
+    Check((*iter++)->getAsInt64(nNumber) == true && nNumber == -7 &&
+          (*iter++)->getAsDouble(fNumber) == true && fNumber == 0.25 &&
+          (*iter)->getAsBool(bFlag) == true && bFlag == true &&
+          pText->asCharacters().getAsBase64(aBuffer, sizeof(aBuffer), nDecoded) == true &&
+          std::string(reinterpret_cast<char*>(aBuffer), nDecoded) == "foo",
+          "typed accessors of Attribute and Characters");
+}
+
+/**
+ * @brief With CPPSTAX_ALLOCATION_STATS, reading attributes the allocations
+ *     of the reader to their categories, and destroying the events gives
+ *     their live bytes back. Without, all counters stay 0.
+ */
+void CheckAllocationStats()
+{
+    cppstax::AllocationStats::reset();
+
+    const unsigned long long nEventBytes = cppstax::AllocationStats::getCounters(cppstax::AllocationStats::CATEGORY_EVENTS).m_nLiveBytes;
+
+    {
+        std::istringstream aStream("<a x='1'>text<b/><?p d?></a>");
+        cppstax::XMLEventReader aReader(aStream);
+
+        Configure(aReader);
+
+        while (aReader.hasNext() == true)
+        {
+            aReader.nextEvent();
+        }
+    }
+
+    std::set<std::string> aNames;
+
+    for (std::size_t i = 0; i < cppstax::AllocationStats::CATEGORY_COUNT; i++)
+    {
+        const cppstax::AllocationStats::Category eCategory = static_cast<cppstax::AllocationStats::Category>(i);
+        const cppstax::AllocationStats::Counters aCounters = cppstax::AllocationStats::getCounters(eCategory);
+        const std::string strName(cppstax::AllocationStats::getCategoryName(eCategory));
+
+        aNames.insert(strName);
+
+        if (cppstax::AllocationStats::isEnabled() == true)
+        {
+            Check(aCounters.m_nLiveBytes <= aCounters.m_nPeakLiveBytes &&
+                  (eCategory == cppstax::AllocationStats::CATEGORY_OTHER || aCounters.m_nAllocations > 0),
+                  "allocation counters of " + strName);
+        }
+        else
+        {
+            Check(aCounters.m_nAllocations == 0 &&
+                  aCounters.m_nBytes == 0 &&
+                  aCounters.m_nPeakLiveBytes == 0,
+                  "no allocation counters of " + strName + " without CPPSTAX_ALLOCATION_STATS");
+        }
+    }
+
+    Check(aNames.size() == cppstax::AllocationStats::CATEGORY_COUNT &&
+          aNames.count("") == 0,
+          "allocation category names");
+
+    if (cppstax::AllocationStats::isEnabled() == true)
+    {
+        Check(cppstax::AllocationStats::getCounters(cppstax::AllocationStats::CATEGORY_EVENTS).m_nLiveBytes == nEventBytes,
+              "allocation counters give back the live bytes of the events");
+    }
+}
+
+/**
+ * @brief Every engine against XMLEventReader on one input file, the
+ *     validator on the file and on a copy with a mismatched end tag.
+ */
+void CheckFile(const std::string& strPath)
+{
+    std::ifstream aFile(strPath, std::ios::binary);
+
+    if (aFile.is_open() != true)
+    {
+        Check(false, "opening '" + strPath + "'");
+        return;
+    }
+
+    std::stringstream aContent;
+    aContent << aFile.rdbuf();
+
+    const std::string strInput(aContent.str());
+    // Input which isn't a single document, like the tiny-documents shape
+    // with an XML declaration for each, gets read in the multiple
+    // documents mode.
+    const bool bMultipleDocuments = strInput.find("<?xml ", 1) != std::string::npos;
+    const std::string strExpected(DumpSequential(strInput, false, bMultipleDocuments));
+
+    Check(strExpected.find("error: ") == std::string::npos, strPath + " is well-formed");
+
+    {
+        std::istringstream aStream(strInput);
+        cppstax::XMLStructuralEventReader aReader(aStream);
+
+        Configure(aReader, bMultipleDocuments);
+        Check(Dump(aReader, false) == strExpected, strPath + ": structural reader");
+    }
+
+    Check(DumpParallel(strInput, 4096, false, bMultipleDocuments) == strExpected, strPath + ": parallel reader");
+
+    {
+        std::istringstream aStream(strInput);
+        cppstax::XMLPipelinedEventReader aReader(aStream);
+
+        Configure(aReader, bMultipleDocuments);
+        Check(Dump(aReader, false) == strExpected, strPath + ": pipelined reader");
+    }
+
+    {
+        std::istringstream aStream(Record(strInput, bMultipleDocuments));
+        cppstax::XMLReplayEventReader aReader(aStream);
+
+        Configure(aReader, bMultipleDocuments);
+        Check(Dump(aReader, false) == strExpected, strPath + ": replay of the recording");
+    }
+
+    {
+        std::istringstream aStream(strInput);
+        cppstax::XMLPolicyEventReader<cppstax::XMLDefaultPolicy> aReader(aStream);
+
+        Configure(aReader, bMultipleDocuments);
+        Check(Dump(aReader, false) == strExpected, strPath + ": policy reader, default policy");
+    }
+
+    {
+        std::istringstream aStream(strInput);
+        cppstax::XMLPolicyEventReader<cppstax::XMLFullPolicy> aReader(aStream);
+
+        Configure(aReader, bMultipleDocuments);
+        aReader.setLocationTracking(true);
+        Check(Dump(aReader, true) == DumpSequential(strInput, true, bMultipleDocuments), strPath + ": policy reader, full policy");
+    }
+
+    if (bMultipleDocuments != true)
+    {
+        std::istringstream aStream(strInput);
+        cppstax::XMLPushParser<> aParser;
+        DumpHandler aHandler;
+
+        aParser.addToEntityReplacementDictionary("copy", "\xC2\xA9");
+        aParser.addToEntityReplacementDictionary("nbsp", "\xC2\xA0");
+
+        Check(aParser.parse(aStream, aHandler) == true &&
+              aHandler.getOutput() == DumpElements(strInput),
+              strPath + ": push parser");
+    }
+
+    cppstax::XMLValidator aValidator;
+
+    aValidator.addEntityName("copy");
+    aValidator.addEntityName("nbsp");
+    aValidator.setMultipleDocuments(bMultipleDocuments);
+
+    Check(aValidator.validate(strInput.data(), strInput.length()) == true, strPath + ": validator accepts");
+
+    std::size_t nEndTag = strInput.find("</", strInput.length() / 2);
+
+    if (nEndTag != std::string::npos)
+    {
+        std::string strMismatch(strInput);
+        strMismatch.insert(nEndTag + 2, "mismatch");
+
+        Check(aValidator.validate(strMismatch.data(), strMismatch.length()) != true &&
+              aValidator.getError().getCode() == cppstax::XMLStreamError::ERROR_END_TAG_MISMATCH &&
+              aValidator.getError().getLocation().getCharacterOffset() == static_cast<std::streamoff>(nEndTag),
+              strPath + ": validator rejects a mismatched end tag");
+    }
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    CheckLocations();
+    CheckSourceRanges();
+    CheckParallel();
+    CheckStructural();
+    CheckWriter();
+    CheckPassthrough();
+    CheckDecoder();
+    CheckSharedNames();
+    CheckValidator();
+    CheckIgnoreOptions();
+    CheckSkipElement();
+    CheckPathExtractor();
+    CheckIndex();
+    CheckBatches();
+    CheckErrorModes();
+    CheckReset();
+    CheckReplay();
+    CheckTree();
+    CheckPushParser();
+    CheckValueParser();
+    CheckAllocationStats();
+
+    for (int i = 1; i < argc; i++)
+    {
+        CheckFile(argv[i]);
+    }
+
+    std::cout << g_nFailures << " failures." << std::endl;
+
+    return g_nFailures;
+}